@@ -12,6 +12,7 @@ config:Add(OptTestCompileC("macosxppc", "int main(){return 0;}", "-arch ppc"))
 config:Add(OptLibrary("zlib", "zlib.h", false))
 config:Add(Mysql.OptFind("mysql", false))
 config:Add(OptToggle("geolocation", true))
+config:Add(OptToggle("fastalloc", false))
 config:Finalize("config.lua")
 
 -- data compiler
@@ -305,10 +306,23 @@ function build(settings)
 		server_osxlaunch = Compile(launcher_settings, "src/osxlaunch/server.m")
 	end
 
+	-- the sql tools test the database code of the server
+	server_sql = {}
+	for i,v in ipairs(server) do
+		name = PathFilename(v)
+		if string.find(name, "^sql_server") or string.find(name, "^sql_string_helpers") or string.find(name, "^sql_roundscores") then
+			table.insert(server_sql, v)
+		end
+	end
+
 	tools = {}
 	for i,v in ipairs(tools_src) do
 		toolname = PathFilename(PathBase(v))
-		tools[i] = Link(settings, toolname, Compile(settings, v), engine, zlib, pnglite, md5)
+		if string.find(toolname, "^sql_") then
+			tools[i] = Link(server_settings, toolname, Compile(settings, v), engine, server_sql, zlib, md5)
+		else
+			tools[i] = Link(settings, toolname, Compile(settings, v), engine, game_shared, zlib, pnglite, md5)
+		end
 	end
 
 	-- build server, version server and master server
@@ -380,6 +394,12 @@ if config.geolocation.value then
 	release_sql_settings.cc.defines:Add("CONF_GEOLOCATION")
 end
 
+-- release builds can skip the memory tracker, debug builds always keep it
+if config.fastalloc.value then
+	release_settings.cc.defines:Add("CONF_FAST_ALLOC")
+	release_sql_settings.cc.defines:Add("CONF_FAST_ALLOC")
+end
+
 if platform == "macosx" then
 	debug_settings_ppc = debug_settings:Copy()
 	debug_settings_ppc.config_name = "debug_ppc"
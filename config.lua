@@ -0,0 +1,11 @@
+compiler.driver = 'gcc'
+compiler.c_compiler = false
+compiler.cxx_compiler = false
+stackprotector.value = true
+minmacosxsdk.value = false
+macosxppc.value = false
+zlib.value = true
+zlib.include_path = false
+mysql.value = true
+mysql.use_mysqlconfig = false
+geolocation.value = false
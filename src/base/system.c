@@ -72,10 +72,16 @@ void dbg_logger(DBG_LOGGER logger)
 	loggers[num_loggers++] = logger;
 }
 
+static int log_push(const char *line);
+static int log_on_writer_thread();
+
 void dbg_assert_imp(const char *filename, int line, int test, const char *msg)
 {
 	if(!test)
 	{
+		/* get the queued lines out before we crash, a no-op on the
+		   writer thread, its lines are written directly */
+		dbg_logger_async_stop();
 		dbg_msg("assert", "%s(%d): %s", filename, line, msg);
 		dbg_break();
 	}
@@ -105,14 +111,21 @@ void dbg_msg(const char *sys, const char *fmt, ...)
 #endif
 	va_end(args);
 
+	if(log_push(str))
+		return;
+
 	for(i = 0; i < num_loggers; i++)
 		loggers[i](str);
 }
 
+/* set while the writer thread owns the loggers, they leave flushing to it */
+static volatile int log_batching = 0;
+
 static void logger_stdout(const char *line)
 {
 	printf("%s\n", line);
-	fflush(stdout);
+	if(!log_batching)
+		fflush(stdout);
 }
 
 static void logger_debugger(const char *line)
@@ -129,7 +142,8 @@ static void logger_file(const char *line)
 {
 	io_write(logfile, line, strlen(line));
 	io_write_newline(logfile);
-	io_flush(logfile);
+	if(!log_batching)
+		io_flush(logfile);
 }
 
 void dbg_logger_stdout() { dbg_logger(logger_stdout); }
@@ -143,13 +157,348 @@ void dbg_logger_file(const char *filename)
 		dbg_msg("dbg/logger", "failed to open '%s' for logging", filename);
 
 }
+
+/* asynchronous logging: dbg_msg copies the line into a bounded multi producer
+   ring and a writer thread hands the lines to the loggers and flushes them */
+#if defined(CONF_FAMILY_WINDOWS)
+	#define log_compswap(value, comperand, exchange) InterlockedCompareExchange((volatile LONG *)&(value), (exchange), (comperand))
+	#define log_add(value, amount) InterlockedExchangeAdd((volatile LONG *)&(value), (amount))
+	#define log_barrier() MemoryBarrier()
+#else
+	#define log_compswap(value, comperand, exchange) __sync_val_compare_and_swap(&(value), (comperand), (exchange))
+	#define log_add(value, amount) __sync_fetch_and_add(&(value), (amount))
+	#define log_barrier() __sync_synchronize()
+#endif
+
+enum
+{
+	LOG_QUEUE_SIZE = 4096,
+	LOG_SLOT_SIZE = 240,
+	LOG_IDLE_SLEEP = 5
+};
+
+typedef struct
+{
+	volatile unsigned seq;
+	int size;
+	int more; /* the line continues in the next slot */
+	char data[LOG_SLOT_SIZE];
+} LOG_SLOT;
+
+static LOG_SLOT *log_queue = 0;
+static volatile unsigned log_enqueue_pos = 0;
+static unsigned log_dequeue_pos = 0;
+static volatile int log_async_running = 0;
+static volatile int log_async_stopping = 0;
+static volatile int log_producers = 0;
+static void *log_thread = 0;
+static int log_flush_interval = 0;
+static int log_block = 0;
+static LOGSTATS log_stats = {0};
+static volatile int log_writer_started = 0;
+#if defined(CONF_FAMILY_WINDOWS)
+static DWORD log_writer_id;
+#else
+static pthread_t log_writer_id;
+#endif
+
+static int log_on_writer_thread()
+{
+	if(!log_writer_started)
+		return 0;
+#if defined(CONF_FAMILY_WINDOWS)
+	return GetCurrentThreadId() == log_writer_id;
+#else
+	return pthread_equal(pthread_self(), log_writer_id);
+#endif
+}
+
+static int log_push(const char *line)
+{
+	int len, num_slots, i;
+	int waited = 0;
+	unsigned pos;
+
+	/* the writer thread can't wait for itself to free slots */
+	if(!log_async_running || log_on_writer_thread())
+		return 0;
+
+	log_add(log_producers, 1);
+	log_barrier();
+	if(!log_async_running)
+	{
+		log_add(log_producers, -1);
+		return 0;
+	}
+
+	len = strlen(line);
+	num_slots = len / LOG_SLOT_SIZE + 1;
+
+	/* reserve num_slots consecutive slots, the writer frees them in order
+	   so the last one being free means all of them are */
+	while(1)
+	{
+		LOG_SLOT *last;
+		int dif;
+
+		pos = log_enqueue_pos;
+		last = &log_queue[(pos + num_slots - 1) & (LOG_QUEUE_SIZE - 1)];
+		dif = (int)(last->seq - (pos + num_slots - 1));
+		if(dif == 0)
+		{
+			if(log_compswap(log_enqueue_pos, pos, pos + num_slots) == pos)
+				break;
+		}
+		else if(dif < 0)
+		{
+			if(!log_block)
+			{
+				log_add(log_stats.dropped, 1);
+				log_add(log_producers, -1);
+				return 1;
+			}
+			if(!waited)
+			{
+				log_add(log_stats.blocked, 1);
+				waited = 1;
+			}
+			thread_sleep(1);
+		}
+	}
+
+	for(i = 0; i < num_slots; i++)
+	{
+		LOG_SLOT *slot = &log_queue[(pos + i) & (LOG_QUEUE_SIZE - 1)];
+		int size = len - i * LOG_SLOT_SIZE;
+		if(size > LOG_SLOT_SIZE)
+			size = LOG_SLOT_SIZE;
+		mem_copy(slot->data, line + i * LOG_SLOT_SIZE, size);
+		slot->size = size;
+		slot->more = i < num_slots - 1;
+		log_barrier();
+		slot->seq = pos + i + 1;
+	}
+
+	log_add(log_stats.queued, 1);
+	log_add(log_producers, -1);
+	return 1;
+}
+
+static void log_flush()
+{
+	fflush(stdout);
+	if(logfile)
+		io_flush(logfile);
+	log_add(log_stats.flushes, 1);
+}
+
+/* hands all complete lines to the loggers, returns how many there were */
+static int log_drain()
+{
+	char line[1024*4];
+	int num_lines = 0;
+
+	while(1)
+	{
+		LOG_SLOT *slot = &log_queue[log_dequeue_pos & (LOG_QUEUE_SIZE - 1)];
+		int len = 0, i;
+
+		if(slot->seq != log_dequeue_pos + 1)
+			break;
+		log_barrier();
+
+		/* the producer publishes the rest of the line right after the first slot */
+		while(1)
+		{
+			int more;
+			if(len + slot->size < (int)sizeof(line))
+			{
+				mem_copy(line + len, slot->data, slot->size);
+				len += slot->size;
+			}
+			more = slot->more;
+			slot->seq = log_dequeue_pos + LOG_QUEUE_SIZE;
+			log_dequeue_pos++;
+			if(!more)
+				break;
+
+			slot = &log_queue[log_dequeue_pos & (LOG_QUEUE_SIZE - 1)];
+			while(slot->seq != log_dequeue_pos + 1)
+				thread_yield();
+			log_barrier();
+		}
+		line[len] = 0;
+
+		for(i = 0; i < num_loggers; i++)
+			loggers[i](line);
+		num_lines++;
+	}
+
+	if(num_lines)
+		log_add(log_stats.written, num_lines);
+	return num_lines;
+}
+
+static void log_writer_thread(void *user)
+{
+	int64 last_flush = time_get();
+	int dirty = 0;
+
+#if defined(CONF_FAMILY_WINDOWS)
+	log_writer_id = GetCurrentThreadId();
+#else
+	log_writer_id = pthread_self();
+#endif
+	log_barrier();
+	log_writer_started = 1;
+
+	while(1)
+	{
+		int stopping = log_async_stopping;
+		int num_lines = log_drain();
+		int64 now = time_get();
+
+		if(num_lines)
+			dirty = 1;
+		if(dirty && (stopping || now - last_flush >= log_flush_interval * time_freq() / 1000))
+		{
+			log_flush();
+			last_flush = now;
+			dirty = 0;
+		}
+
+		/* producers are gone once stopping is set, drain one last time */
+		if(stopping && num_lines == 0)
+			break;
+		if(num_lines == 0)
+			thread_sleep(LOG_IDLE_SLEEP);
+	}
+
+	log_writer_started = 0;
+}
+
+void dbg_logger_async_start(int flush_interval, int block)
+{
+	unsigned i;
+
+	if(log_async_running)
+		return;
+
+	if(!log_queue)
+	{
+		log_queue = (LOG_SLOT *)malloc(sizeof(LOG_SLOT) * LOG_QUEUE_SIZE);
+		for(i = 0; i < LOG_QUEUE_SIZE; i++)
+			log_queue[i].seq = i;
+		log_enqueue_pos = 0;
+		log_dequeue_pos = 0;
+	}
+
+	log_flush_interval = flush_interval;
+	log_block = block;
+	log_async_stopping = 0;
+	log_batching = 1;
+	log_thread = thread_init(log_writer_thread, 0);
+	log_barrier();
+	log_async_running = 1;
+}
+
+void dbg_logger_async_stop()
+{
+	/* the writer thread can't wait for itself */
+	if(!log_async_running || log_on_writer_thread())
+		return;
+
+	/* new lines go to the loggers directly from now on, wait for the pushes in flight */
+	log_async_running = 0;
+	log_barrier();
+	while(log_producers)
+		thread_yield();
+
+	log_async_stopping = 1;
+	thread_wait(log_thread);
+	log_thread = 0;
+	log_batching = 0;
+}
+
+void dbg_logger_async_stats(LOGSTATS *stats)
+{
+	*stats = log_stats;
+}
 /* */
 
+/* memory stats are updated from the sql and job threads as well */
+#if defined(CONF_FAMILY_WINDOWS)
+	#define mem_stat_add(value, amount) InterlockedExchangeAdd((volatile LONG *)&(value), (amount))
+#else
+	#define mem_stat_add(value, amount) __sync_fetch_and_add(&(value), (amount))
+#endif
+
+/* returns the aligned user block inside raw, leaving room for header_size bytes in front of it */
+static char *mem_align_block(char *raw, unsigned header_size, unsigned alignment)
+{
+	size_t addr = (size_t)(raw + header_size);
+	return (char *)((addr + alignment - 1) & ~(size_t)(alignment - 1));
+}
+
+static unsigned mem_fix_alignment(unsigned alignment)
+{
+	/* at least the alignment malloc would give us, and always a power of two */
+	unsigned result = sizeof(void *) * 2;
+	while(result < alignment)
+		result <<= 1;
+	return result;
+}
+
+#if defined(CONF_FAST_ALLOC)
+
+typedef struct MEMHEADER
+{
+	void *raw;
+	size_t size;
+} MEMHEADER;
+
+void *mem_alloc_fast(unsigned size, unsigned alignment)
+{
+	MEMHEADER *header;
+	char *block;
+	char *raw;
+
+	alignment = mem_fix_alignment(alignment);
+	raw = (char *)malloc(size + sizeof(MEMHEADER) + alignment - 1);
+	dbg_assert(raw != 0, "mem_alloc failure");
+	if(!raw)
+		return NULL;
+
+	block = mem_align_block(raw, sizeof(MEMHEADER), alignment);
+	header = (MEMHEADER *)block - 1;
+	header->raw = raw;
+	header->size = size;
+
+	mem_stat_add(memory_stats.allocated, (int)size);
+	mem_stat_add(memory_stats.total_allocations, 1);
+	mem_stat_add(memory_stats.active_allocations, 1);
+	return block;
+}
+
+void mem_free(void *p)
+{
+	if(p)
+	{
+		MEMHEADER *header = (MEMHEADER *)p - 1;
+		mem_stat_add(memory_stats.allocated, -(int)header->size);
+		mem_stat_add(memory_stats.active_allocations, -1);
+		free(header->raw);
+	}
+}
+
+#else
+
 typedef struct MEMHEADER
 {
 	const char *filename;
 	int line;
 	int size;
+	void *raw;
 	struct MEMHEADER *prev;
 	struct MEMHEADER *next;
 } MEMHEADER;
@@ -162,34 +511,67 @@ typedef struct MEMTAIL
 static struct MEMHEADER *first = 0;
 static const int MEM_GUARD_VAL = 0xbaadc0de;
 
+/* guards the list of allocations, a spinlock so it needs no initialisation */
+static volatile long mem_list_lock = 0;
+
+static void mem_lock_list()
+{
+#if defined(CONF_FAMILY_WINDOWS)
+	while(InterlockedExchange(&mem_list_lock, 1))
+		Sleep(0);
+#else
+	while(__sync_lock_test_and_set(&mem_list_lock, 1))
+		sched_yield();
+#endif
+}
+
+static void mem_unlock_list()
+{
+#if defined(CONF_FAMILY_WINDOWS)
+	InterlockedExchange(&mem_list_lock, 0);
+#else
+	__sync_lock_release(&mem_list_lock);
+#endif
+}
+
 void *mem_alloc_debug(const char *filename, int line, unsigned size, unsigned alignment)
 {
-	/* TODO: fix alignment */
 	/* TODO: add debugging */
 	MEMTAIL *tail;
-	MEMHEADER *header = (struct MEMHEADER *)malloc(size+sizeof(MEMHEADER)+sizeof(MEMTAIL));
-	dbg_assert(header != 0, "mem_alloc failure");
-	if(!header)
+	MEMHEADER *header;
+	char *block;
+	char *raw;
+
+	alignment = mem_fix_alignment(alignment);
+	raw = (char *)malloc(size+sizeof(MEMHEADER)+sizeof(MEMTAIL)+alignment-1);
+	dbg_assert(raw != 0, "mem_alloc failure");
+	if(!raw)
 		return NULL;
-	tail = (struct MEMTAIL *)(((char*)(header+1))+size);
+
+	block = mem_align_block(raw, sizeof(MEMHEADER), alignment);
+	header = (MEMHEADER *)block - 1;
+	tail = (struct MEMTAIL *)(block+size);
 	header->size = size;
 	header->filename = filename;
 	header->line = line;
+	header->raw = raw;
 
-	memory_stats.allocated += header->size;
-	memory_stats.total_allocations++;
-	memory_stats.active_allocations++;
+	mem_stat_add(memory_stats.allocated, header->size);
+	mem_stat_add(memory_stats.total_allocations, 1);
+	mem_stat_add(memory_stats.active_allocations, 1);
 
 	tail->guard = MEM_GUARD_VAL;
 
+	mem_lock_list();
 	header->prev = (MEMHEADER *)0;
 	header->next = first;
 	if(first)
 		first->prev = header;
 	first = header;
+	mem_unlock_list();
 
 	/*dbg_msg("mem", "++ %p", header+1); */
-	return header+1;
+	return block;
 }
 
 void mem_free(void *p)
@@ -202,29 +584,36 @@ void mem_free(void *p)
 		if(tail->guard != MEM_GUARD_VAL)
 			dbg_msg("mem", "!! %p", p);
 		/* dbg_msg("mem", "-- %p", p); */
-		memory_stats.allocated -= header->size;
-		memory_stats.active_allocations--;
+		mem_stat_add(memory_stats.allocated, -header->size);
+		mem_stat_add(memory_stats.active_allocations, -1);
 
+		mem_lock_list();
 		if(header->prev)
 			header->prev->next = header->next;
 		else
 			first = header->next;
 		if(header->next)
 			header->next->prev = header->prev;
+		mem_unlock_list();
 
-		free(header);
+		free(header->raw);
 	}
 }
 
+#endif
+
 void mem_debug_dump(IOHANDLE file)
 {
+#if !defined(CONF_FAST_ALLOC)
 	char buf[1024];
-	MEMHEADER *header = first;
+	MEMHEADER *header;
 	if(!file)
 		file = io_open("memory.txt", IOFLAG_WRITE);
 
 	if(file)
 	{
+		mem_lock_list();
+		header = first;
 		while(header)
 		{
 			str_format(buf, sizeof(buf), "%s(%d): %d", header->filename, header->line, header->size);
@@ -232,9 +621,15 @@ void mem_debug_dump(IOHANDLE file)
 			io_write_newline(file);
 			header = header->next;
 		}
+		mem_unlock_list();
 
 		io_close(file);
 	}
+#else
+	/* allocations are not tracked by the production allocator */
+	if(file)
+		io_close(file);
+#endif
 }
 
 
@@ -255,17 +650,23 @@ void mem_zero(void *block,unsigned size)
 
 int mem_check_imp()
 {
-	MEMHEADER *header = first;
+#if !defined(CONF_FAST_ALLOC)
+	MEMHEADER *header;
+	mem_lock_list();
+	header = first;
 	while(header)
 	{
 		MEMTAIL *tail = (MEMTAIL *)(((char*)(header+1))+header->size);
 		if(tail->guard != MEM_GUARD_VAL)
 		{
 			dbg_msg("mem", "Memory check failed at %s(%d): %d", header->filename, header->line, header->size);
+			mem_unlock_list();
 			return 0;
 		}
 		header = header->next;
 	}
+	mem_unlock_list();
+#endif
 
 	return 1;
 }
@@ -538,7 +939,12 @@ void lock_unlock(LOCK lock)
 }
 /* DDNET MODIFICATION END *********************************************/
 
-#if !defined(CONF_PLATFORM_MACOSX)
+#if defined(CONF_PLATFORM_MACOSX)
+	void semaphore_init(SEMAPHORE *sem) { *sem = dispatch_semaphore_create(0); }
+	void semaphore_wait(SEMAPHORE *sem) { dispatch_semaphore_wait(*sem, DISPATCH_TIME_FOREVER); }
+	void semaphore_signal(SEMAPHORE *sem) { dispatch_semaphore_signal(*sem); }
+	void semaphore_destroy(SEMAPHORE *sem) { dispatch_release(*sem); }
+#else
 	#if defined(CONF_FAMILY_UNIX)
 	void semaphore_init(SEMAPHORE *sem) { sem_init(sem, 0, 0); }
 	void semaphore_wait(SEMAPHORE *sem) { sem_wait(sem); }
@@ -88,12 +88,20 @@ void dbg_msg(const char *sys, const char *fmt, ...);
 	Remarks:
 		- Passing 0 to size will allocated the smallest amount possible
 		and return a unique pointer.
+		- With CONF_FAST_ALLOC the allocations are not tracked, only
+		the <mem_stats> counters are kept. <mem_debug_dump> and
+		<mem_check> have nothing to check then.
 
 	See Also:
 		<mem_free>
 */
+#if defined(CONF_FAST_ALLOC)
+void *mem_alloc_fast(unsigned size, unsigned alignment);
+#define mem_alloc(s,a) mem_alloc_fast((s), (a))
+#else
 void *mem_alloc_debug(const char *filename, int line, unsigned size, unsigned alignment);
 #define mem_alloc(s,a) mem_alloc_debug(__FILE__, __LINE__, (s), (a))
+#endif
 
 /*
 	Function: mem_free
@@ -424,22 +432,23 @@ void lock_unlock(LOCK lock);
 
 /* Group: Semaphores */
 
-#if !defined(CONF_PLATFORM_MACOSX)
-	#if defined(CONF_FAMILY_UNIX)
-		#include <semaphore.h>
-		typedef sem_t SEMAPHORE;
-	#elif defined(CONF_FAMILY_WINDOWS)
-		typedef void* SEMAPHORE;
-	#else
-		#error missing sempahore implementation
-	#endif
-
-	void semaphore_init(SEMAPHORE *sem);
-	void semaphore_wait(SEMAPHORE *sem);
-	void semaphore_signal(SEMAPHORE *sem);
-	void semaphore_destroy(SEMAPHORE *sem);
+#if defined(CONF_PLATFORM_MACOSX)
+	#include <dispatch/dispatch.h>
+	typedef dispatch_semaphore_t SEMAPHORE;
+#elif defined(CONF_FAMILY_UNIX)
+	#include <semaphore.h>
+	typedef sem_t SEMAPHORE;
+#elif defined(CONF_FAMILY_WINDOWS)
+	typedef void* SEMAPHORE;
+#else
+	#error missing sempahore implementation
 #endif
 
+void semaphore_init(SEMAPHORE *sem);
+void semaphore_wait(SEMAPHORE *sem);
+void semaphore_signal(SEMAPHORE *sem);
+void semaphore_destroy(SEMAPHORE *sem);
+
 /* Group: Timer */
 #ifdef __GNUC__
 /* if compiled with -pedantic-errors it will complain about long
@@ -1195,6 +1204,35 @@ void dbg_logger_stdout();
 void dbg_logger_debugger();
 void dbg_logger_file(const char *filename);
 
+/*
+	Function: dbg_logger_async_start
+		Hands the lines of dbg_msg to the loggers from a writer thread.
+		dbg_msg only copies the line into a ring buffer.
+
+	Parameters:
+		flush_interval - Milliseconds between flushes of the written lines.
+		block - Wait for free space when the ring is full instead of dropping the line.
+*/
+void dbg_logger_async_start(int flush_interval, int block);
+
+/*
+	Function: dbg_logger_async_stop
+		Writes the queued lines and goes back to logging synchronously.
+		Does nothing when called from the writer thread.
+*/
+void dbg_logger_async_stop();
+
+typedef struct
+{
+	unsigned queued;
+	unsigned dropped;
+	unsigned blocked;
+	unsigned written;
+	unsigned flushes;
+} LOGSTATS;
+
+void dbg_logger_async_stats(LOGSTATS *stats);
+
 typedef struct
 {
 	int allocated;
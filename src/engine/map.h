@@ -24,9 +24,13 @@ class IEngineMap : public IMap
 	MACRO_INTERFACE("enginemap", 0)
 public:
 	virtual bool Load(const char *pMapName) = 0;
+	// for maps that are not registered in the kernel
+	virtual bool Load(class IStorage *pStorage, const char *pMapName) = 0;
 	virtual bool IsLoaded() = 0;
 	virtual void Unload() = 0;
 	virtual unsigned Crc() = 0;
+	// exchanges the loaded data with another map, both have to be created by CreateEngineMap
+	virtual void Swap(IEngineMap *pOther) = 0;
 };
 
 extern IEngineMap *CreateEngineMap();
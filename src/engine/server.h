@@ -251,29 +251,20 @@ public:
 
 	bool Translate(int& target, int client)
 	{
-		CClientInfo info;
-		GetClientInfo(client, &info);
-		if (info.m_CustClt)
+		if (IsCustClt(client))
 			return true;
-		int* map = GetIdMap(client);
-		bool found = false;
-		for (int i = 0; i < VANILLA_MAX_CLIENTS; i++)
-		{
-			if (target == map[i])
-			{
-				target = i;
-				found = true;
-				break;
-			}
-		}
-		return found;
+		if (target < 0 || target >= MAX_CLIENTS)
+			return false;
+		int* rMap = GetReverseIdMap(client);
+		if (rMap[target] == -1)
+			return false;
+		target = rMap[target];
+		return true;
 	}
 
 	bool ReverseTranslate(int& target, int client)
 	{
-		CClientInfo info;
-		GetClientInfo(client, &info);
-		if (info.m_CustClt)
+		if (IsCustClt(client))
 			return true;
 		int* map = GetIdMap(client);
 		if (map[target] == -1)
@@ -285,10 +276,14 @@ public:
 	virtual void SetClientName(int ClientID, char const *pName) = 0;
 	virtual void SetClientClan(int ClientID, char const *pClan) = 0;
 	virtual void SetClientCountry(int ClientID, int Country) = 0;
+	// something shown in the server browser changed
+	virtual void ExpireServerInfo() = 0;
 
 	virtual int SnapNewID() = 0;
 	virtual void SnapFreeID(int ID) = 0;
 	virtual void *SnapNewItem(int Type, int ID, int Size) = 0;
+	// redirects SnapNewItem into another builder, 0 restores the client snapshot
+	virtual void SnapSetBuilder(class CSnapshotBuilder *pBuilder) = 0;
 
 	virtual void SnapSetStaticsize(int ItemType, int Size) = 0;
 
@@ -377,7 +372,23 @@ public:
 /* INFECTION MODIFICATION END *****************************************/
 
 	virtual int* GetIdMap(int ClientID) = 0;
+	// global id -> vanilla id, kept in sync with the id map by UpdateReverseIdMap()
+	virtual int* GetReverseIdMap(int ClientID) = 0;
 	virtual void SetCustClt(int ClientID) = 0;
+	virtual bool IsCustClt(int ClientID) const = 0;
+
+	void UpdateReverseIdMap(int ClientID)
+	{
+		int* map = GetIdMap(ClientID);
+		int* rMap = GetReverseIdMap(ClientID);
+		for (int i = 0; i < MAX_CLIENTS; i++)
+			rMap[i] = -1;
+		for (int i = VANILLA_MAX_CLIENTS - 1; i >= 0; i--)
+		{
+			if (map[i] != -1)
+				rMap[map[i]] = i;
+		}
+	}
 };
 
 class IGameServer : public IInterface
@@ -0,0 +1,367 @@
+#ifdef CONF_SQL
+#include <base/math.h>
+
+#include "leaderboard.h"
+
+CLeaderboardCache::CLeaderboardCache()
+{
+	m_Lock = lock_create();
+	m_aLoadingMap[0] = 0;
+	m_DailyScoreType = -1;
+	m_NumDailyScores = 0;
+	mem_zero(&m_Stats, sizeof(m_Stats));
+	m_Generation = 0;
+}
+
+CLeaderboardCache::~CLeaderboardCache()
+{
+	for(int i=0; i<m_Maps.size(); i++)
+		DeleteMap(m_Maps[i]);
+	lock_destroy(m_Lock);
+}
+
+void CLeaderboardCache::DeleteMap(CMap* pMap)
+{
+	for(int i=0; i<pMap->m_Boards.size(); i++)
+		delete pMap->m_Boards[i];
+	delete pMap;
+}
+
+CLeaderboardCache::CMap* CLeaderboardCache::FindMap(const char* pMapName)
+{
+	for(int i=0; i<m_Maps.size(); i++)
+	{
+		if(str_comp(m_Maps[i]->m_aMapName, pMapName) == 0)
+			return m_Maps[i];
+	}
+	return 0;
+}
+
+CLeaderboardCache::CBoard* CLeaderboardCache::FindBoard(CMap* pMap, int ScoreType, bool Create)
+{
+	for(int i=0; i<pMap->m_Boards.size(); i++)
+	{
+		if(pMap->m_Boards[i]->m_ScoreType == ScoreType)
+			return pMap->m_Boards[i];
+	}
+	
+	if(!Create)
+		return 0;
+	
+	CBoard* pBoard = new CBoard;
+	pBoard->m_ScoreType = ScoreType;
+	pMap->m_Boards.add(pBoard);
+	return pBoard;
+}
+
+static bool EntryIsBefore(const CLeaderboardCache::CEntry& a, const CLeaderboardCache::CEntry& b)
+{
+	if(a.m_Total != b.m_Total)
+		return a.m_Total > b.m_Total;
+	return a.m_UserID < b.m_UserID;
+}
+
+void CLeaderboardCache::SortEntries(array<CEntry>* pEntries)
+{
+	// shell sort, the boards can have a few thousand players
+	CEntry* pData = pEntries->base_ptr();
+	int Num = pEntries->size();
+	for(int Gap = Num/2; Gap > 0; Gap /= 2)
+	{
+		for(int i = Gap; i < Num; i++)
+		{
+			CEntry Tmp = pData[i];
+			int j = i;
+			for(; j >= Gap && EntryIsBefore(Tmp, pData[j-Gap]); j -= Gap)
+				pData[j] = pData[j-Gap];
+			pData[j] = Tmp;
+		}
+	}
+}
+
+void CLeaderboardCache::InsertScore(CEntry* pEntry, int Score)
+{
+	int Pos = pEntry->m_NumScores;
+	if(Pos == SQL_SCORE_NUMROUND)
+	{
+		if(Score <= pEntry->m_aScores[Pos-1])
+			return;
+		Pos--;
+	}
+	else
+		pEntry->m_NumScores++;
+	
+	for(; Pos > 0 && pEntry->m_aScores[Pos-1] < Score; Pos--)
+		pEntry->m_aScores[Pos] = pEntry->m_aScores[Pos-1];
+	pEntry->m_aScores[Pos] = Score;
+	
+	pEntry->m_Total = 0;
+	for(int i=0; i<pEntry->m_NumScores; i++)
+		pEntry->m_Total += pEntry->m_aScores[i];
+}
+
+bool CLeaderboardCache::StartLoad(const char* pMapName, int64 MaxAge)
+{
+	bool Load = false;
+	
+	lock_wait(m_Lock);
+	if(m_aLoadingMap[0] == 0)
+	{
+		CMap* pMap = FindMap(pMapName);
+		if(!pMap || time_get() - pMap->m_LoadTime > MaxAge)
+		{
+			str_copy(m_aLoadingMap, pMapName, sizeof(m_aLoadingMap));
+			Load = true;
+		}
+	}
+	lock_unlock(m_Lock);
+	
+	return Load;
+}
+
+void CLeaderboardCache::EndLoad(const char* pMapName, array<CEntry>* pEntries, array<int>* pScoreTypes)
+{
+	lock_wait(m_Lock);
+	
+	m_aLoadingMap[0] = 0;
+	
+	if(pEntries)
+	{
+		CMap* pMap = FindMap(pMapName);
+		if(pMap)
+		{
+			for(int i=0; i<pMap->m_Boards.size(); i++)
+				delete pMap->m_Boards[i];
+			pMap->m_Boards.clear();
+		}
+		else
+		{
+			// keep the most recently loaded maps only
+			if(m_Maps.size() >= MAX_MAPS)
+			{
+				int Oldest = 0;
+				for(int i=1; i<m_Maps.size(); i++)
+				{
+					if(m_Maps[i]->m_LoadTime < m_Maps[Oldest]->m_LoadTime)
+						Oldest = i;
+				}
+				DeleteMap(m_Maps[Oldest]);
+				m_Maps.remove_index(Oldest);
+			}
+			
+			pMap = new CMap;
+			str_copy(pMap->m_aMapName, pMapName, sizeof(pMap->m_aMapName));
+			m_Maps.add(pMap);
+		}
+		
+		pMap->m_LoadTime = time_get();
+		
+		CBoard* pBoard = 0;
+		for(int i=0; i<pEntries->size(); i++)
+		{
+			int ScoreType = (*pScoreTypes)[i];
+			if(!pBoard || pBoard->m_ScoreType != ScoreType)
+				pBoard = FindBoard(pMap, ScoreType, true);
+			pBoard->m_Entries.add((*pEntries)[i]);
+		}
+		
+		for(int i=0; i<pMap->m_Boards.size(); i++)
+			SortEntries(&pMap->m_Boards[i]->m_Entries);
+		
+		m_Stats.m_Loads++;
+		m_Generation++;
+	}
+	
+	lock_unlock(m_Lock);
+}
+
+void CLeaderboardCache::SetDailyScores(int ScoreType, const CDailyScore* pScores, int NumScores)
+{
+	lock_wait(m_Lock);
+	m_DailyScoreType = ScoreType;
+	m_NumDailyScores = min(NumScores, (int)NUM_DAILY_SCORES);
+	for(int i=0; i<m_NumDailyScores; i++)
+		m_aDailyScores[i] = pScores[i];
+	m_Generation++;
+	lock_unlock(m_Lock);
+}
+
+int CLeaderboardCache::Generation()
+{
+	lock_wait(m_Lock);
+	int Generation = m_Generation;
+	lock_unlock(m_Lock);
+	return Generation;
+}
+
+void CLeaderboardCache::AddScore(int Generation, const char* pMapName, int ScoreType, int UserID, const char* pUsername, int Score)
+{
+	lock_wait(m_Lock);
+	
+	if(Generation != m_Generation)
+	{
+		lock_unlock(m_Lock);
+		return;
+	}
+	
+	CMap* pMap = FindMap(pMapName);
+	if(pMap)
+	{
+		CBoard* pBoard = FindBoard(pMap, ScoreType, true);
+		array<CEntry>& Entries = pBoard->m_Entries;
+		
+		int Index = -1;
+		for(int i=0; i<Entries.size(); i++)
+		{
+			if(Entries[i].m_UserID == UserID)
+			{
+				Index = i;
+				break;
+			}
+		}
+		
+		if(Index < 0)
+		{
+			CEntry Entry;
+			mem_zero(&Entry, sizeof(Entry));
+			Entry.m_UserID = UserID;
+			str_copy(Entry.m_aUsername, pUsername, sizeof(Entry.m_aUsername));
+			Index = Entries.add(Entry);
+		}
+		
+		InsertScore(&Entries[Index], Score);
+		
+		// the total can only grow, move the entry up
+		CEntry Tmp = Entries[Index];
+		for(; Index > 0 && EntryIsBefore(Tmp, Entries[Index-1]); Index--)
+			Entries[Index] = Entries[Index-1];
+		Entries[Index] = Tmp;
+		
+		m_Stats.m_Updates++;
+	}
+	
+	if(ScoreType == m_DailyScoreType)
+	{
+		int Pos = m_NumDailyScores;
+		if(Pos < NUM_DAILY_SCORES)
+			m_NumDailyScores++;
+		else if(Score > m_aDailyScores[Pos-1].m_Score)
+			Pos--;
+		else
+			Pos = -1;
+		
+		if(Pos >= 0)
+		{
+			for(; Pos > 0 && m_aDailyScores[Pos-1].m_Score < Score; Pos--)
+				m_aDailyScores[Pos] = m_aDailyScores[Pos-1];
+			str_copy(m_aDailyScores[Pos].m_aUsername, pUsername, sizeof(m_aDailyScores[Pos].m_aUsername));
+			m_aDailyScores[Pos].m_Score = Score;
+		}
+	}
+	
+	lock_unlock(m_Lock);
+}
+
+bool CLeaderboardCache::GetTop(const char* pMapName, int ScoreType, CEntry* pEntries, int MaxEntries, int* pNumEntries)
+{
+	lock_wait(m_Lock);
+	
+	CMap* pMap = FindMap(pMapName);
+	if(!pMap)
+	{
+		m_Stats.m_Misses++;
+		lock_unlock(m_Lock);
+		return false;
+	}
+	
+	*pNumEntries = 0;
+	CBoard* pBoard = FindBoard(pMap, ScoreType, false);
+	if(pBoard)
+	{
+		*pNumEntries = min(MaxEntries, pBoard->m_Entries.size());
+		for(int i=0; i<*pNumEntries; i++)
+			pEntries[i] = pBoard->m_Entries[i];
+	}
+	
+	m_Stats.m_Hits++;
+	lock_unlock(m_Lock);
+	return true;
+}
+
+bool CLeaderboardCache::GetRank(const char* pMapName, int ScoreType, int UserID, int* pRank, CEntry* pEntry)
+{
+	lock_wait(m_Lock);
+	
+	CMap* pMap = FindMap(pMapName);
+	if(!pMap)
+	{
+		m_Stats.m_Misses++;
+		lock_unlock(m_Lock);
+		return false;
+	}
+	
+	*pRank = 0;
+	CBoard* pBoard = FindBoard(pMap, ScoreType, false);
+	if(pBoard)
+	{
+		for(int i=0; i<pBoard->m_Entries.size(); i++)
+		{
+			if(pBoard->m_Entries[i].m_UserID == UserID)
+			{
+				*pRank = i+1;
+				*pEntry = pBoard->m_Entries[i];
+				break;
+			}
+		}
+	}
+	
+	m_Stats.m_Hits++;
+	lock_unlock(m_Lock);
+	return true;
+}
+
+int CLeaderboardCache::GetDailyScores(int ScoreType, CDailyScore* pScores, int MaxScores)
+{
+	int NumScores = -1;
+	
+	lock_wait(m_Lock);
+	if(ScoreType == m_DailyScoreType)
+	{
+		NumScores = min(MaxScores, m_NumDailyScores);
+		for(int i=0; i<NumScores; i++)
+			pScores[i] = m_aDailyScores[i];
+	}
+	lock_unlock(m_Lock);
+	
+	return NumScores;
+}
+
+void CLeaderboardCache::Invalidate()
+{
+	lock_wait(m_Lock);
+	for(int i=0; i<m_Maps.size(); i++)
+		DeleteMap(m_Maps[i]);
+	m_Maps.clear();
+	m_DailyScoreType = -1;
+	m_NumDailyScores = 0;
+	m_Generation++;
+	lock_unlock(m_Lock);
+}
+
+void CLeaderboardCache::GetStats(CStats* pStats)
+{
+	lock_wait(m_Lock);
+	*pStats = m_Stats;
+	pStats->m_NumMaps = m_Maps.size();
+	pStats->m_NumBoards = 0;
+	pStats->m_NumEntries = 0;
+	for(int i=0; i<m_Maps.size(); i++)
+	{
+		pStats->m_NumBoards += m_Maps[i]->m_Boards.size();
+		for(int j=0; j<m_Maps[i]->m_Boards.size(); j++)
+			pStats->m_NumEntries += m_Maps[i]->m_Boards[j]->m_Entries.size();
+	}
+	lock_unlock(m_Lock);
+}
+
+#endif
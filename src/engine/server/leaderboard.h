@@ -0,0 +1,106 @@
+#ifdef CONF_SQL
+#ifndef ENGINE_SERVER_LEADERBOARD_H
+#define ENGINE_SERVER_LEADERBOARD_H
+
+#include <base/system.h>
+#include <base/tl/array.h>
+#include "sql_server.h"
+
+// in-memory copy of the per map rankings and of the scores of the day,
+// filled by the sql jobs and read by the main thread
+class CLeaderboardCache
+{
+public:
+	enum
+	{
+		MAX_MAPS=4,
+		NUM_DAILY_SCORES=5,
+	};
+
+	struct CEntry
+	{
+		int m_UserID;
+		char m_aUsername[64];
+		int m_aScores[SQL_SCORE_NUMROUND]; // best round scores, sorted
+		int m_NumScores;
+		int m_Total;
+	};
+
+	struct CDailyScore
+	{
+		char m_aUsername[64];
+		int m_Score;
+	};
+
+	struct CStats
+	{
+		int m_NumMaps;
+		int m_NumBoards;
+		int m_NumEntries;
+		int64 m_Hits;
+		int64 m_Misses;
+		int64 m_Loads;
+		int64 m_Updates;
+	};
+
+private:
+	struct CBoard
+	{
+		int m_ScoreType;
+		array<CEntry> m_Entries; // sorted by total, then by user id
+	};
+
+	struct CMap
+	{
+		char m_aMapName[64];
+		int64 m_LoadTime;
+		array<CBoard*> m_Boards;
+	};
+
+	LOCK m_Lock;
+	array<CMap*> m_Maps;
+	char m_aLoadingMap[64];
+
+	int m_DailyScoreType;
+	CDailyScore m_aDailyScores[NUM_DAILY_SCORES];
+	int m_NumDailyScores;
+
+	CStats m_Stats;
+	
+	// incremented each time data read from the database replaces the cache
+	int m_Generation;
+
+	CMap* FindMap(const char* pMapName);
+	CBoard* FindBoard(CMap* pMap, int ScoreType, bool Create);
+	static void DeleteMap(CMap* pMap);
+	static void SortEntries(array<CEntry>* pEntries);
+	static void InsertScore(CEntry* pEntry, int Score);
+
+public:
+	CLeaderboardCache();
+	~CLeaderboardCache();
+
+	// true if the map should be (re)loaded from the database, marks it as loading
+	bool StartLoad(const char* pMapName, int64 MaxAge);
+	// called when the load job ends, pEntries/pScoreTypes are 0 if it failed
+	void EndLoad(const char* pMapName, array<CEntry>* pEntries, array<int>* pScoreTypes);
+	void SetDailyScores(int ScoreType, const CDailyScore* pScores, int NumScores);
+
+	// read before writing scores to the database, and passed to AddScore
+	int Generation();
+	// scores written by this server, applied without reloading. Ignored if
+	// the cache was reloaded since Generation was read: the reload may have
+	// seen the scores in the database already
+	void AddScore(int Generation, const char* pMapName, int ScoreType, int UserID, const char* pUsername, int Score);
+
+	// all return false if the map is not cached yet
+	bool GetTop(const char* pMapName, int ScoreType, CEntry* pEntries, int MaxEntries, int* pNumEntries);
+	bool GetRank(const char* pMapName, int ScoreType, int UserID, int* pRank, CEntry* pEntry);
+	int GetDailyScores(int ScoreType, CDailyScore* pScores, int MaxScores);
+
+	void Invalidate();
+	void GetStats(CStats* pStats);
+};
+
+#endif
+#endif
@@ -120,6 +120,14 @@ CMapConverter::~CMapConverter()
 		delete[] m_pTiles;
 }
 
+void CMapConverter::Print(int Level, const char *pStr)
+{
+	if(Console())
+		Console()->Print(Level, "infclass", pStr);
+	else
+		dbg_msg("infclass", "%s", pStr);
+}
+
 bool CMapConverter::Load()
 {
 	m_AnimationCycle = 1;
@@ -160,7 +168,7 @@ bool CMapConverter::Load()
 	
 	if(!pPhysicsLayer)
 	{
-		Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "infclass", "no physics layer in loaded map");
+		Print(IConsole::OUTPUT_LEVEL_STANDARD, "no physics layer in loaded map");
 		return false;
 	}
 		
@@ -987,7 +995,7 @@ bool CMapConverter::CreateMap(const char* pFilename)
 	if(!m_DataFile.Open(Storage(), pFilename))
 	{
 		str_format(aBuf, sizeof(aBuf), "failed to open file '%s'...", pFilename);
-		Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "infclass", aBuf);
+		Print(IConsole::OUTPUT_LEVEL_STANDARD, aBuf);
 		return false;
 	}
 	
@@ -1025,6 +1033,6 @@ bool CMapConverter::CreateMap(const char* pFilename)
 	m_DataFile.AddItem(MAPITEMTYPE_ENVPOINTS, 0, m_lEnvPoints.size()*sizeof(CEnvPoint), m_lEnvPoints.base_ptr());
 	m_DataFile.Finish();
 	
-	Console()->Print(IConsole::OUTPUT_LEVEL_ADDINFO, "infclass", "highres map created");
+	Print(IConsole::OUTPUT_LEVEL_ADDINFO, "highres map created");
 	return true;
 }
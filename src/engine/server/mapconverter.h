@@ -49,6 +49,12 @@ public:
 		TIMESHIFT_MENUCLASS_MASK = NUM_MENUCLASS+1,
 	};
 
+	enum
+	{
+		// part of the client map cache key, increase it whenever CreateMap output changes
+		VERSION = 1,
+	};
+
 protected:
 	IStorage *m_pStorage;
 	IEngineMap *m_pMap;
@@ -74,6 +80,7 @@ protected:
 	IEngineMap* Map() { return m_pMap; };
 	IStorage* Storage() { return m_pStorage; };
 	IConsole* Console() { return m_pConsole; };
+	void Print(int Level, const char *pStr);
 	
 	void InitQuad(CQuad* pQuad);
 	void InitQuad(CQuad* pQuad, vec2 Pos, vec2 Size);
@@ -96,6 +103,7 @@ protected:
 	void Finalize();
 
 public:
+	// pConsole can be null when converting outside of the main thread
 	CMapConverter(IStorage *pStorage, IEngineMap *pMap, IConsole* pConsole);
 	~CMapConverter();
 	
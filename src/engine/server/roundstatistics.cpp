@@ -127,13 +127,17 @@ int CRoundStatistics::CPlayer::OnScoreEvent(int EventType, int Class)
 void CRoundStatistics::ResetPlayer(int ClientID)
 {
 	if(ClientID >= 0 && ClientID < MAX_CLIENTS)
+	{
 		m_aPlayers[ClientID].Reset();
+		m_ScoresChanged = true;
+	}
 }
 
 void CRoundStatistics::OnScoreEvent(int ClientID, int EventType, int Class, const char* Name, IConsole* console)
 {
 	if(ClientID >= 0 && ClientID < MAX_CLIENTS) {
 		int Score = m_aPlayers[ClientID].OnScoreEvent(EventType, Class);
+		m_ScoresChanged = true;
 
 		char aBuf[256];
 		str_format(aBuf, sizeof(aBuf), "score player='%s' amount='%d'",
@@ -68,10 +68,11 @@ public:
 	int m_NumPlayersMin;
 	int m_NumPlayersMax;
 	int m_PlayedTicks;
+	bool m_ScoresChanged; // cleared by the server once the server info shows the new scores
 	
 public:
 	CRoundStatistics() { Reset(); }
-	void Reset() { mem_zero(this, sizeof(CRoundStatistics)); }
+	void Reset() { mem_zero(this, sizeof(CRoundStatistics)); m_ScoresChanged = true; }
 	void ResetPlayer(int ClientID);
 	void OnScoreEvent(int ClientID, int EventType, int Class, const char* Name, IConsole* console);
 	void SetPlayerAsWinner(int ClientID);
@@ -5,6 +5,7 @@
 #include <base/math.h>
 #include <base/system.h>
 #include <base/tl/array.h>
+#include <base/tl/threading.h>
 
 #include <engine/config.h>
 #include <engine/console.h>
@@ -41,8 +42,11 @@
 #include <algorithm>
 #include <engine/server/mapconverter.h>
 #include <engine/server/sql_job.h>
+#include <engine/server/sql_roundscores.h>
 #include <engine/server/crypt.h>
 
+#include <zlib.h>
+
 #include <teeuniverses/components/localization.h>
 /* INFECTION MODIFICATION END *****************************************/
 
@@ -218,6 +222,73 @@ bool CServer::ConGetIDCount(IConsole::IResult *pResult, void *pUser)
 	return true;
 }
 
+bool CServer::ConSnapshotStorageStats(IConsole::IResult *pResult, void *pUser)
+{
+	CServer* pThis = (CServer*)pUser;
+	char aBuf[256];
+	int TotalRetained = 0;
+	int TotalArena = 0;
+	for(int i = 0; i < MAX_CLIENTS; i++)
+	{
+		const CSnapshotStorage &Storage = pThis->m_aClients[i].m_Snapshots;
+		TotalRetained += Storage.RetainedBytes();
+		TotalArena += Storage.ArenaSize();
+		if(pThis->m_aClients[i].m_State == CClient::STATE_EMPTY)
+			continue;
+
+		str_format(aBuf, sizeof(aBuf), "id=%d snapshots=%d retained=%d arena=%d",
+			i, Storage.NumSnapshots(), Storage.RetainedBytes(), Storage.ArenaSize());
+		pThis->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "Server", aBuf);
+	}
+	str_format(aBuf, sizeof(aBuf), "total retained=%d arena=%d", TotalRetained, TotalArena);
+	pThis->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "Server", aBuf);
+	return true;
+}
+
+bool CServer::ConGenerateClientMaps(IConsole::IResult *pResult, void *pUser)
+{
+	CServer* pThis = (CServer*)pUser;
+	const char *pList = pResult->NumArguments() > 0 ? pResult->GetString(0) : g_Config.m_SvMaprotation;
+	IEngineMap *pMap = CreateEngineMap();
+	char aBuf[256];
+	int NumGenerated = 0;
+
+	while(*pList)
+	{
+		//Maps are separated by spaces or commas, like in sv_maprotation
+		while(*pList == ' ' || *pList == ',' || *pList == '\t')
+			pList++;
+
+		char aMapName[128];
+		int Length = 0;
+		while(pList[Length] && pList[Length] != ' ' && pList[Length] != ',' && pList[Length] != '\t')
+			Length++;
+		if(!Length)
+			break;
+		str_copy(aMapName, pList, min(Length+1, (int)sizeof(aMapName)));
+		pList += Length;
+
+		char aMapFile[256];
+		char aClientMapName[256];
+		str_format(aMapFile, sizeof(aMapFile), "maps/%s.map", aMapName);
+		if(pMap->Load(pThis->Storage(), aMapFile) && pThis->PrepareClientMap(aMapName, pMap, aClientMapName, sizeof(aClientMapName), 0, pThis->Console()))
+		{
+			str_format(aBuf, sizeof(aBuf), "client map for '%s' is ready", aMapName);
+			NumGenerated++;
+		}
+		else
+			str_format(aBuf, sizeof(aBuf), "failed to prepare the client map for '%s'", aMapName);
+		pThis->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "server", aBuf);
+		pMap->Unload();
+	}
+
+	delete pMap;
+
+	str_format(aBuf, sizeof(aBuf), "%d client maps ready", NumGenerated);
+	pThis->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "server", aBuf);
+	return true;
+}
+
 void CServerBan::InitServerBan(IConsole *pConsole, IStorage *pStorage, CServer* pServer)
 {
 	CNetBan::Init(pConsole, pStorage);
@@ -388,6 +459,16 @@ CServer::CServer() : m_DemoRecorder(&m_SnapshotDelta)
 	m_TickSpeed = SERVER_TICK_SPEED;
 
 	m_pGameServer = 0;
+	m_pSnapTarget = &m_SnapshotBuilder;
+
+	m_pSnapJobs = 0;
+	m_NumSnapJobs = 0;
+	m_NextSnapJob = 0;
+	m_NumSnapThreads = 0;
+	m_SnapThreadsStop = false;
+	m_SnapJobLock = lock_create();
+	semaphore_init(&m_SnapJobSem);
+	semaphore_init(&m_SnapDoneSem);
 
 	m_CurrentGameTick = 0;
 	m_RunServer = 1;
@@ -397,12 +478,17 @@ CServer::CServer() : m_DemoRecorder(&m_SnapshotDelta)
 
 	m_MapReload = 0;
 
+	m_MapPrepare.m_pMap = CreateEngineMap();
+	m_MapPrepare.m_pData = 0;
+	m_MapPrepareState = MAPPREPARE_IDLE;
+
 	m_RconClientID = IServer::RCON_CID_SERV;
 	m_RconAuthLevel = AUTHED_ADMIN;
 
 	m_ServerInfoFirstRequest = 0;
 	m_ServerInfoNumRequests = 0;
 	m_ServerInfoHighLoad = false;
+	m_ServerInfoDirty = 1;
 
 #ifdef CONF_SQL
 /* DDNET MODIFICATION START *******************************************/
@@ -416,7 +502,6 @@ CServer::CServer() : m_DemoRecorder(&m_SnapshotDelta)
 	CSqlConnector::SetWriteServers(m_apSqlWriteServers);
 /* DDNET MODIFICATION END *********************************************/
 	
-	m_GameServerCmdLock = lock_create();
 	m_ChallengeLock = lock_create();
 #endif
 	
@@ -426,9 +511,19 @@ CServer::CServer() : m_DemoRecorder(&m_SnapshotDelta)
 CServer::~CServer()
 {
 #ifdef CONF_SQL
-	lock_destroy(m_GameServerCmdLock);
 	lock_destroy(m_ChallengeLock);
 #endif
+	// the snap workers are idle between snapshots
+	StopSnapThreads();
+	lock_destroy(m_SnapJobLock);
+	semaphore_destroy(&m_SnapJobSem);
+	semaphore_destroy(&m_SnapDoneSem);
+	delete[] m_pSnapJobs;
+
+	// Run waits for the map prepare thread before returning
+	delete m_MapPrepare.m_pMap;
+	if(m_MapPrepare.m_pData)
+		mem_free(m_MapPrepare.m_pData);
 }
 
 int CServer::TrySetClientName(int ClientID, const char *pName)
@@ -469,6 +564,7 @@ int CServer::TrySetClientName(int ClientID, const char *pName)
 	
 	// set the client name
 	str_copy(m_aClients[ClientID].m_aName, pName, MAX_NAME_LENGTH);
+	ExpireServerInfo();
 	return 0;
 }
 
@@ -509,6 +605,7 @@ void CServer::SetClientClan(int ClientID, const char *pClan)
 		return;
 
 	str_copy(m_aClients[ClientID].m_aClan, pClan, MAX_CLAN_LENGTH);
+	ExpireServerInfo();
 }
 
 void CServer::SetClientCountry(int ClientID, int Country)
@@ -517,6 +614,7 @@ void CServer::SetClientCountry(int ClientID, int Country)
 		return;
 
 	m_aClients[ClientID].m_Country = Country;
+	ExpireServerInfo();
 }
 
 void CServer::Kick(int ClientID, const char *pReason)
@@ -564,6 +662,10 @@ int CServer::Init()
 		m_aClients[i].m_aClan[0] = 0;
 		m_aClients[i].m_CustClt = 0;
 		m_aClients[i].m_Country = -1;
+		for(int j = 0; j < VANILLA_MAX_CLIENTS; j++)
+			IdMap[i * VANILLA_MAX_CLIENTS + j] = -1;
+		for(int j = 0; j < MAX_CLIENTS; j++)
+			m_aReverseIdMap[i * MAX_CLIENTS + j] = -1;
 		m_aClients[i].m_Snapshots.Init();
 		m_aClients[i].m_WaitingTime = 0;
 		m_aClients[i].m_WasInfected = 0;
@@ -894,6 +996,96 @@ int CServer::SendMsgEx(CMsgPacker *pMsg, int Flags, int ClientID, bool System)
 	return 0;
 }
 
+void CServer::ProcessSnapJob(CSnapJob *pJob)
+{
+	// create delta
+	int DeltaSize = m_SnapshotDelta.CreateDelta(pJob->m_pDeltashot, (CSnapshot *)pJob->m_aData, pJob->m_aDeltaData);
+
+	// compress it
+	pJob->m_CompSize = DeltaSize ? CVariableInt::Compress(pJob->m_aDeltaData, DeltaSize, pJob->m_aCompData) : 0;
+}
+
+void CServer::SendSnapJob(int ClientID, CSnapJob *pJob)
+{
+	if(pJob->m_CompSize)
+	{
+		const int MaxSize = MAX_SNAPSHOT_PACKSIZE;
+		int NumPackets = (pJob->m_CompSize+MaxSize-1)/MaxSize;
+
+		for(int n = 0, Left = pJob->m_CompSize; Left; n++)
+		{
+			int Chunk = Left < MaxSize ? Left : MaxSize;
+			Left -= Chunk;
+
+			if(NumPackets == 1)
+			{
+				CMsgPacker Msg(NETMSG_SNAPSINGLE);
+				Msg.AddInt(m_CurrentGameTick);
+				Msg.AddInt(m_CurrentGameTick-pJob->m_DeltaTick);
+				Msg.AddInt(pJob->m_Crc);
+				Msg.AddInt(Chunk);
+				Msg.AddRaw(&pJob->m_aCompData[n*MaxSize], Chunk);
+				SendMsgEx(&Msg, MSGFLAG_FLUSH, ClientID, true);
+			}
+			else
+			{
+				CMsgPacker Msg(NETMSG_SNAP);
+				Msg.AddInt(m_CurrentGameTick);
+				Msg.AddInt(m_CurrentGameTick-pJob->m_DeltaTick);
+				Msg.AddInt(NumPackets);
+				Msg.AddInt(n);
+				Msg.AddInt(pJob->m_Crc);
+				Msg.AddInt(Chunk);
+				Msg.AddRaw(&pJob->m_aCompData[n*MaxSize], Chunk);
+				SendMsgEx(&Msg, MSGFLAG_FLUSH, ClientID, true);
+			}
+		}
+	}
+	else
+	{
+		CMsgPacker Msg(NETMSG_SNAPEMPTY);
+		Msg.AddInt(m_CurrentGameTick);
+		Msg.AddInt(m_CurrentGameTick-pJob->m_DeltaTick);
+		SendMsgEx(&Msg, MSGFLAG_FLUSH, ClientID, true);
+	}
+}
+
+void CServer::SnapWorkerThread(void *pUser)
+{
+	CServer *pThis = (CServer *)pUser;
+
+	while(1)
+	{
+		semaphore_wait(&pThis->m_SnapJobSem);
+
+		lock_wait(pThis->m_SnapJobLock);
+		if(pThis->m_SnapThreadsStop)
+		{
+			lock_release(pThis->m_SnapJobLock);
+			break;
+		}
+		int ClientID = pThis->m_aSnapJobQueue[pThis->m_NextSnapJob++];
+		lock_release(pThis->m_SnapJobLock);
+
+		pThis->ProcessSnapJob(&pThis->m_pSnapJobs[ClientID]);
+		semaphore_signal(&pThis->m_SnapDoneSem);
+	}
+}
+
+void CServer::StopSnapThreads()
+{
+	lock_wait(m_SnapJobLock);
+	m_SnapThreadsStop = true;
+	lock_release(m_SnapJobLock);
+
+	// one wake up per worker, each of them leaves after taking one
+	for(int i = 0; i < m_NumSnapThreads; i++)
+		semaphore_signal(&m_SnapJobSem);
+	for(int i = 0; i < m_NumSnapThreads; i++)
+		thread_wait(m_apSnapThreads[i]);
+	m_NumSnapThreads = 0;
+}
+
 void CServer::DoSnapshot()
 {
 	GameServer()->OnPreSnap();
@@ -913,6 +1105,24 @@ void CServer::DoSnapshot()
 		m_DemoRecorder.RecordSnapshot(Tick(), aData, SnapshotSize);
 	}
 
+	if(!m_pSnapJobs)
+		m_pSnapJobs = new CSnapJob[MAX_CLIENTS];
+
+	// start more workers if requested, they are kept until shutdown
+	while(m_NumSnapThreads < g_Config.m_SvSnapThreads && m_NumSnapThreads < MAX_SNAP_THREADS)
+	{
+		void *pThread = thread_init(SnapWorkerThread, this);
+		if(!pThread)
+			break;
+		m_apSnapThreads[m_NumSnapThreads++] = pThread;
+	}
+	bool Threaded = g_Config.m_SvSnapThreads > 0 && m_NumSnapThreads > 0;
+
+	static CSnapshot EmptySnap;
+	EmptySnap.Clear();
+	m_NumSnapJobs = 0;
+	m_NextSnapJob = 0;
+
 	// create snapshots for all clients
 	for(int i = 0; i < MAX_CLIENTS; i++)
 	{
@@ -929,17 +1139,10 @@ void CServer::DoSnapshot()
 			continue;
 
 		{
-			char aData[CSnapshot::MAX_SIZE];
-			CSnapshot *pData = (CSnapshot*)aData;	// Fix compiler warning for strict-aliasing
-			char aDeltaData[CSnapshot::MAX_SIZE];
-			char aCompData[CSnapshot::MAX_SIZE];
+			CSnapJob *pJob = &m_pSnapJobs[i];
+			CSnapshot *pData = (CSnapshot*)pJob->m_aData;	// Fix compiler warning for strict-aliasing
 			int SnapshotSize;
-			int Crc;
-			static CSnapshot EmptySnap;
-			CSnapshot *pDeltashot = &EmptySnap;
 			int DeltashotSize;
-			int DeltaTick = -1;
-			int DeltaSize;
 
 			m_SnapshotBuilder.Init();
 
@@ -947,7 +1150,7 @@ void CServer::DoSnapshot()
 
 			// finish snapshot
 			SnapshotSize = m_SnapshotBuilder.Finish(pData);
-			Crc = pData->Crc();
+			pJob->m_Crc = pData->Crc();
 
 			// remove old snapshos
 			// keep 3 seconds worth of snapshots
@@ -957,12 +1160,13 @@ void CServer::DoSnapshot()
 			m_aClients[i].m_Snapshots.Add(m_CurrentGameTick, time_get(), SnapshotSize, pData, 0);
 
 			// find snapshot that we can preform delta against
-			EmptySnap.Clear();
+			pJob->m_pDeltashot = &EmptySnap;
+			pJob->m_DeltaTick = -1;
 
 			{
-				DeltashotSize = m_aClients[i].m_Snapshots.Get(m_aClients[i].m_LastAckedSnapshot, 0, &pDeltashot, 0);
+				DeltashotSize = m_aClients[i].m_Snapshots.Get(m_aClients[i].m_LastAckedSnapshot, 0, &pJob->m_pDeltashot, 0);
 				if(DeltashotSize >= 0)
-					DeltaTick = m_aClients[i].m_LastAckedSnapshot;
+					pJob->m_DeltaTick = m_aClients[i].m_LastAckedSnapshot;
 				else
 				{
 					// no acked package found, force client to recover rate
@@ -971,58 +1175,32 @@ void CServer::DoSnapshot()
 				}
 			}
 
-			// create delta
-			DeltaSize = m_SnapshotDelta.CreateDelta(pDeltashot, pData, aDeltaData);
-
-			if(DeltaSize)
+			if(Threaded)
 			{
-				// compress it
-				int SnapshotSize;
-				const int MaxSize = MAX_SNAPSHOT_PACKSIZE;
-				int NumPackets;
-
-				SnapshotSize = CVariableInt::Compress(aDeltaData, DeltaSize, aCompData);
-				NumPackets = (SnapshotSize+MaxSize-1)/MaxSize;
-
-				for(int n = 0, Left = SnapshotSize; Left; n++)
-				{
-					int Chunk = Left < MaxSize ? Left : MaxSize;
-					Left -= Chunk;
-
-					if(NumPackets == 1)
-					{
-						CMsgPacker Msg(NETMSG_SNAPSINGLE);
-						Msg.AddInt(m_CurrentGameTick);
-						Msg.AddInt(m_CurrentGameTick-DeltaTick);
-						Msg.AddInt(Crc);
-						Msg.AddInt(Chunk);
-						Msg.AddRaw(&aCompData[n*MaxSize], Chunk);
-						SendMsgEx(&Msg, MSGFLAG_FLUSH, i, true);
-					}
-					else
-					{
-						CMsgPacker Msg(NETMSG_SNAP);
-						Msg.AddInt(m_CurrentGameTick);
-						Msg.AddInt(m_CurrentGameTick-DeltaTick);
-						Msg.AddInt(NumPackets);
-						Msg.AddInt(n);
-						Msg.AddInt(Crc);
-						Msg.AddInt(Chunk);
-						Msg.AddRaw(&aCompData[n*MaxSize], Chunk);
-						SendMsgEx(&Msg, MSGFLAG_FLUSH, i, true);
-					}
-				}
+				// delta and compression run on the workers while the next client is snapped
+				lock_wait(m_SnapJobLock);
+				m_aSnapJobQueue[m_NumSnapJobs++] = i;
+				lock_release(m_SnapJobLock);
+				semaphore_signal(&m_SnapJobSem);
 			}
 			else
 			{
-				CMsgPacker Msg(NETMSG_SNAPEMPTY);
-				Msg.AddInt(m_CurrentGameTick);
-				Msg.AddInt(m_CurrentGameTick-DeltaTick);
-				SendMsgEx(&Msg, MSGFLAG_FLUSH, i, true);
+				ProcessSnapJob(pJob);
+				SendSnapJob(i, pJob);
 			}
 		}
 	}
 
+	if(Threaded)
+	{
+		for(int i = 0; i < m_NumSnapJobs; i++)
+			semaphore_wait(&m_SnapDoneSem);
+
+		// send in client order on the main thread, the network code isn't thread safe
+		for(int i = 0; i < m_NumSnapJobs; i++)
+			SendSnapJob(m_aSnapJobQueue[i], &m_pSnapJobs[m_aSnapJobQueue[i]]);
+	}
+
 	GameServer()->OnPostSnap();
 }
 
@@ -1063,6 +1241,7 @@ int CServer::NewClientCallback(int ClientID, void *pUser)
 {
 	CServer *pThis = (CServer *)pUser;
 	pThis->m_aClients[ClientID].m_State = CClient::STATE_AUTH;
+	pThis->ExpireServerInfo();
 	pThis->m_aClients[ClientID].m_aName[0] = 0;
 	pThis->m_aClients[ClientID].m_aClan[0] = 0;
 	pThis->m_aClients[ClientID].m_Country = -1;
@@ -1122,6 +1301,7 @@ int CServer::DelClientCallback(int ClientID, int Type, const char *pReason, void
 		pThis->GameServer()->OnClientDrop(ClientID, Type, pReason);
 
 	pThis->m_aClients[ClientID].m_State = CClient::STATE_EMPTY;
+	pThis->ExpireServerInfo();
 	pThis->m_aClients[ClientID].m_aName[0] = 0;
 	pThis->m_aClients[ClientID].m_aClan[0] = 0;
 	pThis->m_aClients[ClientID].m_Country = -1;
@@ -1383,6 +1563,7 @@ void CServer::ProcessClientPacket(CNetChunk *pPacket)
 				str_format(aBuf, sizeof(aBuf), "player has entered the game. ClientID=%x addr=%s", ClientID, aAddrStr);
 				Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "server", aBuf);
 				m_aClients[ClientID].m_State = CClient::STATE_INGAME;
+				ExpireServerInfo();
 				
 				if(m_aClients[ClientID].m_WaitingTime <= 0)
 				{
@@ -1633,9 +1814,8 @@ void CServer::SendServerInfoConnless(const NETADDR *pAddr, int Token, bool Exten
 	}
 }
 
-void CServer::SendServerInfo(const NETADDR *pAddr, int Token, bool Extended, bool SendClients, int Offset)
+void CServer::BuildServerInfo(CServerInfoPacket *pInfo, const NETADDR *pAddr, bool Extended, bool SendClients, int Offset)
 {
-	CNetChunk Packet;
 	CPacker p;
 	char aBuf[256];
 
@@ -1654,12 +1834,10 @@ void CServer::SendServerInfo(const NETADDR *pAddr, int Token, bool Extended, boo
 
 	p.Reset();
 
-	p.AddRaw(Extended?SERVERBROWSE_INFO64:SERVERBROWSE_INFO, sizeof(Extended?SERVERBROWSE_INFO64:SERVERBROWSE_INFO));
-	str_format(aBuf, sizeof(aBuf), "%d", Token);
-	p.AddString(aBuf, 6);
-
 	p.AddString(GameServer()->Version(), 32);
 	
+	str_copy(aBuf, g_Config.m_SvName, sizeof(aBuf));
+	
 	//Add captcha if needed
 	if(g_Config.m_InfCaptcha)
 	{
@@ -1707,8 +1885,6 @@ void CServer::SendServerInfo(const NETADDR *pAddr, int Token, bool Extended, boo
 			}
 			lock_release(m_ChallengeLock);
 		}
-#else
-		memcpy(aBuf, g_Config.m_SvName, sizeof(aBuf));
 #endif
 	}
 	
@@ -1752,7 +1928,7 @@ void CServer::SendServerInfo(const NETADDR *pAddr, int Token, bool Extended, boo
 	if (Extended)
 		p.AddInt(Offset);
 
-	int ClientsPerPacket = Extended ? 24 : VANILLA_MAX_CLIENTS;
+	int ClientsPerPacket = Extended ? (int)SERVERINFO_CLIENTS_PER_PACKET : VANILLA_MAX_CLIENTS;
 	int Skip = Offset;
 	int Take = ClientsPerPacket;
 
@@ -1776,6 +1952,67 @@ void CServer::SendServerInfo(const NETADDR *pAddr, int Token, bool Extended, boo
 		}
 	}
 
+	mem_copy(pInfo->m_aData, p.Data(), p.Size());
+	pInfo->m_DataSize = p.Size();
+	pInfo->m_MorePages = Extended && Take < 0;
+}
+
+void CServer::RebuildServerInfoCache()
+{
+	BuildServerInfo(&m_aServerInfoCache[0], 0, false, true, 0);
+	
+	for(int Page = 0; Page < SERVERINFO_MAX_PAGES; Page++)
+	{
+		BuildServerInfo(&m_aServerInfoCache[1+Page], 0, true, true, Page*SERVERINFO_CLIENTS_PER_PACKET);
+		if(!m_aServerInfoCache[1+Page].m_MorePages)
+			break;
+	}
+}
+
+void CServer::ExpireServerInfo()
+{
+	// also called by the sql jobs, the cache is only rebuilt by the main thread
+	atomic_compswap(&m_ServerInfoDirty, 0, 1);
+}
+
+void CServer::SendServerInfo(const NETADDR *pAddr, int Token, bool Extended, bool SendClients, int Offset)
+{
+	CNetChunk Packet;
+	CPacker p;
+	char aBuf[16];
+	
+	const CServerInfoPacket *pInfo;
+	CServerInfoPacket Info;
+	
+	// the captcha is part of the name and differs for each address, it can't be cached
+	if(SendClients && !g_Config.m_InfCaptcha)
+	{
+		if(RoundStatistics()->m_ScoresChanged)
+		{
+			RoundStatistics()->m_ScoresChanged = false;
+			ExpireServerInfo();
+		}
+		// cleared before the rebuild, an expiry during it is not lost
+		if(atomic_compswap(&m_ServerInfoDirty, 1, 0))
+			RebuildServerInfoCache();
+		
+		pInfo = Extended ? &m_aServerInfoCache[1+Offset/SERVERINFO_CLIENTS_PER_PACKET] : &m_aServerInfoCache[0];
+	}
+	else
+	{
+		BuildServerInfo(&Info, pAddr, Extended, SendClients, Offset);
+		pInfo = &Info;
+	}
+
+	p.Reset();
+	if(Extended)
+		p.AddRaw(SERVERBROWSE_INFO64, sizeof(SERVERBROWSE_INFO64));
+	else
+		p.AddRaw(SERVERBROWSE_INFO, sizeof(SERVERBROWSE_INFO));
+	str_format(aBuf, sizeof(aBuf), "%d", Token);
+	p.AddString(aBuf, 6);
+	p.AddRaw(pInfo->m_aData, pInfo->m_DataSize);
+
 	Packet.m_ClientID = -1;
 	Packet.m_Address = *pAddr;
 	Packet.m_Flags = NETSENDFLAG_CONNLESS;
@@ -1783,8 +2020,8 @@ void CServer::SendServerInfo(const NETADDR *pAddr, int Token, bool Extended, boo
 	Packet.m_pData = p.Data();
 	m_NetServer.Send(&Packet);
 
-	if (Extended && Take < 0)
-		SendServerInfo(pAddr, Token, Extended, SendClients, Offset + ClientsPerPacket);
+	if (pInfo->m_MorePages)
+		SendServerInfo(pAddr, Token, Extended, SendClients, Offset + SERVERINFO_CLIENTS_PER_PACKET);
 }
 
 void CServer::UpdateServerInfo()
@@ -1845,80 +2082,157 @@ char *CServer::GetMapName()
 	return pMapShortName;
 }
 
-int CServer::LoadMap(const char *pMapName)
+bool CServer::PrepareClientMap(const char *pMapName, IEngineMap *pMap, char *pClientMapName, int ClientMapNameSize, int *pTimeShiftUnit, IConsole *pConsole)
 {
-	//DATAFILE *df;
-	char aBuf[512];
-	str_format(aBuf, sizeof(aBuf), "maps/%s.map", pMapName);
+	//The generated map only depends on the server map and the converter,
+	//so it is cached under both keys and reused as long as they match
+	char aClientMapDir[256];
+	str_format(aClientMapDir, sizeof(aClientMapDir), "clientmaps/%s_%08x_v%d", pMapName, pMap->Crc(), (int)CMapConverter::VERSION);
+	str_format(pClientMapName, ClientMapNameSize, "%s/tw06-highres.map", aClientMapDir);
+
+	CMapConverter MapConverter(Storage(), pMap, pConsole);
+	if(!MapConverter.Load())
+		return false;
+
+	if(pTimeShiftUnit)
+		*pTimeShiftUnit = MapConverter.GetTimeShiftUnit();
+
+	IOHANDLE File = Storage()->OpenFile(pClientMapName, IOFLAG_READ, IStorage::TYPE_ALL);
+	if(File)
+	{
+		io_close(File);
+		if(pConsole)
+			pConsole->Print(IConsole::OUTPUT_LEVEL_ADDINFO, "server", "reusing the generated client map");
+		else
+			dbg_msg("server", "reusing the generated client map");
+		return true;
+	}
+
+	//The map must be converted
+	char aFullPath[512];
+	Storage()->GetCompletePath(IStorage::TYPE_SAVE, aClientMapDir, aFullPath, sizeof(aFullPath));
+	if(fs_makedir(aFullPath) != 0)
+	{
+		dbg_msg("infclass", "Can't create the directory '%s'", aClientMapDir);
+	}
+
+	//Write to a temporary file first, so an interrupted conversion is never reused
+	char aTmpName[256];
+	str_format(aTmpName, sizeof(aTmpName), "%s/tw06-highres.map.tmp", aClientMapDir);
+	if(!MapConverter.CreateMap(aTmpName))
+		return false;
+
+	if(!Storage()->RenameFile(aTmpName, pClientMapName, IStorage::TYPE_SAVE))
+	{
+		dbg_msg("infclass", "Can't rename '%s'", aTmpName);
+		return false;
+	}
+
+	return true;
+}
+
+bool CServer::PrepareMap(CMapPrepare *pPrepare)
+{
+	pPrepare->m_Success = false;
+	pPrepare->m_pMap->Unload();
+	if(pPrepare->m_pData)
+	{
+		mem_free(pPrepare->m_pData);
+		pPrepare->m_pData = 0;
+	}
 
-	/*df = datafile_load(buf);
-	if(!df)
-		return 0;*/
+	char aBuf[512];
+	str_format(aBuf, sizeof(aBuf), "maps/%s.map", pPrepare->m_aMapName);
 
 	// check for valid standard map
 	if(!m_MapChecker.ReadAndValidateMap(Storage(), aBuf, IStorage::TYPE_ALL))
 	{
-		Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "mapchecker", "invalid standard map");
-		return 0;
+		dbg_msg("mapchecker", "invalid standard map");
+		return false;
 	}
 
-	if(!m_pMap->Load(aBuf))
-		return 0;
-			
+	if(!pPrepare->m_pMap->Load(Storage(), aBuf))
+		return false;
+
 /* INFECTION MODIFICATION START ***************************************/
 	//The map format of InfectionClass is different from the vanilla format.
 	//We need to convert the map to something that the client can use
-	//First, try to find if the client map is already generated
+	char aClientMapName[256];
+	if(!PrepareClientMap(pPrepare->m_aMapName, pPrepare->m_pMap, aClientMapName, sizeof(aClientMapName), &pPrepare->m_TimeShiftUnit, 0))
+		return false;
+
+	//Download the generated map in memory to send it to clients
+	IOHANDLE File = Storage()->OpenFile(aClientMapName, IOFLAG_READ, IStorage::TYPE_ALL);
+	if(!File)
+		return false;
+	pPrepare->m_DataSize = (unsigned int)io_length(File);
+	pPrepare->m_pData = (unsigned char *)mem_alloc(pPrepare->m_DataSize, 1);
+	io_read(File, pPrepare->m_pData, pPrepare->m_DataSize);
+	io_close(File);
+	pPrepare->m_Crc = crc32(0, pPrepare->m_pData, pPrepare->m_DataSize);
+/* INFECTION MODIFICATION END *****************************************/
+
+	pPrepare->m_Success = true;
+	return true;
+}
+
+void CServer::MapPrepareThread(void *pUser)
+{
+	CServer *pThis = (CServer *)pUser;
+	pThis->PrepareMap(&pThis->m_MapPrepare);
+
+	// publish the result only once it is complete
+	sync_barrier();
+	pThis->m_MapPrepareState = MAPPREPARE_DONE;
+}
+
+void CServer::StartMapPrepare(const char *pMapName)
+{
+	str_copy(m_MapPrepare.m_aMapName, pMapName, sizeof(m_MapPrepare.m_aMapName));
+	m_MapPrepareState = MAPPREPARE_RUNNING;
+
+	if(g_Config.m_SvAsyncMapLoad)
 	{
-		CDataFileReader dfServerMap;
-		dfServerMap.Open(Storage(), aBuf, IStorage::TYPE_ALL);
-		unsigned ServerMapCrc = dfServerMap.Crc();
-		dfServerMap.Close();
-		
-		char aClientMapName[256];
-		str_format(aClientMapName, sizeof(aClientMapName), "clientmaps/%s_%08x/tw06-highres.map", pMapName, ServerMapCrc);
-		
-		CMapConverter MapConverter(Storage(), m_pMap, Console());
-		if(!MapConverter.Load())
-			return 0;
-		
-		m_TimeShiftUnit = MapConverter.GetTimeShiftUnit();
-		
-		CDataFileReader dfClientMap;
-		//The map must be converted
-		
-		char aClientMapDir[256];
-		str_format(aClientMapDir, sizeof(aClientMapDir), "clientmaps/%s_%08x", pMapName, ServerMapCrc);
-			
-		char aFullPath[512];
-		Storage()->GetCompletePath(IStorage::TYPE_SAVE, aClientMapDir, aFullPath, sizeof(aFullPath));
-		if(fs_makedir(aFullPath) != 0)
+		void *pThread = thread_init(MapPrepareThread, this);
+		if(pThread)
 		{
-			dbg_msg("infclass", "Can't create the directory '%s'", aClientMapDir);
+			thread_detach(pThread);
+			return;
 		}
-				
-		if(!MapConverter.CreateMap(aClientMapName))
-			return 0;
-			
-		CDataFileReader dfGeneratedMap;
-		dfGeneratedMap.Open(Storage(), aClientMapName, IStorage::TYPE_ALL);
-		m_CurrentMapCrc = dfGeneratedMap.Crc();
-		dfGeneratedMap.Close();
-		
-	
+	}
+
+	MapPrepareThread(this);
+}
+
+int CServer::LoadMap(const char *pMapName)
+{
+	str_copy(m_MapPrepare.m_aMapName, pMapName, sizeof(m_MapPrepare.m_aMapName));
+	if(!PrepareMap(&m_MapPrepare))
+		return 0;
+
+	SwapInMap(&m_MapPrepare);
+	return 1;
+}
+
+void CServer::SwapInMap(CMapPrepare *pPrepare)
+{
+	const char *pMapName = pPrepare->m_aMapName;
+
+	m_pMap->Swap(pPrepare->m_pMap);
+	pPrepare->m_pMap->Unload();
+
+	if(m_pCurrentMapData)
+		mem_free(m_pCurrentMapData);
+	m_pCurrentMapData = pPrepare->m_pData;
+	m_CurrentMapSize = pPrepare->m_DataSize;
+	m_CurrentMapCrc = pPrepare->m_Crc;
+	m_TimeShiftUnit = pPrepare->m_TimeShiftUnit;
+	pPrepare->m_pData = 0;
+
+	{
 		char aBufMsg[128];
-		str_format(aBufMsg, sizeof(aBufMsg), "map crc is %08x, generated map crc is %08x", ServerMapCrc, m_CurrentMapCrc);
+		str_format(aBufMsg, sizeof(aBufMsg), "map crc is %08x, generated map crc is %08x", m_pMap->Crc(), m_CurrentMapCrc);
 		Console()->Print(IConsole::OUTPUT_LEVEL_ADDINFO, "server", aBufMsg);
-		
-		//Download the generated map in memory to send it to clients
-		IOHANDLE File = Storage()->OpenFile(aClientMapName, IOFLAG_READ, IStorage::TYPE_ALL);
-		m_CurrentMapSize = (int)io_length(File);
-		if(m_pCurrentMapData)
-			mem_free(m_pCurrentMapData);
-		m_pCurrentMapData = (unsigned char *)mem_alloc(m_CurrentMapSize, 1);
-		io_read(File, m_pCurrentMapData, m_CurrentMapSize);
-		io_close(File);
-		Console()->Print(IConsole::OUTPUT_LEVEL_ADDINFO, "server", "maps/infc_x_current.map loaded in memory");
 	}
 
 	// stop recording when we change map
@@ -1929,10 +2243,16 @@ int CServer::LoadMap(const char *pMapName)
 
 	str_copy(m_aCurrentMap, pMapName, sizeof(m_aCurrentMap));
 	ResetMapVotes();
+	ExpireServerInfo();
+
+#ifdef CONF_SQL
+	// have the rankings of the new map ready before someone asks for them
+	LoadLeaderboard();
+#endif
 
 	//map_set(df);
 	
-	
+/* INFECTION MODIFICATION START ***************************************/
 	{
 		g_Config.m_SvTimelimit = 5;
 		
@@ -1978,8 +2298,6 @@ int CServer::LoadMap(const char *pMapName)
 			g_Config.m_SvTimelimit = 5;
 	}
 /* INFECTION MODIFICATION END *****************************************/
-	
-	return 1;
 }
 
 int CServer::GetMinPlayersForMap(const char* pMapName)
@@ -2181,13 +2499,24 @@ int CServer::Run()
 #endif
 
 			// load new map TODO: don't poll this
-			if(str_comp(g_Config.m_SvMap, m_aCurrentMap) != 0 || m_MapReload)
+			if(m_MapPrepareState == MAPPREPARE_IDLE && (str_comp(g_Config.m_SvMap, m_aCurrentMap) != 0 || m_MapReload))
 			{
 				m_MapReload = 0;
 
-				// load map
-				if(LoadMap(g_Config.m_SvMap))
+				// the current map keeps running until the new one is ready
+				StartMapPrepare(g_Config.m_SvMap);
+			}
+
+			if(m_MapPrepareState == MAPPREPARE_DONE)
+			{
+				sync_barrier();
+				m_MapPrepareState = MAPPREPARE_IDLE;
+
+				// if sv_map changed while preparing, the result is dropped and the next pass starts over
+				if(m_MapPrepare.m_Success && str_comp(m_MapPrepare.m_aMapName, g_Config.m_SvMap) == 0)
 				{
+					SwapInMap(&m_MapPrepare);
+
 					// new map loaded
 					GameServer()->OnShutdown();
 
@@ -2210,11 +2539,12 @@ int CServer::Run()
 					GameServer()->OnInit();
 					UpdateServerInfo();
 				}
-				else
+				else if(!m_MapPrepare.m_Success)
 				{
-					str_format(aBuf, sizeof(aBuf), "failed to load map. mapname='%s'", g_Config.m_SvMap);
+					str_format(aBuf, sizeof(aBuf), "failed to load map. mapname='%s'", m_MapPrepare.m_aMapName);
 					Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "server", aBuf);
-					str_copy(g_Config.m_SvMap, m_aCurrentMap, sizeof(g_Config.m_SvMap));
+					if(str_comp(m_MapPrepare.m_aMapName, g_Config.m_SvMap) == 0)
+						str_copy(g_Config.m_SvMap, m_aCurrentMap, sizeof(g_Config.m_SvMap));
 				}
 			}
 
@@ -2284,17 +2614,7 @@ int CServer::Run()
 				GameServer()->OnTick();
 				
 #ifdef CONF_SQL
-				if(m_lGameServerCmds.size())
-				{
-					lock_wait(m_GameServerCmdLock);
-					for(int i=0; i<m_lGameServerCmds.size(); i++)
-					{
-						m_lGameServerCmds[i]->Execute(GameServer());
-						delete m_lGameServerCmds[i];
-					}
-					m_lGameServerCmds.clear();
-					lock_release(m_GameServerCmdLock);
-				} 
+				m_GameServerCmds.Drain(GameServer(), time_freq()*g_Config.m_SvSqlResultBudget/1000000);
 #endif
 			}
 
@@ -2329,6 +2649,10 @@ int CServer::Run()
 		m_Econ.Shutdown();
 	}
 
+	// the map prepare thread uses the server, let it finish first
+	while(m_MapPrepareState == MAPPREPARE_RUNNING)
+		thread_sleep(10);
+
 	GameServer()->OnShutdown();
 	m_pMap->Unload();
 
@@ -2337,6 +2661,9 @@ int CServer::Run()
 		
 /* DDNET MODIFICATION START *******************************************/
 #ifdef CONF_SQL
+	// the sql workers copy the servers, stop them first
+	CSqlJobPool::Shutdown();
+
 	for (int i = 0; i < MAX_SQLSERVERS; i++)
 	{
 		if (m_apSqlReadServers[i])
@@ -2623,7 +2950,10 @@ bool CServer::ConchainSpecialInfoupdate(IConsole::IResult *pResult, void *pUserD
 {
 	pfnCallback(pResult, pCallbackUserData);
 	if(pResult->NumArguments())
+	{
+		((CServer *)pUserData)->ExpireServerInfo();
 		((CServer *)pUserData)->UpdateServerInfo();
+	}
 	
 	return true;
 }
@@ -2755,35 +3085,104 @@ bool CServer::ConDumpSqlServers(IConsole::IResult *pResult, void *pUserData)
 	return true;
 }
 
-void CServer::CreateTablesThread(void *pData)
+bool CServer::ConSqlPoolStats(IConsole::IResult *pResult, void *pUserData)
 {
-	((CSqlServer *)pData)->CreateTables();
-}
-#endif
+	CServer *pSelf = (CServer *)pUserData;
 
-/* DDNET MODIFICATION END *********************************************/
+	if(pResult->NumArguments() && str_comp_nocase(pResult->GetString(0), "reset") == 0)
+	{
+		CSqlJobPool::ResetStats();
+		pSelf->m_GameServerCmds.ResetStats();
+		pSelf->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "server", "sql job statistics reset");
+		return true;
+	}
 
-void CServer::RegisterCommands()
-{
-	m_pConsole = Kernel()->RequestInterface<IConsole>();
-	m_pGameServer = Kernel()->RequestInterface<IGameServer>();
-	m_pMap = Kernel()->RequestInterface<IEngineMap>();
-	m_pStorage = Kernel()->RequestInterface<IStorage>();
+	CSqlJobPool::CStats Stats;
+	CSqlJobPool::GetStats(&Stats);
 
-	// register console commands
-	Console()->Register("kick", "s<username or uid> ?r<reason>", CFGFLAG_SERVER, ConKick, this, "Kick player with specified id for any reason");
-	Console()->Register("status", "", CFGFLAG_SERVER, ConStatus, this, "List players");
-	Console()->Register("option_status", "", CFGFLAG_SERVER, ConOptionStatus, this, "List player options");
-	Console()->Register("shutdown", "", CFGFLAG_SERVER, ConShutdown, this, "Shut down");
-	Console()->Register("logout", "", CFGFLAG_SERVER, ConLogout, this, "Logout of rcon");
+	static const char *s_apPriorities[CSqlJob::NUM_PRIORITIES] = { "high", "normal", "low" };
 
-	Console()->Register("record", "?s", CFGFLAG_SERVER|CFGFLAG_STORE, ConRecord, this, "Record to a file");
+	char aBuf[256];
+	str_format(aBuf, sizeof(aBuf), "sql workers: %d", Stats.m_NumWorkers);
+	pSelf->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "server", aBuf);
+
+	int64 Freq = time_freq();
+	for(int p = 0; p < CSqlJob::NUM_PRIORITIES; p++)
+	{
+		int64 NumJobs = max(Stats.m_aNumJobs[p], (int64)1);
+		str_format(aBuf, sizeof(aBuf), "%s: queued=%d done=%lld dropped=%lld wait avg=%.2fms max=%.2fms exec avg=%.2fms max=%.2fms",
+			s_apPriorities[p], Stats.m_aQueued[p], Stats.m_aNumJobs[p], Stats.m_aNumDropped[p],
+			Stats.m_aWaitTime[p]*1000.0/NumJobs/Freq, Stats.m_aMaxWaitTime[p]*1000.0/Freq,
+			Stats.m_aExecTime[p]*1000.0/NumJobs/Freq, Stats.m_aMaxExecTime[p]*1000.0/Freq);
+		pSelf->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "server", aBuf);
+	}
+
+	CGameServerCmdQueue::CStats QueueStats;
+	pSelf->m_GameServerCmds.GetStats(&QueueStats);
+	str_format(aBuf, sizeof(aBuf), "results: queued=%d max=%d executed=%lld dropped=%lld deferred=%lld drain last=%.3fms max=%.3fms",
+		QueueStats.m_Depth, QueueStats.m_MaxDepth, QueueStats.m_NumExecuted, QueueStats.m_NumDropped, QueueStats.m_NumDeferred,
+		QueueStats.m_LastDrainTime*1000.0/Freq, QueueStats.m_MaxDrainTime*1000.0/Freq);
+	pSelf->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "server", aBuf);
+
+	return true;
+}
+
+bool CServer::ConLeaderboardInvalidate(IConsole::IResult *pResult, void *pUserData)
+{
+	CServer *pSelf = (CServer *)pUserData;
+
+	pSelf->m_LeaderboardCache.Invalidate();
+	pSelf->LoadLeaderboard();
+	pSelf->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "server", "leaderboard cache cleared, reloading the current map");
+
+	return true;
+}
+
+bool CServer::ConLeaderboardStats(IConsole::IResult *pResult, void *pUserData)
+{
+	CServer *pSelf = (CServer *)pUserData;
+
+	CLeaderboardCache::CStats Stats;
+	pSelf->m_LeaderboardCache.GetStats(&Stats);
+
+	char aBuf[256];
+	str_format(aBuf, sizeof(aBuf), "leaderboard cache: maps=%d boards=%d players=%d hits=%lld misses=%lld loads=%lld updates=%lld",
+		Stats.m_NumMaps, Stats.m_NumBoards, Stats.m_NumEntries, Stats.m_Hits, Stats.m_Misses, Stats.m_Loads, Stats.m_Updates);
+	pSelf->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "server", aBuf);
+
+	return true;
+}
+
+void CServer::CreateTablesThread(void *pData)
+{
+	((CSqlServer *)pData)->CreateTables();
+}
+#endif
+
+/* DDNET MODIFICATION END *********************************************/
+
+void CServer::RegisterCommands()
+{
+	m_pConsole = Kernel()->RequestInterface<IConsole>();
+	m_pGameServer = Kernel()->RequestInterface<IGameServer>();
+	m_pMap = Kernel()->RequestInterface<IEngineMap>();
+	m_pStorage = Kernel()->RequestInterface<IStorage>();
+
+	// register console commands
+	Console()->Register("kick", "s<username or uid> ?r<reason>", CFGFLAG_SERVER, ConKick, this, "Kick player with specified id for any reason");
+	Console()->Register("status", "", CFGFLAG_SERVER, ConStatus, this, "List players");
+	Console()->Register("option_status", "", CFGFLAG_SERVER, ConOptionStatus, this, "List player options");
+	Console()->Register("shutdown", "", CFGFLAG_SERVER, ConShutdown, this, "Shut down");
+	Console()->Register("logout", "", CFGFLAG_SERVER, ConLogout, this, "Logout of rcon");
+
+	Console()->Register("record", "?s", CFGFLAG_SERVER|CFGFLAG_STORE, ConRecord, this, "Record to a file");
 	Console()->Register("stoprecord", "", CFGFLAG_SERVER, ConStopRecord, this, "Stop recording");
 
 	Console()->Register("reload", "", CFGFLAG_SERVER, ConMapReload, this, "Reload the map");
 
 	Console()->Chain("sv_name", ConchainSpecialInfoupdate, this);
 	Console()->Chain("password", ConchainSpecialInfoupdate, this);
+	Console()->Chain("sv_spectator_slots", ConchainSpecialInfoupdate, this);
 
 	Console()->Chain("sv_max_clients_per_ip", ConchainMaxclientsperipUpdate, this);
 	Console()->Chain("mod_command", ConchainModCommandUpdate, this);
@@ -2797,8 +3196,13 @@ void CServer::RegisterCommands()
 #ifdef CONF_SQL
 	Console()->Register("inf_add_sqlserver", "ssssssi?i", CFGFLAG_SERVER, ConAddSqlServer, this, "add a sqlserver");
 	Console()->Register("inf_list_sqlservers", "s", CFGFLAG_SERVER, ConDumpSqlServers, this, "list all sqlservers readservers = r, writeservers = w");
+	Console()->Register("inf_leaderboard_invalidate", "", CFGFLAG_SERVER, ConLeaderboardInvalidate, this, "drop the cached rankings and reload them from the database");
+	Console()->Register("inf_leaderboard_stats", "", CFGFLAG_SERVER, ConLeaderboardStats, this, "prints the size and hit rate of the cached rankings");
+	Console()->Register("sql_pool_stats", "?s<reset>", CFGFLAG_SERVER, ConSqlPoolStats, this, "prints the queue depth and latency of the sql jobs per priority and of their results");
 #endif
 	Console()->Register("print_idcount", "", CFGFLAG_SERVER, ConGetIDCount, this, "prints how many entity ids are currently used - useful for debugging");
+	Console()->Register("generate_client_maps", "?r<maps>", CFGFLAG_SERVER, ConGenerateClientMaps, this, "generate the client maps of the given maps (default: sv_maprotation) if they are not cached yet");
+	Console()->Register("snapshot_storage_stats", "", CFGFLAG_SERVER, ConSnapshotStorageStats, this, "prints the snapshot memory retained per client");
 /* INFECTION MODIFICATION END *****************************************/
 
 	// register console commands in sub parts
@@ -2824,7 +3228,12 @@ void *CServer::SnapNewItem(int Type, int ID, int Size)
 {
 	dbg_assert(Type >= 0 && Type <=0xffff, "incorrect type");
 	dbg_assert(ID >= 0 && ID <=0xffff, "incorrect id");
-	return ID < 0 ? 0 : m_SnapshotBuilder.NewItem(Type, ID, Size);
+	return ID < 0 ? 0 : m_pSnapTarget->NewItem(Type, ID, Size);
+}
+
+void CServer::SnapSetBuilder(CSnapshotBuilder *pBuilder)
+{
+	m_pSnapTarget = pBuilder ? pBuilder : &m_SnapshotBuilder;
 }
 
 void CServer::SnapSetStaticsize(int ItemType, int Size)
@@ -2928,6 +3337,8 @@ int main(int argc, const char **argv) // ignore_convention
 	delete pEngineMasterServer;
 	delete pStorage;
 	delete pConfig;
+
+	dbg_logger_async_stop();
 	return 0;
 }
 
@@ -3071,71 +3482,143 @@ bool CServer::IsClientLogged(int ClientID)
 }
 
 #ifdef CONF_SQL
-void CServer::AddGameServerCmd(CGameServerCmd* pCmd)
+void CServer::CGameServerCmd::Execute(IGameServer* pGameServer)
 {
-	lock_wait(m_GameServerCmdLock);
-	m_lGameServerCmds.add(pCmd);
-	lock_release(m_GameServerCmdLock);
+	switch(m_Type)
+	{
+		case SEND_CHAT_TARGET:
+			pGameServer->SendChatTarget(m_ClientID, m_aText);
+			break;
+		case SEND_CHAT_TARGET_LANGUAGE:
+			pGameServer->SendChatTarget_Localization(m_ClientID, m_ChatCategory, m_aText, NULL);
+			break;
+		case SEND_MOTD:
+			pGameServer->SendMOTD(m_ClientID, m_aText);
+			break;
+	}
 }
 
-class CGameServerCmd_SendChatMOTD : public CServer::CGameServerCmd
+CServer::CGameServerCmdQueue::CGameServerCmdQueue()
 {
-private:
-	int m_ClientID;
-	char m_aText[512];
-	
-public:
-	CGameServerCmd_SendChatMOTD(int ClientID, const char* pText)
-	{
-		m_ClientID = ClientID;
-		str_copy(m_aText, pText, sizeof(m_aText));
-	}
+	for(unsigned i = 0; i < SIZE; i++)
+		m_aSlots[i].m_Sequence = i;
+	m_EnqueuePos = 0;
+	m_DequeuePos = 0;
+	m_NumDropped = 0;
+	ResetStats();
+}
 
-	virtual void Execute(IGameServer* pGameServer)
+bool CServer::CGameServerCmdQueue::Push(int Type, int ClientID, int ChatCategory, const char* pText)
+{
+	// a slot is free for position Pos when its sequence is Pos, and holds a command when it is Pos+1
+	CSlot *pSlot;
+	unsigned Pos = m_EnqueuePos;
+	while(1)
 	{
-		pGameServer->SendMOTD(m_ClientID, m_aText);
+		pSlot = &m_aSlots[Pos&(SIZE-1)];
+		unsigned Sequence = pSlot->m_Sequence;
+		sync_barrier();
+		int Diff = (int)(Sequence - Pos);
+		if(Diff == 0)
+		{
+			unsigned Prev = atomic_compswap(&m_EnqueuePos, Pos, Pos+1);
+			if(Prev == Pos)
+				break;
+			Pos = Prev;
+		}
+		else if(Diff < 0)
+		{
+			atomic_inc(&m_NumDropped);
+			return false;
+		}
+		else
+			Pos = m_EnqueuePos;
 	}
-};
 
-class CGameServerCmd_SendChatTarget : public CServer::CGameServerCmd
+	pSlot->m_Cmd.m_Type = Type;
+	pSlot->m_Cmd.m_ClientID = ClientID;
+	pSlot->m_Cmd.m_ChatCategory = ChatCategory;
+	str_copy(pSlot->m_Cmd.m_aText, pText, sizeof(pSlot->m_Cmd.m_aText));
+	sync_barrier();
+	pSlot->m_Sequence = Pos+1;
+	return true;
+}
+
+void CServer::CGameServerCmdQueue::Drain(IGameServer* pGameServer, int64 Budget)
 {
-private:
-	int m_ClientID;
-	char m_aText[128];
-	
-public:
-	CGameServerCmd_SendChatTarget(int ClientID, const char* pText)
-	{
-		m_ClientID = ClientID;
-		str_copy(m_aText, pText, sizeof(m_aText));
-	}
+	int64 Start = time_get();
+	unsigned Depth = m_EnqueuePos - m_DequeuePos;
+	if(Depth > m_MaxDepth)
+		m_MaxDepth = Depth;
 
-	virtual void Execute(IGameServer* pGameServer)
+	int NumExecuted = 0;
+	while(1)
 	{
-		pGameServer->SendChatTarget(m_ClientID, m_aText);
+		CSlot *pSlot = &m_aSlots[m_DequeuePos&(SIZE-1)];
+		unsigned Sequence = pSlot->m_Sequence;
+		sync_barrier();
+		if((int)(Sequence - (m_DequeuePos+1)) < 0)
+			break;
+
+		// at least one command per tick, then stop once the budget is used
+		if(NumExecuted > 0 && time_get() - Start >= Budget)
+		{
+			m_NumDeferred++;
+			break;
+		}
+
+		pSlot->m_Cmd.Execute(pGameServer);
+		NumExecuted++;
+
+		sync_barrier();
+		pSlot->m_Sequence = m_DequeuePos + SIZE;
+		m_DequeuePos++;
 	}
-};
 
-class CGameServerCmd_SendChatTarget_Language : public CServer::CGameServerCmd
+	m_NumExecuted += NumExecuted;
+	m_LastDrainTime = time_get() - Start;
+	if(m_LastDrainTime > m_MaxDrainTime)
+		m_MaxDrainTime = m_LastDrainTime;
+}
+
+void CServer::CGameServerCmdQueue::GetStats(CStats* pStats)
 {
-private:
-	int m_ClientID;
-	int m_ChatCategory;
-	char m_aText[128];
-	
-public:
-	CGameServerCmd_SendChatTarget_Language(int ClientID, int ChatCategory, const char* pText)
-	{
-		m_ClientID = ClientID;
-		m_ChatCategory = ChatCategory;
-		str_copy(m_aText, pText, sizeof(m_aText));
-	}
+	pStats->m_Depth = m_EnqueuePos - m_DequeuePos;
+	pStats->m_MaxDepth = m_MaxDepth;
+	pStats->m_NumExecuted = m_NumExecuted;
+	pStats->m_NumDropped = m_NumDropped;
+	pStats->m_NumDeferred = m_NumDeferred;
+	pStats->m_LastDrainTime = m_LastDrainTime;
+	pStats->m_MaxDrainTime = m_MaxDrainTime;
+}
 
-	virtual void Execute(IGameServer* pGameServer)
-	{
-		pGameServer->SendChatTarget_Localization(m_ClientID, m_ChatCategory, m_aText, NULL);
-	}
-};
+void CServer::CGameServerCmdQueue::ResetStats()
+{
+	m_NumDropped = 0;
+	m_MaxDepth = 0;
+	m_NumExecuted = 0;
+	m_NumDeferred = 0;
+	m_LastDrainTime = 0;
+	m_MaxDrainTime = 0;
+}
+
+void CServer::AddChatTargetCmd(int ClientID, const char* pText)
+{
+	if(!m_GameServerCmds.Push(CGameServerCmd::SEND_CHAT_TARGET, ClientID, 0, pText))
+		dbg_msg("sql", "game server command queue is full, dropping a chat message");
+}
+
+void CServer::AddChatTargetLanguageCmd(int ClientID, int ChatCategory, const char* pText)
+{
+	if(!m_GameServerCmds.Push(CGameServerCmd::SEND_CHAT_TARGET_LANGUAGE, ClientID, ChatCategory, pText))
+		dbg_msg("sql", "game server command queue is full, dropping a chat message");
+}
+
+void CServer::AddMOTDCmd(int ClientID, const char* pText)
+{
+	if(!m_GameServerCmds.Push(CGameServerCmd::SEND_MOTD, ClientID, 0, pText))
+		dbg_msg("sql", "game server command queue is full, dropping a motd");
+}
 
 class CSqlJob_Server_Login : public CSqlJob
 {
@@ -3180,6 +3663,7 @@ public:
 					char aOldName[MAX_NAME_LENGTH];
 					str_copy(aOldName, m_pServer->m_aClients[m_ClientID].m_aName, sizeof(aOldName));
 					str_copy(m_pServer->m_aClients[m_ClientID].m_aUsername, m_sName.Str(), sizeof(m_pServer->m_aClients[m_ClientID].m_aUsername));
+					m_pServer->ExpireServerInfo();
 
 					char aBuf[256];
 					str_format(aBuf, sizeof(aBuf), "change_name previous='%s' now='%s'", aOldName, m_pServer->m_aClients[m_ClientID].m_aUsername);
@@ -3195,26 +3679,22 @@ public:
 					{
 						str_format(aBuf, sizeof(aBuf), "%s logged in (id: %d)", m_pServer->m_aClients[m_ClientID].m_aUsername,
 							m_pServer->m_aClients[m_ClientID].m_UserID);
-						CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget(-1, aBuf);
-						m_pServer->AddGameServerCmd(pCmd);
+						m_pServer->AddChatTargetCmd(-1, aBuf);
 					}
 				}
 				else {
 					str_format(aBuf, sizeof(aBuf), "You are already logged in.");
-					CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget(m_ClientID, aBuf);
-					m_pServer->AddGameServerCmd(pCmd);
+					m_pServer->AddChatTargetCmd(m_ClientID, aBuf);
 				}
 			}
 			else
 			{
-				CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget_Language(m_ClientID, CHATCATEGORY_DEFAULT, _("Wrong username/password."));
-				m_pServer->AddGameServerCmd(pCmd);
+				m_pServer->AddChatTargetLanguageCmd(m_ClientID, CHATCATEGORY_DEFAULT, _("Wrong username/password."));
 			}
 		}
 		catch (sql::SQLException &e)
 		{
-			CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget_Language(m_ClientID, CHATCATEGORY_DEFAULT, "An error occured during the logging.");
-			m_pServer->AddGameServerCmd(pCmd);
+			m_pServer->AddChatTargetLanguageCmd(m_ClientID, CHATCATEGORY_DEFAULT, "An error occured during the logging.");
 			dbg_msg("sql", "Can't check username/password (MySQL Error: %s)", e.what());
 			
 			return false;
@@ -3240,7 +3720,7 @@ void CServer::Login(int ClientID, const char* pUsername, const char* pPassword)
 	
 	CSqlJob* pJob = new CSqlJob_Server_Login(this, ClientID, pUsername, aHash);
 	m_aClients[ClientID].m_LogInstance = pJob->GetInstance();
-	pJob->Start();
+	pJob->Start(false, CSqlJob::PRIORITY_HIGH);
 }
 
 void CServer::Logout(int ClientID)
@@ -3250,6 +3730,7 @@ void CServer::Logout(int ClientID)
 	char aBuf[256];
 	str_format(aBuf, sizeof(aBuf), "change_name previous='%s' now='%s'", m_aClients[ClientID].m_aUsername, m_aClients[ClientID].m_aName);
 	Console()->Print(IConsole::OUTPUT_LEVEL_DEBUG, "game", aBuf);
+	ExpireServerInfo();
 }
 
 class CSqlJob_Server_SetEmail : public CSqlJob
@@ -3285,8 +3766,7 @@ public:
 		}
 		catch (sql::SQLException &e)
 		{
-			CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget_Language(m_ClientID, CHATCATEGORY_DEFAULT, _("An error occured during the operation."));
-			m_pServer->AddGameServerCmd(pCmd);
+			m_pServer->AddChatTargetLanguageCmd(m_ClientID, CHATCATEGORY_DEFAULT, _("An error occured during the operation."));
 			dbg_msg("sql", "Can't change email (MySQL Error: %s)", e.what());
 			
 			return false;
@@ -3305,7 +3785,7 @@ void CServer::SetEmail(int ClientID, const char* pEmail)
 	else
 	{
 		CSqlJob* pJob = new CSqlJob_Server_SetEmail(this, ClientID, m_aClients[ClientID].m_UserID, pEmail);
-		pJob->Start();
+		pJob->Start(false, CSqlJob::PRIORITY_HIGH);
 	}
 }
 
@@ -3354,16 +3834,14 @@ public:
 			if(pSqlServer->GetResults()->next())
 			{
 				dbg_msg("infclass", "Registration flooding");
-				CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget_Language(m_ClientID, CHATCATEGORY_DEFAULT, _("Please wait 5 minutes before creating another account"));
-				m_pServer->AddGameServerCmd(pCmd);
+				m_pServer->AddChatTargetLanguageCmd(m_ClientID, CHATCATEGORY_DEFAULT, _("Please wait 5 minutes before creating another account"));
 				
 				return true;
 			}
 		}
 		catch (sql::SQLException &e)
 		{
-			CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget_Language(m_ClientID, CHATCATEGORY_DEFAULT, _("An error occured during the creation of your account."));
-			m_pServer->AddGameServerCmd(pCmd);
+			m_pServer->AddChatTargetLanguageCmd(m_ClientID, CHATCATEGORY_DEFAULT, _("An error occured during the creation of your account."));
 			dbg_msg("sql", "Can't check username existance (MySQL Error: %s)", e.what());
 			
 			return false;
@@ -3381,16 +3859,14 @@ public:
 			if(pSqlServer->GetResults()->next())
 			{
 				dbg_msg("infclass", "User already taken");
-				CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget_Language(m_ClientID, CHATCATEGORY_DEFAULT, _("This username is already taken by an existing account"));
-				m_pServer->AddGameServerCmd(pCmd);
+				m_pServer->AddChatTargetLanguageCmd(m_ClientID, CHATCATEGORY_DEFAULT, _("This username is already taken by an existing account"));
 				
 				return true;
 			}
 		}
 		catch (sql::SQLException &e)
 		{
-			CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget_Language(m_ClientID, CHATCATEGORY_DEFAULT, _("An error occured during the creation of your account."));
-			m_pServer->AddGameServerCmd(pCmd);
+			m_pServer->AddChatTargetLanguageCmd(m_ClientID, CHATCATEGORY_DEFAULT, _("An error occured during the creation of your account."));
 			dbg_msg("sql", "Can't check username existance (MySQL Error: %s)", e.what());
 			
 			return false;
@@ -3408,8 +3884,7 @@ public:
 		}
 		catch (sql::SQLException &e)
 		{
-			CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget_Language(m_ClientID, CHATCATEGORY_DEFAULT, _("An error occured during the creation of your account."));
-			m_pServer->AddGameServerCmd(pCmd);
+			m_pServer->AddChatTargetLanguageCmd(m_ClientID, CHATCATEGORY_DEFAULT, _("An error occured during the creation of your account."));
 			dbg_msg("sql", "Can't create new user (MySQL Error: %s)", e.what());
 			
 			return false;
@@ -3426,8 +3901,7 @@ public:
 
 			if(pSqlServer->GetResults()->next())
 			{
-				CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget_Language(m_ClientID, CHATCATEGORY_DEFAULT, _("Your account has been created and you are now logged."));
-				m_pServer->AddGameServerCmd(pCmd);
+				m_pServer->AddChatTargetLanguageCmd(m_ClientID, CHATCATEGORY_DEFAULT, _("Your account has been created and you are now logged."));
 							
 				//The client is still the same
 				if(m_pServer->m_aClients[m_ClientID].m_LogInstance == GetInstance())
@@ -3435,6 +3909,7 @@ public:
 					int UserID = (int)pSqlServer->GetResults()->getInt("UserId");
 					m_pServer->m_aClients[m_ClientID].m_UserID = UserID;
 					str_copy(m_pServer->m_aClients[m_ClientID].m_aUsername, m_sName.Str(), sizeof(m_pServer->m_aClients[m_ClientID].m_aUsername));
+					m_pServer->ExpireServerInfo();
 					
 					//If we are really unlucky, the client can deconnect and another one connect during this small code
 					if(m_pServer->m_aClients[m_ClientID].m_LogInstance != GetInstance())
@@ -3447,16 +3922,14 @@ public:
 			}
 			else
 			{
-				CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget_Language(m_ClientID, CHATCATEGORY_DEFAULT, _("An error occured during the creation of your account."));
-				m_pServer->AddGameServerCmd(pCmd);
+				m_pServer->AddChatTargetLanguageCmd(m_ClientID, CHATCATEGORY_DEFAULT, _("An error occured during the creation of your account."));
 				
 				return false;
 			}
 		}
 		catch (sql::SQLException &e)
 		{
-			CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget_Language(m_ClientID, CHATCATEGORY_DEFAULT, _("An error occured during the creation of your account."));
-			m_pServer->AddGameServerCmd(pCmd);
+			m_pServer->AddChatTargetLanguageCmd(m_ClientID, CHATCATEGORY_DEFAULT, _("An error occured during the creation of your account."));
 			dbg_msg("sql", "Can't get the ID of the new user (MySQL Error: %s)", e.what());
 			
 			return false;
@@ -3482,538 +3955,380 @@ void CServer::Register(int ClientID, const char* pUsername, const char* pPasswor
 	
 	CSqlJob* pJob = new CSqlJob_Server_Register(this, ClientID, pUsername, aHash, pEmail);
 	m_aClients[ClientID].m_LogInstance = pJob->GetInstance();
-	pJob->Start();
+	pJob->Start(false, CSqlJob::PRIORITY_HIGH);
+}
+
+static const char* Top10Title(int ScoreType)
+{
+	switch(ScoreType)
+	{
+		case SQL_SCORETYPE_ENGINEER_SCORE:
+			return "== Best Engineer ==\n32 best scores on this map\n\n";
+		case SQL_SCORETYPE_SOLDIER_SCORE:
+			return "== Best Soldier ==\n32 best scores on this map\n\n";
+		case SQL_SCORETYPE_SCIENTIST_SCORE:
+			return "== Best Scientist ==\n32 best scores on this map\n\n";
+		case SQL_SCORETYPE_BIOLOGIST_SCORE:
+			return "== Best Biologist ==\n32 best scores on this map\n\n";
+		case SQL_SCORETYPE_LOOPER_SCORE:
+			return "== Best Looper ==\n32 best scores on this map\n\n";
+		case SQL_SCORETYPE_MEDIC_SCORE:
+			return "== Best Medic ==\n32 best scores on this map\n\n";
+		case SQL_SCORETYPE_HERO_SCORE:
+			return "== Best Hero ==\n32 best scores on this map\n\n";
+		case SQL_SCORETYPE_NINJA_SCORE:
+			return "== Best Ninja ==\n32 best scores on this map\n\n";
+		case SQL_SCORETYPE_MERCENARY_SCORE:
+			return "== Best Mercenary ==\n32 best scores on this map\n\n";
+		case SQL_SCORETYPE_SNIPER_SCORE:
+			return "== Best Sniper ==\n32 best scores on this map\n\n";
+		case SQL_SCORETYPE_SMOKER_SCORE:
+			return "== Best Smoker ==\n32 best scores on this map\n\n";
+		case SQL_SCORETYPE_HUNTER_SCORE:
+			return "== Best Hunter ==\n32 best scores on this map\n\n";
+		case SQL_SCORETYPE_BOOMER_SCORE:
+			return "== Best Boomer ==\n32 best scores on this map\n\n";
+		case SQL_SCORETYPE_GHOST_SCORE:
+			return "== Best Ghost ==\n32 best scores on this map\n\n";
+		case SQL_SCORETYPE_SPIDER_SCORE:
+			return "== Best Spider ==\n32 best scores on this map\n\n";
+		case SQL_SCORETYPE_GHOUL_SCORE:
+			return "== Best Ghoul ==\n32 best scores on this map\n\n";
+		case SQL_SCORETYPE_SLUG_SCORE:
+			return "== Best Slug ==\n32 best scores on this map\n\n";
+		case SQL_SCORETYPE_UNDEAD_SCORE:
+			return "== Best Undead ==\n32 best scores on this map\n\n";
+		case SQL_SCORETYPE_WITCH_SCORE:
+			return "== Best Witch ==\n32 best scores on this map\n\n";
+		case SQL_SCORETYPE_ROUND_SCORE:
+			return "== Best Player ==\n32 best scores on this map\n\n";
+	}
+	
+	return "";
+}
+
+static const char* ChallengeTitle(int ScoreType)
+{
+	switch(ScoreType)
+	{
+		case SQL_SCORETYPE_ROUND_SCORE:
+			return "== Player of the day ==\nBest score in one round\n\n";
+		case SQL_SCORETYPE_ENGINEER_SCORE:
+			return "== Engineer of the day ==\nBest score in one round\n\n";
+		case SQL_SCORETYPE_SOLDIER_SCORE:
+			return "== Soldier of the day ==\nBest score in one round\n\n";
+		case SQL_SCORETYPE_SCIENTIST_SCORE:
+			return "== Scientist of the day ==\nBest score in one round\n\n";
+		case SQL_SCORETYPE_BIOLOGIST_SCORE:
+			return "== Biologist of the day ==\nBest score in one round\n\n";
+		case SQL_SCORETYPE_LOOPER_SCORE:
+			return "== Looper of the day ==\nBest score in one round\n\n";
+		case SQL_SCORETYPE_MEDIC_SCORE:
+			return "== Medic of the day ==\nBest score in one round\n\n";
+		case SQL_SCORETYPE_HERO_SCORE:
+			return "== Hero of the day ==\nBest score in one round\n\n";
+		case SQL_SCORETYPE_NINJA_SCORE:
+			return "== Ninja of the day ==\nBest score in one round\n\n";
+		case SQL_SCORETYPE_SNIPER_SCORE:
+			return "== Sniper of the day ==\nBest score in one round\n\n";
+		case SQL_SCORETYPE_MERCENARY_SCORE:
+			return "== Mercenary of the day ==\nBest score in one round\n\n";
+	}
+	
+	return "";
+}
+
+void CServer::ShowTop10(int ClientID, int ScoreType)
+{
+	CLeaderboardCache::CEntry aEntries[10];
+	int NumEntries;
+	if(!m_LeaderboardCache.GetTop(m_aCurrentMap, ScoreType, aEntries, 10, &NumEntries))
+	{
+		LoadLeaderboard();
+		m_pGameServer->SendChatTarget_Localization(ClientID, CHATCATEGORY_DEFAULT, _("The ranking is being loaded, please try again in a few seconds"), NULL);
+		return;
+	}
+	
+	char aBuf[1024];
+	char* pMOTD = aBuf;
+	
+	str_copy(pMOTD, Top10Title(ScoreType), sizeof(aBuf)-(pMOTD-aBuf));
+	pMOTD += str_length(pMOTD);
+	
+	for(int i=0; i<NumEntries; i++)
+	{
+		str_format(pMOTD, sizeof(aBuf)-(pMOTD-aBuf), "%d. %s: %d pts\n",
+			i+1,
+			aEntries[i].m_aUsername,
+			aEntries[i].m_Total/10
+		);
+		pMOTD += str_length(pMOTD);
+	}
+	str_copy(pMOTD, "\nCreate an account with /register and try to beat them!", sizeof(aBuf)-(pMOTD-aBuf));
+	
+	m_pGameServer->SendMOTD(ClientID, aBuf);
+}
+
+void CServer::ShowChallenge(int ClientID)
+{
+	if(g_Config.m_InfChallenge)
+	{
+		int ChallengeType;
+		lock_wait(m_ChallengeLock);
+		ChallengeType = m_ChallengeType;
+		lock_release(m_ChallengeLock);
+		
+		int ScoreType = ChallengeTypeToScoreType(ChallengeType);
+		
+		CLeaderboardCache::CDailyScore aDailyScores[CLeaderboardCache::NUM_DAILY_SCORES];
+		int NumDailyScores = m_LeaderboardCache.GetDailyScores(ScoreType, aDailyScores, CLeaderboardCache::NUM_DAILY_SCORES);
+		
+		CLeaderboardCache::CEntry aEntries[5];
+		int NumEntries;
+		if(NumDailyScores < 0 || !m_LeaderboardCache.GetTop(m_aCurrentMap, SQL_SCORETYPE_ROUND_SCORE, aEntries, 5, &NumEntries))
+		{
+			LoadLeaderboard();
+			m_pGameServer->SendChatTarget_Localization(ClientID, CHATCATEGORY_DEFAULT, _("The ranking is being loaded, please try again in a few seconds"), NULL);
+			return;
+		}
+		
+		char aMotdBuf[1024];
+		char* pMOTD = aMotdBuf;
+		
+		str_copy(pMOTD, ChallengeTitle(ScoreType), sizeof(aMotdBuf)-(pMOTD-aMotdBuf));
+		pMOTD += str_length(pMOTD);
+		
+		for(int i=0; i<NumDailyScores; i++)
+		{
+			str_format(pMOTD, sizeof(aMotdBuf)-(pMOTD-aMotdBuf), "%d. %s: %d pts\n",
+				i+1,
+				aDailyScores[i].m_aUsername,
+				aDailyScores[i].m_Score/10
+			);
+			pMOTD += str_length(pMOTD);
+		}
+		
+		str_copy(pMOTD, "\n== Best Players ==\n32 best scores on this map\n\n", sizeof(aMotdBuf)-(pMOTD-aMotdBuf));
+		pMOTD += str_length(pMOTD);
+		
+		for(int i=0; i<NumEntries; i++)
+		{
+			str_format(pMOTD, sizeof(aMotdBuf)-(pMOTD-aMotdBuf), "%d. %s: %d pts\n",
+				i+1,
+				aEntries[i].m_aUsername,
+				aEntries[i].m_Total/10
+			);
+			pMOTD += str_length(pMOTD);
+		}
+		
+		str_copy(pMOTD, "\n\nCreate an account with /register and try to beat them!", sizeof(aMotdBuf)-(pMOTD-aMotdBuf));
+		
+		m_pGameServer->SendMOTD(ClientID, aMotdBuf);
+	}
 }
 
-class CSqlJob_Server_ShowTop10 : public CSqlJob
+//Loads the rankings of a map and the challenge of the day into the leaderboard cache
+class CSqlJob_Server_LoadLeaderboard : public CSqlJob
 {
 private:
 	CServer* m_pServer;
 	CSqlString<64> m_sMapName;
-	int m_ClientID;
-	int m_ScoreType;
+	bool m_Loaded;
 	
 public:
-	CSqlJob_Server_ShowTop10(CServer* pServer, const char* pMapName, int ClientID, int ScoreType)
+	CSqlJob_Server_LoadLeaderboard(CServer* pServer, const char* pMapName)
 	{
 		m_pServer = pServer;
 		m_sMapName = CSqlString<64>(pMapName);
-		m_ClientID = ClientID;
-		m_ScoreType = ScoreType;
+		m_Loaded = false;
 	}
 
 	virtual bool Job(CSqlServer* pSqlServer)
 	{
-		char aBuf[1024];
+		char aBuf[2048];
 		
 		try
 		{
-			//Get the top 10 with this very simple, intuitive and optimized SQL function >_<
-			pSqlServer->executeSql("SET @VarRowNum := 0, @VarType := -1");
+			if(g_Config.m_InfChallenge)
+			{
+				int ChallengeType = m_pServer->m_ChallengeType;
+				
+				//Get the day
+				str_format(aBuf, sizeof(aBuf), "SELECT WEEKDAY(UTC_TIMESTAMP()) AS WeekDay, WEEK(UTC_TIMESTAMP()) AS Week");
+				pSqlServer->executeSqlQuery(aBuf);
+				
+				if(pSqlServer->GetResults()->next())
+				{
+					int CurrentDay = pSqlServer->GetResults()->getInt("WeekDay");
+					int CurrentWeek = pSqlServer->GetResults()->getInt("Week");
+					ChallengeType = (CurrentWeek*7 + CurrentDay)%NB_HUMANCLASS;
+				}
+				
+				int ScoreType = ChallengeTypeToScoreType(ChallengeType);
+				
+				str_format(aBuf, sizeof(aBuf), 
+					"SELECT "
+						"TableUsers.Username, "
+						"TableScore.Score "
+					"FROM %s_infc_RoundScore AS TableScore "
+					"INNER JOIN %s_Users AS TableUsers ON TableScore.UserId = TableUsers.UserId "
+					"WHERE DATE(TableScore.ScoreDate) = DATE(UTC_TIMESTAMP()) AND TableScore.ScoreType = %d "
+					"ORDER BY TableScore.Score DESC "
+					"LIMIT %d"
+					, pSqlServer->GetPrefix()
+					, pSqlServer->GetPrefix()
+					, ScoreType
+					, (int)CLeaderboardCache::NUM_DAILY_SCORES
+				);
+				pSqlServer->executeSqlQuery(aBuf);
+				
+				CLeaderboardCache::CDailyScore aDailyScores[CLeaderboardCache::NUM_DAILY_SCORES];
+				int NumDailyScores = 0;
+				while(NumDailyScores < CLeaderboardCache::NUM_DAILY_SCORES && pSqlServer->GetResults()->next())
+				{
+					str_copy(aDailyScores[NumDailyScores].m_aUsername, pSqlServer->GetResults()->getString("Username").c_str(), sizeof(aDailyScores[NumDailyScores].m_aUsername));
+					aDailyScores[NumDailyScores].m_Score = pSqlServer->GetResults()->getInt("Score");
+					NumDailyScores++;
+				}
+				
+				m_pServer->m_LeaderboardCache.SetDailyScores(ScoreType, aDailyScores, NumDailyScores);
+				
+				lock_wait(m_pServer->m_ChallengeLock);
+				m_pServer->m_ChallengeType = ChallengeType;
+				lock_release(m_pServer->m_ChallengeLock);
+			}
+			
+			//The best SQL_SCORE_NUMROUND scores of each player, for every score type of the map at once
+			pSqlServer->executeSql("SET @VarRowNum := 0, @VarUser := -1, @VarType := -1");
 			str_format(aBuf, sizeof(aBuf), 
 				"SELECT "
+					"y.ScoreType, "
+					"y.UserId, "
 					"TableUsers.Username, "
-					"SUM(y.Score) AS AccumulatedScore, "
-					"COUNT(y.Score) AS NbRounds "
+					"y.Score "
 				"FROM ("
 					"SELECT "
+						"x.ScoreType AS ScoreType, "
 						"x.UserId AS UserId, "
 						"x.Score AS Score, "
-						"@VarRowNum := IF(@VarType = x.UserId, @VarRowNum + 1, 1) as RowNumber, "
-						"@VarType := x.UserId AS dummy "
+						"@VarRowNum := IF(@VarUser = x.UserId AND @VarType = x.ScoreType, @VarRowNum + 1, 1) as RowNumber, "
+						"@VarUser := x.UserId AS dummy, "
+						"@VarType := x.ScoreType AS dummy2 "
 					"FROM ("
 						"SELECT "
+							"TableRoundScore.ScoreType, "
 							"TableRoundScore.UserId, "
 							"TableRoundScore.Score "
 						"FROM %s_infc_RoundScore AS TableRoundScore "
-						"WHERE ScoreType = '%d' AND MapName = '%s' "
-						"ORDER BY TableRoundScore.UserId ASC, TableRoundScore.Score DESC "
+						"WHERE MapName = '%s' "
+						"ORDER BY TableRoundScore.ScoreType ASC, TableRoundScore.UserId ASC, TableRoundScore.Score DESC "
 					") AS x "
 				") AS y "
 				"INNER JOIN %s_Users AS TableUsers ON y.UserId = TableUsers.UserId "
 				"WHERE y.RowNumber <= %d "
-				"GROUP BY y.UserId "
-				"ORDER BY AccumulatedScore DESC, y.UserId ASC "
-				"LIMIT 10"
+				"ORDER BY y.ScoreType ASC, y.UserId ASC, y.Score DESC"
 				, pSqlServer->GetPrefix()
-				, m_ScoreType
 				, m_sMapName.ClrStr()
 				, pSqlServer->GetPrefix()
 				, SQL_SCORE_NUMROUND
 			);
 			pSqlServer->executeSqlQuery(aBuf);
 			
-			char* pMOTD = aBuf;
-			
-			switch(m_ScoreType)
-			{
-				case SQL_SCORETYPE_ENGINEER_SCORE:
-					str_copy(pMOTD, "== Best Engineer ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-				case SQL_SCORETYPE_SOLDIER_SCORE:
-					str_copy(pMOTD, "== Best Soldier ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-				case SQL_SCORETYPE_SCIENTIST_SCORE:
-					str_copy(pMOTD, "== Best Scientist ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-				case SQL_SCORETYPE_BIOLOGIST_SCORE:
-					str_copy(pMOTD, "== Best Biologist ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-				case SQL_SCORETYPE_LOOPER_SCORE:
-					str_copy(pMOTD, "== Best Looper ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-				case SQL_SCORETYPE_MEDIC_SCORE:
-					str_copy(pMOTD, "== Best Medic ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-				case SQL_SCORETYPE_HERO_SCORE:
-					str_copy(pMOTD, "== Best Hero ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-				case SQL_SCORETYPE_NINJA_SCORE:
-					str_copy(pMOTD, "== Best Ninja ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-				case SQL_SCORETYPE_MERCENARY_SCORE:
-					str_copy(pMOTD, "== Best Mercenary ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-				case SQL_SCORETYPE_SNIPER_SCORE:
-					str_copy(pMOTD, "== Best Sniper ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-				case SQL_SCORETYPE_SMOKER_SCORE:
-					str_copy(pMOTD, "== Best Smoker ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-				case SQL_SCORETYPE_HUNTER_SCORE:
-					str_copy(pMOTD, "== Best Hunter ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-				case SQL_SCORETYPE_BOOMER_SCORE:
-					str_copy(pMOTD, "== Best Boomer ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-				case SQL_SCORETYPE_GHOST_SCORE:
-					str_copy(pMOTD, "== Best Ghost ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-				case SQL_SCORETYPE_SPIDER_SCORE:
-					str_copy(pMOTD, "== Best Spider ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-				case SQL_SCORETYPE_GHOUL_SCORE:
-					str_copy(pMOTD, "== Best Ghoul ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-				case SQL_SCORETYPE_SLUG_SCORE:
-					str_copy(pMOTD, "== Best Slug ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-				case SQL_SCORETYPE_UNDEAD_SCORE:
-					str_copy(pMOTD, "== Best Undead ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-				case SQL_SCORETYPE_WITCH_SCORE:
-					str_copy(pMOTD, "== Best Witch ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-				case SQL_SCORETYPE_ROUND_SCORE:
-					str_copy(pMOTD, "== Best Player ==\n32 best scores on this map\n\n", sizeof(aBuf)-(pMOTD-aBuf));
-					pMOTD += str_length(pMOTD);
-					break;
-			}
-			
-			int Rank = 0;
+			array<CLeaderboardCache::CEntry> Entries;
+			array<int> ScoreTypes;
 			while(pSqlServer->GetResults()->next())
 			{
-				Rank++;
-				str_format(pMOTD, sizeof(aBuf)-(pMOTD-aBuf), "%d. %s: %d pts\n",
-					Rank,
-					pSqlServer->GetResults()->getString("Username").c_str(),
-					pSqlServer->GetResults()->getInt("AccumulatedScore")/10
-				);
-				pMOTD += str_length(pMOTD);
+				int ScoreType = pSqlServer->GetResults()->getInt("ScoreType");
+				int UserID = pSqlServer->GetResults()->getInt("UserId");
+				int Score = pSqlServer->GetResults()->getInt("Score");
+				
+				int Last = Entries.size()-1;
+				if(Last < 0 || ScoreTypes[Last] != ScoreType || Entries[Last].m_UserID != UserID)
+				{
+					CLeaderboardCache::CEntry Entry;
+					mem_zero(&Entry, sizeof(Entry));
+					Entry.m_UserID = UserID;
+					str_copy(Entry.m_aUsername, pSqlServer->GetResults()->getString("Username").c_str(), sizeof(Entry.m_aUsername));
+					Last = Entries.add(Entry);
+					ScoreTypes.add(ScoreType);
+				}
+				
+				CLeaderboardCache::CEntry& Entry = Entries[Last];
+				if(Entry.m_NumScores < SQL_SCORE_NUMROUND)
+				{
+					Entry.m_aScores[Entry.m_NumScores++] = Score;
+					Entry.m_Total += Score;
+				}
 			}
-			str_copy(pMOTD, "\nCreate an account with /register and try to beat them!", sizeof(aBuf)-(pMOTD-aBuf));
 			
-			CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatMOTD(m_ClientID, aBuf);
-			m_pServer->AddGameServerCmd(pCmd);
+			m_pServer->m_LeaderboardCache.EndLoad(m_sMapName.Str(), &Entries, &ScoreTypes);
+			m_Loaded = true;
 		}
 		catch (sql::SQLException &e)
 		{
-			dbg_msg("sql", "Can't get top10 (MySQL Error: %s)", e.what());
+			dbg_msg("sql", "Can't load leaderboard (MySQL Error: %s)", e.what());
 			
 			return false;
 		}
 		
 		return true;
 	}
+	
+	virtual void CleanInstanceRef()
+	{
+		if(!m_Loaded)
+			m_pServer->m_LeaderboardCache.EndLoad(m_sMapName.Str(), 0, 0);
+	}
 };
 
-void CServer::ShowTop10(int ClientID, int ScoreType)
+void CServer::LoadLeaderboard()
 {
-	CSqlJob* pJob = new CSqlJob_Server_ShowTop10(this, m_aCurrentMap, ClientID, ScoreType);
-	pJob->Start();
-}
-
-class CSqlJob_Server_ShowChallenge : public CSqlJob
-{
-private:
-	CServer* m_pServer;
-	CSqlString<64> m_sMapName;
-	int m_ClientID;
-	int m_ScoreType;
-	
-public:
-	CSqlJob_Server_ShowChallenge(CServer* pServer, const char* pMapName, int ClientID, int ChallengeType)
-	{
-		m_pServer = pServer;
-		m_ScoreType = ChallengeTypeToScoreType(ChallengeType);
-		m_ClientID = ClientID;
-		m_sMapName = CSqlString<64>(pMapName);
-	}
-
-	virtual bool Job(CSqlServer* pSqlServer)
-	{
-		char aMotdBuf[1024];
-		char aBuf[1024];
-		
-		try
-		{
-			char* pMOTD = aMotdBuf;
-			
-			if(m_ScoreType >= 0)
-			{
-				str_format(aBuf, sizeof(aBuf), 
-					"SELECT "
-						"TableUsers.Username, "
-						"TableScore.Score "
-					"FROM %s_infc_RoundScore AS TableScore "
-					"INNER JOIN %s_Users AS TableUsers ON TableScore.UserId = TableUsers.UserId "
-					"WHERE DATE(TableScore.ScoreDate) = DATE(UTC_TIMESTAMP()) AND TableScore.ScoreType = %d "
-					"ORDER BY TableScore.Score DESC "
-					"LIMIT 5"
-					, pSqlServer->GetPrefix()
-					, pSqlServer->GetPrefix()
-					, m_ScoreType
-				);
-				pSqlServer->executeSqlQuery(aBuf);
-				
-				switch(m_ScoreType)
-				{
-					case SQL_SCORETYPE_ROUND_SCORE:
-						str_copy(pMOTD, "== Player of the day ==\nBest score in one round\n\n", sizeof(aMotdBuf)-(pMOTD-aMotdBuf));
-						break;
-					case SQL_SCORETYPE_ENGINEER_SCORE:
-						str_copy(pMOTD, "== Engineer of the day ==\nBest score in one round\n\n", sizeof(aMotdBuf)-(pMOTD-aMotdBuf));
-						break;
-					case SQL_SCORETYPE_SOLDIER_SCORE:
-						str_copy(pMOTD, "== Soldier of the day ==\nBest score in one round\n\n", sizeof(aMotdBuf)-(pMOTD-aMotdBuf));
-						break;
-					case SQL_SCORETYPE_SCIENTIST_SCORE:
-						str_copy(pMOTD, "== Scientist of the day ==\nBest score in one round\n\n", sizeof(aMotdBuf)-(pMOTD-aMotdBuf));
-						break;
-					case SQL_SCORETYPE_BIOLOGIST_SCORE:
-						str_copy(pMOTD, "== Biologist of the day ==\nBest score in one round\n\n", sizeof(aMotdBuf)-(pMOTD-aMotdBuf));
-						break;
-					case SQL_SCORETYPE_LOOPER_SCORE:
-						str_copy(pMOTD, "== Looper of the day ==\nBest score in one round\n\n", sizeof(aMotdBuf)-(pMOTD-aMotdBuf));
-						break;
-					case SQL_SCORETYPE_MEDIC_SCORE:
-						str_copy(pMOTD, "== Medic of the day ==\nBest score in one round\n\n", sizeof(aMotdBuf)-(pMOTD-aMotdBuf));
-						break;
-					case SQL_SCORETYPE_HERO_SCORE:
-						str_copy(pMOTD, "== Hero of the day ==\nBest score in one round\n\n", sizeof(aMotdBuf)-(pMOTD-aMotdBuf));
-						break;
-					case SQL_SCORETYPE_NINJA_SCORE:
-						str_copy(pMOTD, "== Ninja of the day ==\nBest score in one round\n\n", sizeof(aMotdBuf)-(pMOTD-aMotdBuf));
-						break;
-					case SQL_SCORETYPE_SNIPER_SCORE:
-						str_copy(pMOTD, "== Sniper of the day ==\nBest score in one round\n\n", sizeof(aMotdBuf)-(pMOTD-aMotdBuf));
-						break;
-					case SQL_SCORETYPE_MERCENARY_SCORE:
-						str_copy(pMOTD, "== Mercenary of the day ==\nBest score in one round\n\n", sizeof(aMotdBuf)-(pMOTD-aMotdBuf));
-						break;
-				}
-				pMOTD += str_length(pMOTD);
-				
-				int Rank = 0;
-				while(pSqlServer->GetResults()->next())
-				{
-					Rank++;
-					str_format(pMOTD, sizeof(aMotdBuf)-(pMOTD-aMotdBuf), "%d. %s: %d pts\n",
-						Rank,
-						pSqlServer->GetResults()->getString("Username").c_str(),
-						pSqlServer->GetResults()->getInt("Score")/10
-					);
-					pMOTD += str_length(pMOTD);
-				}
-			}
-			
-			{
-				//Get the top 5 with this very simple, intuitive and optimized SQL function >_<
-				pSqlServer->executeSql("SET @VarRowNum := 0, @VarType := -1");
-				str_format(aBuf, sizeof(aBuf), 
-					"SELECT "
-						"TableUsers.Username, "
-						"SUM(y.Score) AS AccumulatedScore, "
-						"COUNT(y.Score) AS NbRounds "
-					"FROM ("
-						"SELECT "
-							"x.UserId AS UserId, "
-							"x.Score AS Score, "
-							"@VarRowNum := IF(@VarType = x.UserId, @VarRowNum + 1, 1) as RowNumber, "
-							"@VarType := x.UserId AS dummy "
-						"FROM ("
-							"SELECT "
-								"TableRoundScore.UserId, "
-								"TableRoundScore.Score "
-							"FROM %s_infc_RoundScore AS TableRoundScore "
-							"WHERE ScoreType = '%d' AND MapName = '%s' "
-							"ORDER BY TableRoundScore.UserId ASC, TableRoundScore.Score DESC "
-						") AS x "
-					") AS y "
-					"INNER JOIN %s_Users AS TableUsers ON y.UserId = TableUsers.UserId "
-					"WHERE y.RowNumber <= %d "
-					"GROUP BY y.UserId "
-					"ORDER BY AccumulatedScore DESC, y.UserId ASC "
-					"LIMIT 5"
-					, pSqlServer->GetPrefix()
-					, SQL_SCORETYPE_ROUND_SCORE
-					, m_sMapName.ClrStr()
-					, pSqlServer->GetPrefix()
-					, SQL_SCORE_NUMROUND
-				);
-				pSqlServer->executeSqlQuery(aBuf);
-				
-				str_copy(pMOTD, "\n== Best Players ==\n32 best scores on this map\n\n", sizeof(aMotdBuf)-(pMOTD-aMotdBuf));
-				pMOTD += str_length(pMOTD);
-				
-				int Rank = 0;
-				while(pSqlServer->GetResults()->next())
-				{
-					Rank++;
-					str_format(pMOTD, sizeof(aMotdBuf)-(pMOTD-aMotdBuf), "%d. %s: %d pts\n",
-						Rank,
-						pSqlServer->GetResults()->getString("Username").c_str(),
-						pSqlServer->GetResults()->getInt("AccumulatedScore")/10
-					);
-					pMOTD += str_length(pMOTD);
-				}
-			}
-			
-			str_copy(pMOTD, "\n\nCreate an account with /register and try to beat them!", sizeof(aMotdBuf)-(pMOTD-aMotdBuf));
-			
-			CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatMOTD(m_ClientID, aMotdBuf);
-			m_pServer->AddGameServerCmd(pCmd);
-		}
-		catch (sql::SQLException &e)
-		{
-			dbg_msg("sql", "Can't get challenge (MySQL Error: %s)", e.what());
-			
-			return false;
-		}
-		
-		return true;
-	}
-};
-
-void CServer::ShowChallenge(int ClientID)
-{
-	if(g_Config.m_InfChallenge)
+	if(m_LeaderboardCache.StartLoad(m_aCurrentMap, time_freq()*g_Config.m_InfLeaderboardRefresh))
 	{
-		int ChallengeType;
-		lock_wait(m_ChallengeLock);
-		ChallengeType = m_ChallengeType;
-		lock_release(m_ChallengeLock);
-		
-		CSqlJob* pJob = new CSqlJob_Server_ShowChallenge(this, m_aCurrentMap, ClientID, ChallengeType);
+		CSqlJob* pJob = new CSqlJob_Server_LoadLeaderboard(this, m_aCurrentMap);
 		pJob->Start();
 	}
 }
 
-class CSqlJob_Server_RefreshChallenge : public CSqlJob
-{
-private:
-	CServer* m_pServer;
-	
-public:
-	CSqlJob_Server_RefreshChallenge(CServer* pServer)
-	{
-		m_pServer = pServer;
-	}
-
-	virtual bool Job(CSqlServer* pSqlServer)
-	{
-		char aBuf[1024];
-		char aWinner[32];
-		int ChallengeType = m_pServer->m_ChallengeType;
-		int ScoreType;
-		
-		aWinner[0] = 0;
-		
-		try
-		{
-			//Get the day
-			str_format(aBuf, sizeof(aBuf), "SELECT WEEKDAY(UTC_TIMESTAMP()) AS WeekDay, WEEK(UTC_TIMESTAMP()) AS Week");
-			pSqlServer->executeSqlQuery(aBuf);
-			
-			if(pSqlServer->GetResults()->next())
-			{
-				int CurrentDay = pSqlServer->GetResults()->getInt("WeekDay");
-				int CurrentWeek = pSqlServer->GetResults()->getInt("Week");
-				ChallengeType = (CurrentWeek*7 + CurrentDay)%NB_HUMANCLASS;
-			}
-			
-			ScoreType = ChallengeTypeToScoreType(ChallengeType);
-			
-			str_format(aBuf, sizeof(aBuf), 
-				"SELECT "
-					"TableUsers.Username "
-				"FROM %s_infc_RoundScore AS TableScore "
-				"INNER JOIN %s_Users AS TableUsers ON TableScore.UserId = TableUsers.UserId "
-				"WHERE DATE(TableScore.ScoreDate) = DATE(UTC_TIMESTAMP()) AND TableScore.ScoreType = %d "
-				"ORDER BY TableScore.Score DESC "
-				"LIMIT 1"
-				, pSqlServer->GetPrefix()
-				, pSqlServer->GetPrefix()
-				, ScoreType
-			);
-			pSqlServer->executeSqlQuery(aBuf);
-			
-			if(pSqlServer->GetResults()->next())
-			{
-				str_copy(aWinner, pSqlServer->GetResults()->getString("Username").c_str(), sizeof(aWinner));
-			}
-			
-			lock_wait(m_pServer->m_ChallengeLock);
-			m_pServer->m_ChallengeType = ChallengeType;
-			str_copy(m_pServer->m_aChallengeWinner, aWinner, sizeof(m_pServer->m_aChallengeWinner));
-			lock_release(m_pServer->m_ChallengeLock);
-		}
-		catch (sql::SQLException &e)
-		{
-			dbg_msg("sql", "Can't refresh challenge (MySQL Error: %s)", e.what());
-			
-			return false;
-		}
-		
-		return true;
-	}
-};
-
 void CServer::RefreshChallenge()
 {
+	LoadLeaderboard();
+	
 	if(g_Config.m_InfChallenge)
 	{
-		CSqlJob* pJob = new CSqlJob_Server_RefreshChallenge(this);
-		pJob->Start();
+		lock_wait(m_ChallengeLock);
+		CLeaderboardCache::CDailyScore DailyScore;
+		int ScoreType = ChallengeTypeToScoreType(m_ChallengeType);
+		if(m_LeaderboardCache.GetDailyScores(ScoreType, &DailyScore, 1) > 0)
+			str_copy(m_aChallengeWinner, DailyScore.m_aUsername, sizeof(m_aChallengeWinner));
+		else
+			m_aChallengeWinner[0] = 0;
+		lock_release(m_ChallengeLock);
+		
+		// the challenge is shown in the server name
+		ExpireServerInfo();
 	}
 }
 
-class CSqlJob_Server_ShowRank : public CSqlJob
+void CServer::ShowRank(int ClientID, int ScoreType)
 {
-private:
-	CServer* m_pServer;
-	CSqlString<64> m_sMapName;
-	int m_ClientID;
-	int m_UserID;
-	int m_ScoreType;
-	
-public:
-	CSqlJob_Server_ShowRank(CServer* pServer, const char* pMapName, int ClientID, int UserID, int ScoreType)
-	{
-		m_pServer = pServer;
-		m_sMapName = CSqlString<64>(pMapName);
-		m_ClientID = ClientID;
-		m_UserID = UserID;
-		m_ScoreType = ScoreType;
-	}
-
-	virtual bool Job(CSqlServer* pSqlServer)
+	if(m_aClients[ClientID].m_UserID >= 0)
 	{
-		char aBuf[1024];
-		
-		try
+		int Rank;
+		CLeaderboardCache::CEntry Entry;
+		if(!m_LeaderboardCache.GetRank(m_aCurrentMap, ScoreType, m_aClients[ClientID].m_UserID, &Rank, &Entry))
 		{
-			//Get the top 10 with this very simple, intuitive and optimized SQL fuction >_<
-			pSqlServer->executeSql("SET @VarRowNum := 0, @VarType := -1");
-			str_format(aBuf, sizeof(aBuf), 
-				"SELECT "
-					"y.UserId, "
-					"SUM(y.Score) AS AccumulatedScore, "
-					"COUNT(y.Score) AS NbRounds "
-				"FROM ("
-					"SELECT "
-						"x.UserId AS UserId, "
-						"x.Score AS Score, "
-						"@VarRowNum := IF(@VarType = x.UserId, @VarRowNum + 1, 1) as RowNumber, "
-						"@VarType := x.UserId AS dummy "
-					"FROM ("
-						"SELECT "
-							"TableRoundScore.UserId, "
-							"TableRoundScore.Score "
-						"FROM %s_infc_RoundScore AS TableRoundScore "
-						"WHERE ScoreType = '%d' AND MapName = '%s' "
-						"ORDER BY TableRoundScore.UserId ASC, TableRoundScore.Score DESC "
-					") AS x "
-				") AS y "
-				"WHERE y.RowNumber <= %d "
-				"GROUP BY y.UserId "
-				"ORDER BY AccumulatedScore DESC, y.UserId ASC "
-				, pSqlServer->GetPrefix()
-				, m_ScoreType
-				, m_sMapName.ClrStr()
-				, SQL_SCORE_NUMROUND
-			);
-			pSqlServer->executeSqlQuery(aBuf);
-			
-			int Rank = 0;
-			bool RankFound = false;
-			while(pSqlServer->GetResults()->next() && !RankFound)
-			{
-				Rank++;
-				if(pSqlServer->GetResults()->getInt("UserId") == m_UserID)
-				{
-					int Score = pSqlServer->GetResults()->getInt("AccumulatedScore")/10;
-					int Rounds = pSqlServer->GetResults()->getInt("NbRounds");
-					str_format(aBuf, sizeof(aBuf), "You are rank %d in %s (%d pts in %d rounds)", Rank, m_sMapName.Str(), Score, Rounds);
-					CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget(m_ClientID, aBuf);
-					m_pServer->AddGameServerCmd(pCmd);
-					
-					RankFound = true;
-				}
-			}
-			
-			if(!RankFound)
-			{
-				CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget(m_ClientID, "You must gain at least one point to see your rank");
-				m_pServer->AddGameServerCmd(pCmd);
-			}
+			LoadLeaderboard();
+			m_pGameServer->SendChatTarget_Localization(ClientID, CHATCATEGORY_DEFAULT, _("The ranking is being loaded, please try again in a few seconds"), NULL);
 		}
-		catch (sql::SQLException &e)
+		else if(Rank > 0)
 		{
-			dbg_msg("sql", "Can't get rank (MySQL Error: %s)", e.what());
-			
-			return false;
+			char aBuf[128];
+			str_format(aBuf, sizeof(aBuf), "You are rank %d in %s (%d pts in %d rounds)", Rank, m_aCurrentMap, Entry.m_Total/10, Entry.m_NumScores);
+			m_pGameServer->SendChatTarget(ClientID, aBuf);
 		}
-		
-		return true;
-	}
-};
-
-void CServer::ShowRank(int ClientID, int ScoreType)
-{
-	if(m_aClients[ClientID].m_UserID >= 0)
-	{
-		CSqlJob* pJob = new CSqlJob_Server_ShowRank(this, m_aCurrentMap, ClientID, m_aClients[ClientID].m_UserID, ScoreType);
-		pJob->Start();
+		else
+			m_pGameServer->SendChatTarget(ClientID, "You must gain at least one point to see your rank");
 	}
 	else if(m_pGameServer)
 	{
@@ -4072,13 +4387,11 @@ public:
 			if(RoundCounter == SQL_SCORE_NUMROUND)
 			{
 				str_format(aBuf, sizeof(aBuf), "You must gain at least %d points to increase your score", (Score+1)); 
-				CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget(m_ClientID, aBuf);
-				m_pServer->AddGameServerCmd(pCmd);
+				m_pServer->AddChatTargetCmd(m_ClientID, aBuf);
 			}
 			else
 			{
-				CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget(m_ClientID, "Gain at least one point to increase your score");
-				m_pServer->AddGameServerCmd(pCmd);
+				m_pServer->AddChatTargetCmd(m_ClientID, "Gain at least one point to increase your score");
 			}
 		}
 		catch (sql::SQLException &e)
@@ -4156,13 +4469,11 @@ public:
 			if(RoundCounter == SQL_SCORE_NUMROUND)
 			{
 				str_format(aBuf, sizeof(aBuf), "Stats - You must gain at least %d points to increase your score", (Score+1)); 
-				CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget(m_ClientID, aBuf);
-				m_pServer->AddGameServerCmd(pCmd);
+				m_pServer->AddChatTargetCmd(m_ClientID, aBuf);
 			}
 			else
 			{
-				CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget(m_ClientID, "stats Gain at least one point to increase your score");
-				m_pServer->AddGameServerCmd(pCmd);
+				m_pServer->AddChatTargetCmd(m_ClientID, "stats Gain at least one point to increase your score");
 			}
 		}
 		catch (sql::SQLException &e)
@@ -4201,206 +4512,95 @@ void CServer::Ban(int ClientID, int Seconds, const char* pReason)
 class CSqlJob_Server_SendRoundStatistics : public CSqlJob
 {
 private:
-	CSqlString<64> m_sMapName;
-	int m_NumPlayersMin;
-	int m_NumPlayersMax;
-	int m_RoundDuration;
-	int m_NumWinners;
-	
-	int m_RoundId;
-	
-public:
-	CSqlJob_Server_SendRoundStatistics(CServer* pServer, const CRoundStatistics* pRoundStatistics, const char* pMapName)
-	{
-		m_sMapName = CSqlString<64>(pMapName);
-		m_NumPlayersMin = pRoundStatistics->m_NumPlayersMin;
-		m_NumPlayersMax = pRoundStatistics->m_NumPlayersMax;
-		m_NumWinners = pRoundStatistics->NumWinners();
-		m_RoundDuration = pRoundStatistics->m_PlayedTicks/pServer->TickSpeed();
-		m_RoundId = -1;
-	}
-
-	virtual bool Job(CSqlServer* pSqlServer)
+	struct CPlayerEntry
 	{
-		char aBuf[512];
-		
-		try
-		{
-			str_format(aBuf, sizeof(aBuf), 
-				"INSERT INTO %s_infc_Rounds "
-				"(MapName, NumPlayersMin, NumPlayersMax, NumWinners, RoundDate, RoundDuration) "
-				"VALUES "
-				"('%s', '%d', '%d', '%d', UTC_TIMESTAMP(), '%d')"
-				, pSqlServer->GetPrefix(), m_sMapName.ClrStr(), m_NumPlayersMin, m_NumPlayersMax, m_NumWinners, m_RoundDuration);
-			pSqlServer->executeSql(aBuf);
-			
-			//Get old score
-			str_format(aBuf, sizeof(aBuf), 
-				"SELECT RoundId FROM %s_infc_Rounds "
-				"WHERE RoundDuration = '%d' AND NumPlayersMin = '%d' AND NumPlayersMax = '%d'"
-				"ORDER BY RoundId DESC LIMIT 1"
-				, pSqlServer->GetPrefix(), m_RoundDuration, m_NumPlayersMin, m_NumPlayersMax);
-			pSqlServer->executeSqlQuery(aBuf);
-			
-			if(pSqlServer->GetResults()->next())
-			{
-				m_RoundId = (int)pSqlServer->GetResults()->getInt("RoundId");
-			}
-		}
-		catch (sql::SQLException &e)
-		{
-			dbg_msg("sql", "Can't send round statistics (MySQL Error: %s)", e.what());
-			
-			return false;
-		}
-		
-		return true;
-	}
+		int m_ClientID;
+		char m_aUsername[MAX_NAME_LENGTH];
+	};
 	
-	virtual void* GenerateChildData()
-	{
-		return &m_RoundId;
-	}
-};
-
-class CSqlJob_Server_SendPlayerStatistics : public CSqlJob
-{
-private:
 	CServer* m_pServer;
-	int m_ClientID;
-	int m_UserID;
-	int m_RoundId;
-	CSqlString<64> m_sMapName;
-	CRoundStatistics::CPlayer m_PlayerStatistics;
+	bool m_SendScores;
+	
+	CSqlRoundScores m_RoundScores;
+	array<CPlayerEntry> m_Players; // same order as the players of m_RoundScores
 	
 public:
-	CSqlJob_Server_SendPlayerStatistics(CServer* pServer, const CRoundStatistics::CPlayer* pPlayerStatistics, const char* pMapName, int UserID, int ClientID)
+	CSqlJob_Server_SendRoundStatistics(CServer* pServer, const CRoundStatistics* pRoundStatistics, const char* pMapName) :
+		m_RoundScores(pMapName, pRoundStatistics->m_NumPlayersMin, pRoundStatistics->m_NumPlayersMax,
+			pRoundStatistics->NumWinners(), pRoundStatistics->m_PlayedTicks/pServer->TickSpeed())
 	{
-		m_RoundId = -1;
 		m_pServer = pServer;
-		m_ClientID = ClientID;
-		m_UserID = UserID;
-		m_sMapName = CSqlString<64>(pMapName);
-		m_PlayerStatistics = *pPlayerStatistics;
+		m_SendScores = (pServer->GameServer()->GetActivePlayerCount() >= 8);
 	}
 	
-	virtual void ProcessParentData(void* pData)
+	void AddPlayer(const CRoundStatistics::CPlayer* pPlayerStatistics, int UserID, int ClientID, const char* pUsername)
 	{
-		int* pRoundId = (int*) pData;
-		m_RoundId = *pRoundId;
-	}
-	
-	void UpdateScore(CSqlServer* pSqlServer, int ScoreType, int Score, const char* pScoreName)
-	{
-		char aBuf[512];
-
-		if (m_pServer->GameServer()->GetActivePlayerCount() < 8) {
+		CPlayerEntry Player;
+		Player.m_ClientID = ClientID;
+		str_copy(Player.m_aUsername, pUsername, sizeof(Player.m_aUsername));
+		m_Players.add(Player);
+		m_RoundScores.AddPlayer(UserID);
+		
+		if(!m_SendScores)
 			return;
-		}
-
-		str_format(aBuf, sizeof(aBuf), 
-			"INSERT INTO %s_infc_RoundScore "
-			"(UserId, RoundId, MapName, ScoreType, ScoreDate, Score) "
-			"VALUES ('%d', '%d', '%s', '%d', UTC_TIMESTAMP(), '%d');"
-			, pSqlServer->GetPrefix(), m_UserID, m_RoundId, m_sMapName.ClrStr(), ScoreType, Score);
-		pSqlServer->executeSql(aBuf);
+		
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_ROUND_SCORE, pPlayerStatistics->m_Score);
+		
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_ENGINEER_SCORE, pPlayerStatistics->m_EngineerScore);
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_SOLDIER_SCORE, pPlayerStatistics->m_SoldierScore);
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_SCIENTIST_SCORE, pPlayerStatistics->m_ScientistScore);
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_BIOLOGIST_SCORE, pPlayerStatistics->m_BiologistScore);
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_LOOPER_SCORE, pPlayerStatistics->m_LooperScore);
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_MEDIC_SCORE, pPlayerStatistics->m_MedicScore);
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_HERO_SCORE, pPlayerStatistics->m_HeroScore);
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_NINJA_SCORE, pPlayerStatistics->m_NinjaScore);
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_MERCENARY_SCORE, pPlayerStatistics->m_MercenaryScore);
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_SNIPER_SCORE, pPlayerStatistics->m_SniperScore);
+		
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_SMOKER_SCORE, pPlayerStatistics->m_SmokerScore);
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_HUNTER_SCORE, pPlayerStatistics->m_HunterScore);
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_BOOMER_SCORE, pPlayerStatistics->m_BoomerScore);
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_GHOST_SCORE, pPlayerStatistics->m_GhostScore);
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_SPIDER_SCORE, pPlayerStatistics->m_SpiderScore);
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_GHOUL_SCORE, pPlayerStatistics->m_GhoulScore);
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_SLUG_SCORE, pPlayerStatistics->m_SlugScore);
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_UNDEAD_SCORE, pPlayerStatistics->m_UndeadScore);
+		m_RoundScores.AddScore(UserID, SQL_SCORETYPE_WITCH_SCORE, pPlayerStatistics->m_WitchScore);
 	}
 
 	virtual bool Job(CSqlServer* pSqlServer)
 	{
 		char aBuf[512];
 		
-		if(m_RoundId < 0)
+		//A reload ending after this point may already count the scores of the round
+		int LeaderboardGeneration = m_pServer->m_LeaderboardCache.Generation();
+		
+		if(!m_RoundScores.Write(pSqlServer))
 			return false;
 		
-		try
+		//Keep the cached rankings up to date without reloading them
+		for(int i=0; i<m_RoundScores.NumScoreRows(); i++)
 		{
-			//Get old score
-			str_format(aBuf, sizeof(aBuf), 
-				"SELECT Score FROM %s_infc_RoundScore "
-				"WHERE UserId = '%d' AND MapName = '%s' AND ScoreType = '%d'"
-				"ORDER BY Score DESC "
-				"LIMIT %d "
-				, pSqlServer->GetPrefix(), m_UserID, m_sMapName.ClrStr(), 0, SQL_SCORE_NUMROUND);
-			pSqlServer->executeSqlQuery(aBuf);
-
-			int OldScore = 0;
-			while(pSqlServer->GetResults()->next())
+			const CSqlRoundScores::CScoreRow* pRow = m_RoundScores.GetScoreRow(i);
+			for(int p=0; p<m_RoundScores.NumPlayers(); p++)
 			{
-				OldScore += (int)pSqlServer->GetResults()->getInt("Score");
+				if(m_RoundScores.GetPlayer(p)->m_UserID == pRow->m_UserID)
+				{
+					m_pServer->m_LeaderboardCache.AddScore(LeaderboardGeneration, m_RoundScores.MapName(), pRow->m_ScoreType, pRow->m_UserID, m_Players[p].m_aUsername, pRow->m_Score);
+					break;
+				}
 			}
-			
-			if(m_PlayerStatistics.m_Score > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_ROUND_SCORE, m_PlayerStatistics.m_Score, "");
-				
-			if(m_PlayerStatistics.m_EngineerScore > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_ENGINEER_SCORE, m_PlayerStatistics.m_EngineerScore, "Engineer");
-			if(m_PlayerStatistics.m_SoldierScore > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_SOLDIER_SCORE, m_PlayerStatistics.m_SoldierScore, "Soldier");
-			if(m_PlayerStatistics.m_ScientistScore > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_SCIENTIST_SCORE, m_PlayerStatistics.m_ScientistScore, "Scientist");
-			if(m_PlayerStatistics.m_BiologistScore > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_BIOLOGIST_SCORE, m_PlayerStatistics.m_BiologistScore, "Biologist");
-			if(m_PlayerStatistics.m_LooperScore > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_LOOPER_SCORE, m_PlayerStatistics.m_LooperScore, "Looper");
-			if(m_PlayerStatistics.m_MedicScore > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_MEDIC_SCORE, m_PlayerStatistics.m_MedicScore, "Medic");
-			if(m_PlayerStatistics.m_HeroScore > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_HERO_SCORE, m_PlayerStatistics.m_HeroScore, "Hero");
-			if(m_PlayerStatistics.m_NinjaScore > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_NINJA_SCORE, m_PlayerStatistics.m_NinjaScore, "Ninja");
-			if(m_PlayerStatistics.m_MercenaryScore > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_MERCENARY_SCORE, m_PlayerStatistics.m_MercenaryScore, "Mercenary");
-			if(m_PlayerStatistics.m_SniperScore > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_SNIPER_SCORE, m_PlayerStatistics.m_SniperScore, "Sniper");
-				
-			if(m_PlayerStatistics.m_SmokerScore > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_SMOKER_SCORE, m_PlayerStatistics.m_SmokerScore, "Smoker");
-			if(m_PlayerStatistics.m_HunterScore > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_HUNTER_SCORE, m_PlayerStatistics.m_HunterScore, "Hunter");
-			if(m_PlayerStatistics.m_BoomerScore > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_BOOMER_SCORE, m_PlayerStatistics.m_BoomerScore, "Boomer");
-			if(m_PlayerStatistics.m_GhostScore > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_GHOST_SCORE, m_PlayerStatistics.m_GhostScore, "Ghost");
-			if(m_PlayerStatistics.m_SpiderScore > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_SPIDER_SCORE, m_PlayerStatistics.m_SpiderScore, "Spider");
-			if(m_PlayerStatistics.m_GhoulScore > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_GHOUL_SCORE, m_PlayerStatistics.m_GhoulScore, "Ghoul");
-			if(m_PlayerStatistics.m_SlugScore > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_SLUG_SCORE, m_PlayerStatistics.m_SlugScore, "Slug");
-			if(m_PlayerStatistics.m_UndeadScore > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_UNDEAD_SCORE, m_PlayerStatistics.m_UndeadScore, "Undead");
-			if(m_PlayerStatistics.m_WitchScore > 0)
-				UpdateScore(pSqlServer, SQL_SCORETYPE_WITCH_SCORE, m_PlayerStatistics.m_WitchScore, "Witch");
+		}
 		
-			//Get new score
-			str_format(aBuf, sizeof(aBuf), 
-				"SELECT Score FROM %s_infc_RoundScore "
-				"WHERE UserId = '%d' AND MapName = '%s' AND ScoreType = '%d'"
-				"ORDER BY Score DESC "
-				"LIMIT %d "
-				, pSqlServer->GetPrefix(), m_UserID, m_sMapName.ClrStr(), 0, SQL_SCORE_NUMROUND);
-			pSqlServer->executeSqlQuery(aBuf);
-
-			int NewScore = 0;
-			if(pSqlServer->GetResults()->next())
-			{
-				NewScore += (int)pSqlServer->GetResults()->getInt("Score");
-			}
-			
-			if(OldScore < NewScore)
+		for(int i=0; i<m_RoundScores.NumPlayers(); i++)
+		{
+			const CSqlRoundScores::CPlayer* pPlayer = m_RoundScores.GetPlayer(i);
+			if(pPlayer->m_OldScore < pPlayer->m_NewScore)
 			{
-				str_format(aBuf, sizeof(aBuf), "You increased your score: +%d", (NewScore-OldScore)/10);
-				CServer::CGameServerCmd* pCmd = new CGameServerCmd_SendChatTarget(m_ClientID, aBuf);
-				m_pServer->AddGameServerCmd(pCmd);
+				str_format(aBuf, sizeof(aBuf), "You increased your score: +%d", (pPlayer->m_NewScore-pPlayer->m_OldScore)/10);
+				m_pServer->AddChatTargetCmd(m_Players[i].m_ClientID, aBuf);
 			}
 		}
-		catch (sql::SQLException &e)
-		{
-			dbg_msg("sql", "Can't send player statistics (MySQL Error: %s)", e.what());
-			
-			return false;
-		}
 		
 		return true;
 	}
@@ -4410,23 +4610,20 @@ public:
 void CServer::OnRoundEnd()
 {
 #ifdef CONF_SQL
-	//Send round statistics
-	CSqlJob* pRoundJob = new CSqlJob_Server_SendRoundStatistics(this, RoundStatistics(), m_aCurrentMap);
-	pRoundJob->Start();
+	//Send round and player statistics in one job
+	CSqlJob_Server_SendRoundStatistics* pRoundJob = new CSqlJob_Server_SendRoundStatistics(this, RoundStatistics(), m_aCurrentMap);
 	
-	//Send player statistics
 	for(int i=0; i<MAX_CLIENTS; i++)
 	{
 		if(m_aClients[i].m_State == CClient::STATE_INGAME)
 		{
 			m_aClients[i].m_NbRound++;
 			if(m_aClients[i].m_UserID >= 0 && RoundStatistics()->IsValidePlayer(i))
-			{
-				CSqlJob* pJob = new CSqlJob_Server_SendPlayerStatistics(this, RoundStatistics()->PlayerStatistics(i), m_aCurrentMap, m_aClients[i].m_UserID, i);
-				pRoundJob->AddQueuedJob(pJob);
-			}
+				pRoundJob->AddPlayer(RoundStatistics()->PlayerStatistics(i), m_aClients[i].m_UserID, i, m_aClients[i].m_aUsername);
 		}
 	}
+	
+	pRoundJob->Start(false, CSqlJob::PRIORITY_LOW);
 #endif
 }
 
@@ -4668,7 +4865,17 @@ int* CServer::GetIdMap(int ClientID)
 	return (int*)(IdMap + VANILLA_MAX_CLIENTS * ClientID);
 }
 
+int* CServer::GetReverseIdMap(int ClientID)
+{
+	return (int*)(m_aReverseIdMap + MAX_CLIENTS * ClientID);
+}
+
 void CServer::SetCustClt(int ClientID)
 {
 	m_aClients[ClientID].m_CustClt = 1;
 }
+
+bool CServer::IsCustClt(int ClientID) const
+{
+	return m_aClients[ClientID].m_CustClt;
+}
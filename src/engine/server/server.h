@@ -12,6 +12,7 @@
 /* DDNET MODIFICATION START *******************************************/
 #include "sql_connector.h"
 #include "sql_server.h"
+#include "leaderboard.h"
 /* DDNET MODIFICATION END *********************************************/
 
 class CSnapIDPool
@@ -172,9 +173,45 @@ public:
 
 	CClient m_aClients[MAX_CLIENTS];
 	int IdMap[MAX_CLIENTS * VANILLA_MAX_CLIENTS];
+	int m_aReverseIdMap[MAX_CLIENTS * MAX_CLIENTS];
 
 	CSnapshotDelta m_SnapshotDelta;
 	CSnapshotBuilder m_SnapshotBuilder;
+	CSnapshotBuilder *m_pSnapTarget;
+
+	// turns a client snapshot into compressed delta data, can run on a snap worker
+	class CSnapJob
+	{
+	public:
+		char m_aData[CSnapshot::MAX_SIZE];
+		char m_aDeltaData[CSnapshot::MAX_SIZE];
+		char m_aCompData[CSnapshot::MAX_SIZE];
+		CSnapshot *m_pDeltashot;
+		int m_DeltaTick;
+		int m_Crc;
+		int m_CompSize;
+	};
+
+	enum
+	{
+		MAX_SNAP_THREADS=16,
+	};
+
+	CSnapJob *m_pSnapJobs;
+	int m_aSnapJobQueue[MAX_CLIENTS];
+	int m_NumSnapJobs;
+	int m_NextSnapJob;
+	void *m_apSnapThreads[MAX_SNAP_THREADS];
+	int m_NumSnapThreads;
+	bool m_SnapThreadsStop;
+	LOCK m_SnapJobLock;
+	SEMAPHORE m_SnapJobSem;
+	SEMAPHORE m_SnapDoneSem;
+
+	static void SnapWorkerThread(void *pUser);
+	void StopSnapThreads();
+	void ProcessSnapJob(CSnapJob *pJob);
+	void SendSnapJob(int ClientID, CSnapJob *pJob);
 	CSnapIDPool m_IDPool;
 	CNetServer m_NetServer;
 	CEcon m_Econ;
@@ -203,10 +240,52 @@ public:
 	int64 m_ServerInfoFirstRequest;
 	int m_ServerInfoNumRequests;
 
+	enum
+	{
+		SERVERINFO_CLIENTS_PER_PACKET=24,
+		SERVERINFO_MAX_PAGES=(MAX_CLIENTS+SERVERINFO_CLIENTS_PER_PACKET-1)/SERVERINFO_CLIENTS_PER_PACKET,
+	};
+
+	// server info packet without its header and token
+	class CServerInfoPacket
+	{
+	public:
+		unsigned char m_aData[NET_MAX_PAYLOAD];
+		int m_DataSize;
+		bool m_MorePages;
+	};
+
+	// the vanilla packet, then the pages of the 64 slots one
+	CServerInfoPacket m_aServerInfoCache[1+SERVERINFO_MAX_PAGES];
+	volatile unsigned m_ServerInfoDirty;
+
 	CDemoRecorder m_DemoRecorder;
 	CRegister m_Register;
 	CMapChecker m_MapChecker;
 
+	// everything a map change needs from disk, filled in off the game thread
+	class CMapPrepare
+	{
+	public:
+		char m_aMapName[64];
+		IEngineMap *m_pMap;
+		unsigned char *m_pData;
+		unsigned int m_DataSize;
+		unsigned m_Crc;
+		int m_TimeShiftUnit;
+		bool m_Success;
+	};
+
+	enum
+	{
+		MAPPREPARE_IDLE=0,
+		MAPPREPARE_RUNNING,
+		MAPPREPARE_DONE,
+	};
+
+	CMapPrepare m_MapPrepare;
+	volatile int m_MapPrepareState;
+
 	CServer();
 	virtual ~CServer();
 
@@ -262,12 +341,20 @@ public:
 
 	void SendServerInfoConnless(const NETADDR *pAddr, int Token, bool Extended = false);
 	void SendServerInfo(const NETADDR *pAddr, int Token, bool Extended=false, bool SendClients = true, int Offset=0);
+	void BuildServerInfo(CServerInfoPacket *pInfo, const NETADDR *pAddr, bool Extended, bool SendClients, int Offset);
+	void RebuildServerInfoCache();
+	virtual void ExpireServerInfo();
 	void UpdateServerInfo();
 
 	void PumpNetwork();
 
 	char *GetMapName();
 	int LoadMap(const char *pMapName);
+	bool PrepareClientMap(const char *pMapName, class IEngineMap *pMap, char *pClientMapName, int ClientMapNameSize, int *pTimeShiftUnit, IConsole *pConsole);
+	static void MapPrepareThread(void *pUser);
+	bool PrepareMap(CMapPrepare *pPrepare);
+	void SwapInMap(CMapPrepare *pPrepare);
+	void StartMapPrepare(const char *pMapName);
 
 	void InitRegister(CNetServer *pNetServer, IEngineMasterServer *pMasterServer, IConsole *pConsole);
 	int Run();
@@ -292,7 +379,12 @@ public:
 /* DDNET MODIFICATION START *******************************************/
 	static bool ConAddSqlServer(IConsole::IResult *pResult, void *pUserData);
 	static bool ConDumpSqlServers(IConsole::IResult *pResult, void *pUserData);
+	static bool ConSqlPoolStats(IConsole::IResult *pResult, void *pUserData);
+	static bool ConLeaderboardInvalidate(IConsole::IResult *pResult, void *pUserData);
+	static bool ConLeaderboardStats(IConsole::IResult *pResult, void *pUserData);
 	static bool ConGetIDCount(IConsole::IResult *pResult, void *pUser);
+	static bool ConSnapshotStorageStats(IConsole::IResult *pResult, void *pUser);
+	static bool ConGenerateClientMaps(IConsole::IResult *pResult, void *pUser);
 
 	static void CreateTablesThread(void *pData);
 /* DDNET MODIFICATION END *********************************************/
@@ -303,6 +395,7 @@ public:
 	virtual int SnapNewID();
 	virtual void SnapFreeID(int ID);
 	virtual void *SnapNewItem(int Type, int ID, int Size);
+	virtual void SnapSetBuilder(CSnapshotBuilder *pBuilder);
 	void SnapSetStaticsize(int ItemType, int Size);
 	
 /* INFECTION MODIFICATION START ***************************************/
@@ -360,6 +453,7 @@ public:
 	virtual void ShowGoal(int ClientID, int ScoreType);
 	virtual void ShowStats(int ClientID, int UserId);
 	virtual void RefreshChallenge();
+	void LoadLeaderboard();
 	virtual int GetUserLevel(int ClientID);
 #endif
 	virtual void Ban(int ClientID, int Seconds, const char* pReason);
@@ -367,11 +461,72 @@ private:
 	bool InitCaptcha();
 	
 public:
+	// result of a sql job, executed by the main thread
 	class CGameServerCmd
 	{
 	public:
-		virtual ~CGameServerCmd() {};
-		virtual void Execute(IGameServer* pGameServer) = 0;
+		enum
+		{
+			SEND_CHAT_TARGET=0,
+			SEND_CHAT_TARGET_LANGUAGE,
+			SEND_MOTD,
+		};
+
+		int m_Type;
+		int m_ClientID;
+		int m_ChatCategory;
+		char m_aText[512];
+
+		void Execute(IGameServer* pGameServer);
+	};
+
+	// bounded lock-free queue, filled by the sql workers and drained by the main thread
+	class CGameServerCmdQueue
+	{
+	public:
+		enum
+		{
+			SIZE=1024, // power of two
+		};
+
+		struct CStats
+		{
+			int m_Depth;
+			int m_MaxDepth;
+			int64 m_NumExecuted;
+			int64 m_NumDropped;
+			int64 m_NumDeferred;
+			int64 m_LastDrainTime;
+			int64 m_MaxDrainTime;
+		};
+
+	private:
+		struct CSlot
+		{
+			volatile unsigned m_Sequence;
+			CGameServerCmd m_Cmd;
+		};
+
+		CSlot m_aSlots[SIZE];
+		volatile unsigned m_EnqueuePos;
+		volatile unsigned m_DequeuePos;
+		volatile unsigned m_NumDropped;
+		unsigned m_MaxDepth;
+		int64 m_NumExecuted;
+		int64 m_NumDeferred;
+		int64 m_LastDrainTime;
+		int64 m_MaxDrainTime;
+
+	public:
+		CGameServerCmdQueue();
+
+		// any thread, returns false if the queue is full
+		bool Push(int Type, int ClientID, int ChatCategory, const char* pText);
+		// main thread only, executes commands until the queue is empty or the budget is used
+		void Drain(IGameServer* pGameServer, int64 Budget);
+
+		void GetStats(CStats* pStats);
+		void ResetStats();
 	};
 
 private:
@@ -384,18 +539,20 @@ private:
 	
 #ifdef CONF_SQL
 public:
-	array<CGameServerCmd*> m_lGameServerCmds;
-	LOCK m_GameServerCmdLock;
+	CGameServerCmdQueue m_GameServerCmds;
 	LOCK m_ChallengeLock;
 	char m_aChallengeWinner[16];
 	int64 m_ChallengeRefreshTick;
 	int m_ChallengeType;
+	CLeaderboardCache m_LeaderboardCache;
 #endif
 
 	int m_TimeShiftUnit;
 
 public:
-	void AddGameServerCmd(CGameServerCmd* pCmd);
+	void AddChatTargetCmd(int ClientID, const char* pText);
+	void AddChatTargetLanguageCmd(int ClientID, int ChatCategory, const char* pText);
+	void AddMOTDCmd(int ClientID, const char* pText);
 	
 	virtual CRoundStatistics* RoundStatistics() { return &m_RoundStatistics; }
 	virtual void OnRoundStart();
@@ -425,7 +582,9 @@ public:
 	unsigned m_AnnouncementLastLine;
 
 	virtual int* GetIdMap(int ClientID);
+	virtual int* GetReverseIdMap(int ClientID);
 	virtual void SetCustClt(int ClientID);
+	virtual bool IsCustClt(int ClientID) const;
 };
 
 #endif
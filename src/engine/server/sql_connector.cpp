@@ -11,6 +11,16 @@ int CSqlConnector::ms_ReachableWriteServer = 0;
 
 CSqlConnector::CSqlConnector() :
 m_pSqlServer(0),
+m_ppSqlReadServers(ms_ppSqlReadServers),
+m_ppSqlWriteServers(ms_ppSqlWriteServers),
+m_NumReadRetries(0),
+m_NumWriteRetries(0)
+{}
+
+CSqlConnector::CSqlConnector(CSqlServer** ppReadServers, CSqlServer** ppWriteServers) :
+m_pSqlServer(0),
+m_ppSqlReadServers(ppReadServers),
+m_ppSqlWriteServers(ppWriteServers),
 m_NumReadRetries(0),
 m_NumWriteRetries(0)
 {}
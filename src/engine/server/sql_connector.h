@@ -14,8 +14,10 @@ class CSqlConnector
 {
 public:
 	CSqlConnector();
+	// connects through the given servers instead of the shared ones, used by the sql workers
+	CSqlConnector(CSqlServer** ppReadServers, CSqlServer** ppWriteServers);
 
-	CSqlServer* SqlServer(int i, bool ReadOnly = true) { return ReadOnly ? ms_ppSqlReadServers[i] : ms_ppSqlWriteServers[i]; }
+	CSqlServer* SqlServer(int i, bool ReadOnly = true) { return ReadOnly ? m_ppSqlReadServers[i] : m_ppSqlWriteServers[i]; }
 
 	// always returns the last connected sql-server
 	CSqlServer* SqlServer() { return m_pSqlServer; }
@@ -23,6 +25,9 @@ public:
 	static void SetReadServers(CSqlServer** ppReadServers) { ms_ppSqlReadServers = ppReadServers; }
 	static void SetWriteServers(CSqlServer** ppWriteServers) { ms_ppSqlWriteServers = ppWriteServers; }
 
+	static CSqlServer** ReadServers() { return ms_ppSqlReadServers; }
+	static CSqlServer** WriteServers() { return ms_ppSqlWriteServers; }
+
 	static void ResetReachable() { ms_ReachableReadServer = 0; ms_ReachableWriteServer = 0; }
 
 	bool ConnectSqlServer(bool ReadOnly = true);
@@ -32,6 +37,8 @@ public:
 private:
 
 	CSqlServer *m_pSqlServer;
+	CSqlServer **m_ppSqlReadServers;
+	CSqlServer **m_ppSqlWriteServers;
 	static CSqlServer **ms_ppSqlReadServers;
 	static CSqlServer **ms_ppSqlWriteServers;
 
@@ -1,22 +1,33 @@
 #ifdef CONF_SQL
+#include <base/math.h>
+#include <engine/shared/config.h>
+
 #include "sql_job.h"
 
+CSqlJob::CSqlJob() :
+	m_ReadOnly(false),
+	m_Priority(PRIORITY_NORMAL),
+	m_QueueTime(0)
+{
+	
+}
+
 CSqlJob::~CSqlJob()
 {
 	
 }
 
-void CSqlJob::StartReadOnly()
+void CSqlJob::StartReadOnly(int Priority)
 {
-	Start(true);
+	Start(true, Priority);
 }
 
-void CSqlJob::Start(bool ReadOnly)
+void CSqlJob::Start(bool ReadOnly, int Priority)
 {
 	m_ReadOnly = ReadOnly;
+	m_Priority = clamp(Priority, (int)PRIORITY_HIGH, NUM_PRIORITIES-1);
 	
-	void *registerThread = thread_init(CSqlJob::Exec, this);
-	thread_detach(registerThread);
+	CSqlJobPool::Push(this);
 }
 
 void CSqlJob::AddQueuedJob(CSqlJob* pJob)
@@ -24,33 +35,226 @@ void CSqlJob::AddQueuedJob(CSqlJob* pJob)
 	m_QueuedJobs.add(pJob);
 }
 	
-void CSqlJob::Exec(void* pDataSelf)
+void CSqlJob::Exec(CSqlConnector* pConnector)
 {
-	CSqlJob* pSelf = (CSqlJob*) pDataSelf;
-	
-	CSqlConnector connector;
-
 	bool Success = false;
 
 	// try to connect to a working databaseserver
-	while (!Success && !connector.MaxTriesReached(pSelf->m_ReadOnly) && connector.ConnectSqlServer(pSelf->m_ReadOnly))
+	while (!Success && !pConnector->MaxTriesReached(m_ReadOnly) && pConnector->ConnectSqlServer(m_ReadOnly))
 	{
-		if(pSelf->Job(connector.SqlServer()))
+		if(Job(pConnector->SqlServer()))
 			Success = true;
 
 		// disconnect from databaseserver
-		connector.SqlServer()->Disconnect();
+		pConnector->SqlServer()->Disconnect();
 	}
 	
-	pSelf->CleanInstanceRef();
+	CleanInstanceRef();
 	
-	for(int i=0; i<pSelf->m_QueuedJobs.size(); i++)
+	// the queued jobs run with the priority of their parent
+	for(int i=0; i<m_QueuedJobs.size(); i++)
+	{
+		m_QueuedJobs[i]->ProcessParentData(GenerateChildData());
+		m_QueuedJobs[i]->Start(false, m_Priority);
+	}
+
+	delete this;
+}
+
+LOCK CSqlJobPool::ms_Lock = 0;
+SEMAPHORE CSqlJobPool::ms_Semaphore;
+bool CSqlJobPool::ms_Stop = false;
+int CSqlJobPool::ms_NumWorkers = 0;
+CSqlJobPool::CWorker CSqlJobPool::ms_aWorkers[MAX_WORKERS];
+CSqlJobPool::CQueue CSqlJobPool::ms_aQueues[CSqlJob::NUM_PRIORITIES];
+CSqlJobPool::CStats CSqlJobPool::ms_Stats;
+
+static void DropJob(CSqlJob* pJob)
+{
+	pJob->CleanInstanceRef();
+	for(int i=0; i<pJob->m_QueuedJobs.size(); i++)
+		DropJob(pJob->m_QueuedJobs[i]);
+	delete pJob;
+}
+
+void CSqlJobPool::Init()
+{
+	// the first job is always started by the main thread, before any worker exists
+	ms_Lock = lock_create();
+	semaphore_init(&ms_Semaphore);
+	mem_zero(ms_aWorkers, sizeof(ms_aWorkers));
+	mem_zero(ms_aQueues, sizeof(ms_aQueues));
+	mem_zero(&ms_Stats, sizeof(ms_Stats));
+}
+
+bool CSqlJobPool::Push(CSqlJob* pJob)
+{
+	if(!ms_Lock)
+		Init();
+
+	lock_wait(ms_Lock);
+
+	CQueue *pQueue = &ms_aQueues[pJob->GetPriority()];
+	if(ms_Stop || pQueue->m_Num >= QUEUE_SIZE)
+	{
+		ms_Stats.m_aNumDropped[pJob->GetPriority()]++;
+		bool Stopped = ms_Stop;
+		lock_unlock(ms_Lock);
+
+		if(!Stopped)
+			dbg_msg("sql", "job queue is full, dropping the job (priority %d)", pJob->GetPriority());
+		DropJob(pJob);
+		return false;
+	}
+
+	pJob->SetQueueTime(time_get());
+	pQueue->m_apJobs[(pQueue->m_First + pQueue->m_Num) % QUEUE_SIZE] = pJob;
+	pQueue->m_Num++;
+
+	int NumWorkers = clamp(g_Config.m_SvSqlWorkers, 1, (int)MAX_WORKERS);
+	while(ms_NumWorkers < NumWorkers)
 	{
-		pSelf->m_QueuedJobs[i]->ProcessParentData(pSelf->GenerateChildData());
-		pSelf->m_QueuedJobs[i]->Start();
+		CWorker *pWorker = &ms_aWorkers[ms_NumWorkers];
+		pWorker->m_pThread = thread_init(WorkerThread, pWorker);
+		if(!pWorker->m_pThread)
+			break;
+		ms_NumWorkers++;
 	}
 
-	delete pSelf;
+	lock_unlock(ms_Lock);
+
+	semaphore_signal(&ms_Semaphore);
+	return true;
+}
+
+CSqlJob* CSqlJobPool::Pop()
+{
+	for(int p=0; p<CSqlJob::NUM_PRIORITIES; p++)
+	{
+		CQueue *pQueue = &ms_aQueues[p];
+		if(pQueue->m_Num > 0)
+		{
+			CSqlJob *pJob = pQueue->m_apJobs[pQueue->m_First];
+			pQueue->m_First = (pQueue->m_First + 1) % QUEUE_SIZE;
+			pQueue->m_Num--;
+			return pJob;
+		}
+	}
+	return 0;
+}
+
+void CSqlJobPool::SyncServers(CSqlServer** ppServers, CSqlServer** ppShared)
+{
+	// sqlservers can be added at any time, open our own connection to the new ones
+	for(int i=0; i<MAX_SQLSERVERS; i++)
+	{
+		if(!ppServers[i] && ppShared && ppShared[i])
+			ppServers[i] = new CSqlServer(ppShared[i]);
+	}
+}
+
+void CSqlJobPool::WorkerThread(void* pUser)
+{
+	CWorker *pWorker = (CWorker *)pUser;
+
+	while(1)
+	{
+		semaphore_wait(&ms_Semaphore);
+
+		lock_wait(ms_Lock);
+		if(ms_Stop)
+		{
+			lock_unlock(ms_Lock);
+			break;
+		}
+		CSqlJob *pJob = Pop();
+		lock_unlock(ms_Lock);
+
+		if(!pJob)
+			continue;
+
+		SyncServers(pWorker->m_apReadServers, CSqlConnector::ReadServers());
+		SyncServers(pWorker->m_apWriteServers, CSqlConnector::WriteServers());
+
+		int Priority = pJob->GetPriority();
+		int64 StartTime = time_get();
+		int64 WaitTime = StartTime - pJob->GetQueueTime();
+
+		CSqlConnector Connector(pWorker->m_apReadServers, pWorker->m_apWriteServers);
+		pJob->Exec(&Connector);
+
+		int64 ExecTime = time_get() - StartTime;
+
+		lock_wait(ms_Lock);
+		ms_Stats.m_aNumJobs[Priority]++;
+		ms_Stats.m_aWaitTime[Priority] += WaitTime;
+		ms_Stats.m_aExecTime[Priority] += ExecTime;
+		if(WaitTime > ms_Stats.m_aMaxWaitTime[Priority])
+			ms_Stats.m_aMaxWaitTime[Priority] = WaitTime;
+		if(ExecTime > ms_Stats.m_aMaxExecTime[Priority])
+			ms_Stats.m_aMaxExecTime[Priority] = ExecTime;
+		lock_unlock(ms_Lock);
+	}
+
+	for(int i=0; i<MAX_SQLSERVERS; i++)
+	{
+		if(pWorker->m_apReadServers[i])
+			delete pWorker->m_apReadServers[i];
+		if(pWorker->m_apWriteServers[i])
+			delete pWorker->m_apWriteServers[i];
+	}
+}
+
+void CSqlJobPool::Shutdown()
+{
+	if(!ms_Lock)
+		return;
+
+	lock_wait(ms_Lock);
+	ms_Stop = true;
+	CSqlJob *pJob;
+	while((pJob = Pop()))
+		DropJob(pJob);
+	int NumWorkers = ms_NumWorkers;
+	lock_unlock(ms_Lock);
+
+	for(int i=0; i<NumWorkers; i++)
+		semaphore_signal(&ms_Semaphore);
+	for(int i=0; i<NumWorkers; i++)
+		thread_wait(ms_aWorkers[i].m_pThread);
+
+	ms_NumWorkers = 0;
+
+	// late jobs create a new lock and get dropped, ms_Stop stays set
+	lock_destroy(ms_Lock);
+	semaphore_destroy(&ms_Semaphore);
+	ms_Lock = 0;
+}
+
+void CSqlJobPool::GetStats(CStats* pStats)
+{
+	if(!ms_Lock)
+	{
+		mem_zero(pStats, sizeof(*pStats));
+		return;
+	}
+
+	lock_wait(ms_Lock);
+	*pStats = ms_Stats;
+	pStats->m_NumWorkers = ms_NumWorkers;
+	for(int p=0; p<CSqlJob::NUM_PRIORITIES; p++)
+		pStats->m_aQueued[p] = ms_aQueues[p].m_Num;
+	lock_unlock(ms_Lock);
+}
+
+void CSqlJobPool::ResetStats()
+{
+	if(!ms_Lock)
+		return;
+
+	lock_wait(ms_Lock);
+	mem_zero(&ms_Stats, sizeof(ms_Stats));
+	lock_unlock(ms_Lock);
 }
 
 #endif
@@ -8,19 +8,31 @@
 
 class CSqlJob
 {
+public:
+	enum
+	{
+		PRIORITY_HIGH=0, // a player is waiting for the answer (login, register)
+		PRIORITY_NORMAL,
+		PRIORITY_LOW, // statistics
+		NUM_PRIORITIES,
+	};
+
 protected:
 	bool m_ReadOnly;
 	int m_Instance;
+	int m_Priority;
+	int64 m_QueueTime;
 
 public:
 	array<CSqlJob*> m_QueuedJobs;
 	
 public:
+	CSqlJob();
 	virtual ~CSqlJob();
 
-	void StartReadOnly();
-	void Start(bool ReadOnly=false);
-	static void Exec(void* pDataSelf);
+	void StartReadOnly(int Priority=PRIORITY_NORMAL);
+	void Start(bool ReadOnly=false, int Priority=PRIORITY_NORMAL);
+	void Exec(CSqlConnector* pConnector);
 	
 	void AddQueuedJob(CSqlJob* pJob);
 	virtual void* GenerateChildData() { return 0x0; };
@@ -30,6 +42,69 @@ public:
 	virtual void CleanInstanceRef() {}
 	
 	int GetInstance() { return m_Instance; }
+	int GetPriority() const { return m_Priority; }
+	int64 GetQueueTime() const { return m_QueueTime; }
+	void SetQueueTime(int64 Time) { m_QueueTime = Time; }
+};
+
+// fixed set of threads running the sql jobs, each one keeps its own connections open
+class CSqlJobPool
+{
+public:
+	enum
+	{
+		MAX_WORKERS=16,
+		QUEUE_SIZE=1024,
+	};
+
+	struct CStats
+	{
+		int m_NumWorkers;
+		int m_aQueued[CSqlJob::NUM_PRIORITIES];
+		int64 m_aNumJobs[CSqlJob::NUM_PRIORITIES];
+		int64 m_aNumDropped[CSqlJob::NUM_PRIORITIES];
+		int64 m_aWaitTime[CSqlJob::NUM_PRIORITIES];
+		int64 m_aMaxWaitTime[CSqlJob::NUM_PRIORITIES];
+		int64 m_aExecTime[CSqlJob::NUM_PRIORITIES];
+		int64 m_aMaxExecTime[CSqlJob::NUM_PRIORITIES];
+	};
+
+	// takes the ownership of the job, returns false if the queue was full and the job got deleted
+	static bool Push(CSqlJob* pJob);
+	// waits for the running jobs and drops the queued ones
+	static void Shutdown();
+
+	static void GetStats(CStats* pStats);
+	static void ResetStats();
+
+private:
+	class CWorker
+	{
+	public:
+		void *m_pThread;
+		CSqlServer *m_apReadServers[MAX_SQLSERVERS];
+		CSqlServer *m_apWriteServers[MAX_SQLSERVERS];
+	};
+
+	struct CQueue
+	{
+		CSqlJob *m_apJobs[QUEUE_SIZE];
+		int m_First;
+		int m_Num;
+	};
+
+	static LOCK ms_Lock;
+	static SEMAPHORE ms_Semaphore;
+	static bool ms_Stop;
+	static int ms_NumWorkers;
+	static CWorker ms_aWorkers[MAX_WORKERS];
+	static CQueue ms_aQueues[CSqlJob::NUM_PRIORITIES];
+	static CStats ms_Stats;
+
+	static void Init();
+	static CSqlJob* Pop();
+	static void SyncServers(CSqlServer** ppServers, CSqlServer** ppShared);
+	static void WorkerThread(void* pUser);
 };
 
 #endif
@@ -0,0 +1,167 @@
+#ifdef CONF_SQL
+#include <base/system.h>
+
+#include "sql_roundscores.h"
+
+CSqlRoundScores::CSqlRoundScores(const char* pMapName, int NumPlayersMin, int NumPlayersMax, int NumWinners, int RoundDuration)
+{
+	m_sMapName = CSqlString<64>(pMapName);
+	m_NumPlayersMin = NumPlayersMin;
+	m_NumPlayersMax = NumPlayersMax;
+	m_NumWinners = NumWinners;
+	m_RoundDuration = RoundDuration;
+	m_RoundID = -1;
+}
+
+void CSqlRoundScores::AddPlayer(int UserID)
+{
+	CPlayer Player;
+	Player.m_UserID = UserID;
+	Player.m_OldScore = 0;
+	Player.m_NewScore = 0;
+	m_Players.add(Player);
+}
+
+void CSqlRoundScores::AddScore(int UserID, int ScoreType, int Score)
+{
+	if(Score <= 0)
+		return;
+
+	CScoreRow Row;
+	Row.m_UserID = UserID;
+	Row.m_ScoreType = ScoreType;
+	Row.m_Score = Score;
+	m_ScoreRows.add(Row);
+}
+
+CSqlRoundScores::CPlayer* CSqlRoundScores::FindPlayer(int UserID)
+{
+	for(int i=0; i<m_Players.size(); i++)
+	{
+		if(m_Players[i].m_UserID == UserID)
+			return &m_Players[i];
+	}
+	return 0;
+}
+
+//Sum of the best SQL_SCORE_NUMROUND round scores of the players on this map. Each player
+//gets a subquery limited to these rounds, so the cost doesn't grow with the history
+void CSqlRoundScores::FetchScores(CSqlServer* pSqlServer, bool NewScore)
+{
+	char aBuf[8192];
+	aBuf[0] = 0;
+
+	for(int i=0; i<m_Players.size(); i++)
+	{
+		if(aBuf[0] == 0)
+			str_copy(aBuf, "SELECT UserId, SUM(Score) AS Score FROM (", sizeof(aBuf));
+		else
+			str_append(aBuf, " UNION ALL ", sizeof(aBuf));
+
+		char aSubquery[512];
+		str_format(aSubquery, sizeof(aSubquery),
+			"(SELECT UserId, Score FROM %s_infc_RoundScore "
+			"WHERE UserId = '%d' AND MapName = '%s' AND ScoreType = '%d' "
+			"ORDER BY Score DESC LIMIT %d)"
+			, pSqlServer->GetPrefix(), m_Players[i].m_UserID, m_sMapName.ClrStr(), SQL_SCORETYPE_ROUND_SCORE, SQL_SCORE_NUMROUND);
+		str_append(aBuf, aSubquery, sizeof(aBuf));
+
+		if(i < m_Players.size()-1 && str_length(aBuf) + (int)sizeof(aSubquery) < (int)sizeof(aBuf))
+			continue;
+
+		str_append(aBuf, ") AS BestScores GROUP BY UserId", sizeof(aBuf));
+		pSqlServer->executeSqlQuery(aBuf);
+		aBuf[0] = 0;
+
+		while(pSqlServer->GetResults()->next())
+		{
+			CPlayer* pPlayer = FindPlayer((int)pSqlServer->GetResults()->getInt("UserId"));
+			if(pPlayer)
+				(NewScore ? pPlayer->m_NewScore : pPlayer->m_OldScore) = (int)pSqlServer->GetResults()->getInt("Score");
+		}
+	}
+}
+
+//Multi-row inserts, flushed before the buffer could overflow
+void CSqlRoundScores::InsertScores(CSqlServer* pSqlServer)
+{
+	char aBuf[8192];
+	aBuf[0] = 0;
+
+	for(int i=0; i<m_ScoreRows.size(); i++)
+	{
+		if(aBuf[0] == 0)
+		{
+			str_format(aBuf, sizeof(aBuf),
+				"INSERT INTO %s_infc_RoundScore "
+				"(UserId, RoundId, MapName, ScoreType, ScoreDate, Score) "
+				"VALUES "
+				, pSqlServer->GetPrefix());
+		}
+		else
+			str_append(aBuf, ", ", sizeof(aBuf));
+
+		char aRow[256];
+		str_format(aRow, sizeof(aRow), "('%d', '%d', '%s', '%d', UTC_TIMESTAMP(), '%d')",
+			m_ScoreRows[i].m_UserID, m_RoundID, m_sMapName.ClrStr(), m_ScoreRows[i].m_ScoreType, m_ScoreRows[i].m_Score);
+		str_append(aBuf, aRow, sizeof(aBuf));
+
+		if(i == m_ScoreRows.size()-1 || str_length(aBuf) + (int)sizeof(aRow) >= (int)sizeof(aBuf))
+		{
+			pSqlServer->executeSql(aBuf);
+			aBuf[0] = 0;
+		}
+	}
+}
+
+bool CSqlRoundScores::Write(CSqlServer* pSqlServer)
+{
+	char aBuf[512];
+
+	try
+	{
+		//Everything of the round is written at once, or nothing if a server fails in between
+		pSqlServer->executeSql("START TRANSACTION");
+
+		str_format(aBuf, sizeof(aBuf),
+			"INSERT INTO %s_infc_Rounds "
+			"(MapName, NumPlayersMin, NumPlayersMax, NumWinners, RoundDate, RoundDuration) "
+			"VALUES "
+			"('%s', '%d', '%d', '%d', UTC_TIMESTAMP(), '%d')"
+			, pSqlServer->GetPrefix(), m_sMapName.ClrStr(), m_NumPlayersMin, m_NumPlayersMax, m_NumWinners, m_RoundDuration);
+		pSqlServer->executeSql(aBuf);
+
+		m_RoundID = -1;
+		pSqlServer->executeSqlQuery("SELECT LAST_INSERT_ID() AS RoundId");
+		if(pSqlServer->GetResults()->next())
+			m_RoundID = (int)pSqlServer->GetResults()->getInt("RoundId");
+
+		if(m_RoundID >= 0 && m_ScoreRows.size())
+		{
+			FetchScores(pSqlServer, false);
+			InsertScores(pSqlServer);
+			FetchScores(pSqlServer, true);
+		}
+
+		pSqlServer->executeSql("COMMIT");
+	}
+	catch (sql::SQLException &e)
+	{
+		dbg_msg("sql", "Can't send round statistics (MySQL Error: %s)", e.what());
+
+		try
+		{
+			pSqlServer->executeSql("ROLLBACK");
+		}
+		catch (sql::SQLException &e)
+		{
+			dbg_msg("sql", "Can't rollback round statistics (MySQL Error: %s)", e.what());
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+#endif
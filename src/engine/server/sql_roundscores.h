@@ -0,0 +1,61 @@
+#ifdef CONF_SQL
+#ifndef ENGINE_SERVER_SQL_ROUNDSCORES_H
+#define ENGINE_SERVER_SQL_ROUNDSCORES_H
+
+#include <base/tl/array.h>
+#include "sql_string_helpers.h"
+#include "sql_server.h"
+
+// writes a round and the score rows of all its players in one transaction
+class CSqlRoundScores
+{
+public:
+	struct CPlayer
+	{
+		int m_UserID;
+		int m_OldScore; // sum of the best SQL_SCORE_NUMROUND round scores before the round
+		int m_NewScore; // the same sum, with the round
+	};
+
+	struct CScoreRow
+	{
+		int m_UserID;
+		int m_ScoreType;
+		int m_Score;
+	};
+
+private:
+	CSqlString<64> m_sMapName;
+	int m_NumPlayersMin;
+	int m_NumPlayersMax;
+	int m_NumWinners;
+	int m_RoundDuration;
+	int m_RoundID;
+
+	array<CPlayer> m_Players;
+	array<CScoreRow> m_ScoreRows;
+
+	void FetchScores(CSqlServer* pSqlServer, bool NewScore);
+	void InsertScores(CSqlServer* pSqlServer);
+
+public:
+	CSqlRoundScores(const char* pMapName, int NumPlayersMin, int NumPlayersMax, int NumWinners, int RoundDuration);
+
+	void AddPlayer(int UserID);
+	// only positive scores are written
+	void AddScore(int UserID, int ScoreType, int Score);
+
+	// returns false and rolls back if a query failed
+	bool Write(CSqlServer* pSqlServer);
+
+	const char* MapName() const { return m_sMapName.Str(); }
+	int RoundID() const { return m_RoundID; }
+	int NumPlayers() const { return m_Players.size(); }
+	const CPlayer* GetPlayer(int Index) const { return &m_Players[Index]; }
+	int NumScoreRows() const { return m_ScoreRows.size(); }
+	const CScoreRow* GetScoreRow(int Index) const { return &m_ScoreRows[Index]; }
+	CPlayer* FindPlayer(int UserID);
+};
+
+#endif
+#endif
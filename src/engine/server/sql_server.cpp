@@ -29,6 +29,24 @@ CSqlServer::CSqlServer(const char* pDatabase, const char* pPrefix, const char* p
 	m_SqlLock = lock_create();
 }
 
+CSqlServer::CSqlServer(const CSqlServer* pOther) :
+		m_Port(pOther->m_Port),
+		m_SetUpDB(false)
+{
+	str_copy(m_aDatabase, pOther->m_aDatabase, sizeof(m_aDatabase));
+	str_copy(m_aPrefix, pOther->m_aPrefix, sizeof(m_aPrefix));
+	str_copy(m_aUser, pOther->m_aUser, sizeof(m_aUser));
+	str_copy(m_aPass, pOther->m_aPass, sizeof(m_aPass));
+	str_copy(m_aIp, pOther->m_aIp, sizeof(m_aIp));
+
+	m_pDriver = 0;
+	m_pConnection = 0;
+	m_pResults = 0;
+	m_pStatement = 0;
+
+	m_SqlLock = lock_create();
+}
+
 CSqlServer::~CSqlServer()
 {
 	Lock();
@@ -36,6 +54,8 @@ CSqlServer::~CSqlServer()
 	{
 		if (m_pResults)
 			delete m_pResults;
+		if (m_pStatement)
+			delete m_pStatement;
 		if (m_pConnection)
 			delete m_pConnection;
 		dbg_msg("sql", "SQL connection disconnected");
@@ -62,12 +82,13 @@ bool CSqlServer::Connect()
 		catch (sql::SQLException &e)
 		{
 			dbg_msg("sql", "MySQL Error: %s", e.what());
+			dbg_msg("sql", "SQL connection lost, reconnecting");
 
-			dbg_msg("sql", "ERROR: SQL connection failed");
-			UnLock();
-			return false;
+			// the old connection is broken, open a new one below
+			DropConnection();
 		}
-		return true;
+		if (m_pConnection)
+			return true;
 	}
 
 	try
@@ -110,6 +131,7 @@ bool CSqlServer::Connect()
 	{
 		dbg_msg("sql", "MySQL Error: %s", e.what());
 		dbg_msg("sql", "ERROR: sql connection failed");
+		DropConnection();
 		UnLock();
 		return false;
 	}
@@ -159,6 +181,27 @@ void CSqlServer::Disconnect()
 	UnLock();
 }
 
+void CSqlServer::DropConnection()
+{
+	try
+	{
+		if (m_pResults)
+			delete m_pResults;
+		if (m_pStatement)
+			delete m_pStatement;
+		if (m_pConnection)
+			delete m_pConnection;
+	}
+	catch (sql::SQLException &e)
+	{
+		dbg_msg("sql", "MySQL Error: %s", e.what());
+	}
+
+	m_pResults = 0;
+	m_pStatement = 0;
+	m_pConnection = 0;
+}
+
 void CSqlServer::CreateTables()
 {
 	if (!Connect())
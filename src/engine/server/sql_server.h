@@ -56,6 +56,8 @@ class CSqlServer
 {
 public:
 	CSqlServer(const char* pDatabase, const char* pPrefix, const char* pUser, const char* pPass, const char* pIp, int Port, bool ReadOnly = true, bool SetUpDb = false);
+	// own connection to the same server for a sql worker, not counted as an extra server
+	explicit CSqlServer(const CSqlServer* pOther);
 	~CSqlServer();
 
 	bool Connect();
@@ -97,6 +99,8 @@ private:
 	bool m_SetUpDB;
 
 	LOCK m_SqlLock;
+
+	void DropConnection();
 };
 
 #endif
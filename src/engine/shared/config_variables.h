@@ -30,7 +30,11 @@ MACRO_CONFIG_INT(SvAutoDemoRecord, sv_auto_demo_record, 0, 0, 1, CFGFLAG_SERVER,
 MACRO_CONFIG_INT(SvAutoDemoAddMapName, sv_auto_demo_add_map_name, 0, 0, 1, CFGFLAG_SERVER, "Add map name to auto demo file when no max demo number limit")
 MACRO_CONFIG_INT(SvAutoDemoMinPlayers, sv_auto_demo_min_players, 4, 2, 16, CFGFLAG_SERVER, "Min active players for automatically record demos")
 MACRO_CONFIG_INT(SvAutoDemoMax, sv_auto_demo_max, 10, 0, 1000, CFGFLAG_SERVER, "Maximum number of automatically recorded demos (0 = no limit)")
-MACRO_CONFIG_INT(SvServerInfoPerSecond, sv_server_info_per_second, 10, 1, 1000, CFGFLAG_SERVER, "Maximum number of complete server info responses that are sent out per second")
+MACRO_CONFIG_INT(SvServerInfoPerSecond, sv_server_info_per_second, 100, 1, 1000, CFGFLAG_SERVER, "Maximum number of complete server info responses that are sent out per second")
+MACRO_CONFIG_INT(SvAsyncMapLoad, sv_async_map_load, 1, 0, 1, CFGFLAG_SERVER, "Load and convert a new map on a background thread while the current one keeps running")
+MACRO_CONFIG_INT(SvSnapThreads, sv_snap_threads, 0, 0, 16, CFGFLAG_SERVER, "Number of threads that create snapshot deltas and compress them (0 = on the main thread)")
+MACRO_CONFIG_INT(SvSqlWorkers, sv_sql_workers, 2, 1, 16, CFGFLAG_SERVER, "Number of threads running the sql queries, each one keeps its own database connections")
+MACRO_CONFIG_INT(SvSqlResultBudget, sv_sql_result_budget, 1000, 100, 20000, CFGFLAG_SERVER, "Time in microseconds the main thread may spend per tick on the results of sql jobs, the rest waits for the next tick")
 
 MACRO_CONFIG_STR(EcBindaddr, ec_bindaddr, 128, "localhost", CFGFLAG_ECON, "Address to bind the external console to. Anything but 'localhost' is dangerous")
 MACRO_CONFIG_INT(EcPort, ec_port, 0, 0, 0, CFGFLAG_ECON, "Port to use for the external console")
@@ -44,6 +48,9 @@ MACRO_CONFIG_INT(DbgStress, dbg_stress, 0, 0, 0, CFGFLAG_SERVER, "Stress systems
 MACRO_CONFIG_INT(DbgStressNetwork, dbg_stress_network, 0, 0, 0, CFGFLAG_SERVER, "Stress network")
 MACRO_CONFIG_INT(DbgPref, dbg_pref, 0, 0, 1, CFGFLAG_SERVER, "Performance outputs")
 MACRO_CONFIG_INT(DbgHitch, dbg_hitch, 0, 0, 0, CFGFLAG_SERVER, "Hitch warnings")
+MACRO_CONFIG_INT(DbgAsyncLog, dbg_async_log, 1, 0, 1, CFGFLAG_SERVER, "Write log lines from a separate thread")
+MACRO_CONFIG_INT(DbgLogFlushInterval, dbg_log_flush_interval, 50, 0, 5000, CFGFLAG_SERVER, "Milliseconds between flushes of the log output when dbg_async_log is on")
+MACRO_CONFIG_INT(DbgLogBlock, dbg_log_block, 1, 0, 1, CFGFLAG_SERVER, "Wait instead of dropping lines when the log buffer is full")
 
 MACRO_CONFIG_STR(SvBroadcast, sv_broadcast, 64, "DDRace.info Trunk 0.5", CFGFLAG_SERVER, "The broadcasting message")
 
@@ -13,6 +13,7 @@ public:
 	~CDataFileReader() { Close(); }
 
 	bool IsOpen() const { return m_pDataFile != 0; }
+	void Swap(CDataFileReader &Other) { struct CDatafile *pTmp = m_pDataFile; m_pDataFile = Other.m_pDataFile; Other.m_pDataFile = pTmp; }
 
 	bool Open(class IStorage *pStorage, const char *pFilename, int StorageType);
 	bool Close();
@@ -35,6 +35,19 @@ public:
 		return true;
 	}
 
+	static bool Con_DbgLogStats(IConsole::IResult *pResult, void *pUserData)
+	{
+		CEngine *pEngine = static_cast<CEngine *>(pUserData);
+		LOGSTATS Stats;
+		dbg_logger_async_stats(&Stats);
+		char aBuf[256];
+		str_format(aBuf, sizeof(aBuf), "queued=%u written=%u dropped=%u blocked=%u flushes=%u",
+			Stats.queued, Stats.written, Stats.dropped, Stats.blocked, Stats.flushes);
+		pEngine->m_pConsole->Print(IConsole::OUTPUT_LEVEL_STANDARD, "engine", aBuf);
+
+		return true;
+	}
+
 	static bool Con_DbgLognetwork(IConsole::IResult *pResult, void *pUserData)
 	{
 		CEngine *pEngine = static_cast<CEngine *>(pUserData);
@@ -93,6 +106,7 @@ public:
 
 		m_pConsole->Register("dbg_dumpmem", "", CFGFLAG_SERVER|CFGFLAG_CLIENT, Con_DbgDumpmem, this, "Dump the memory");
 		m_pConsole->Register("dbg_lognetwork", "", CFGFLAG_SERVER|CFGFLAG_CLIENT, Con_DbgLognetwork, this, "Log the network");
+		m_pConsole->Register("dbg_logstats", "", CFGFLAG_SERVER|CFGFLAG_CLIENT, Con_DbgLogStats, this, "Show the counters of the asynchronous logger");
 	}
 
 	void InitLogfile()
@@ -100,6 +114,9 @@ public:
 		// open logfile if needed
 		if(g_Config.m_Logfile[0])
 			dbg_logger_file(g_Config.m_Logfile);
+
+		if(g_Config.m_DbgAsyncLog)
+			dbg_logger_async_start(g_Config.m_DbgLogFlushInterval, g_Config.m_DbgLogBlock);
 	}
 
 	void HostLookup(CHostLookup *pLookup, const char *pHostname, int Nettype)
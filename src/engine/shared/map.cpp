@@ -26,7 +26,11 @@ public:
 
 	virtual bool Load(const char *pMapName)
 	{
-		IStorage *pStorage = Kernel()->RequestInterface<IStorage>();
+		return Load(Kernel()->RequestInterface<IStorage>(), pMapName);
+	}
+
+	virtual bool Load(IStorage *pStorage, const char *pMapName)
+	{
 		if(!pStorage)
 			return false;
 		return m_DataFile.Open(pStorage, pMapName, IStorage::TYPE_ALL);
@@ -41,6 +45,11 @@ public:
 	{
 		return m_DataFile.Crc();
 	}
+
+	virtual void Swap(IEngineMap *pOther)
+	{
+		m_DataFile.Swap(static_cast<CMap *>(pOther)->m_DataFile);
+	}
 };
 
 extern IEngineMap *CreateEngineMap() { return new CMap; }
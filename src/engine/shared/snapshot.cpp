@@ -376,110 +376,171 @@ int CSnapshotDelta::UnpackDelta(CSnapshot *pFrom, CSnapshot *pTo, void *pSrcData
 
 // CSnapshotStorage
 
+CSnapshotStorage::CSnapshotStorage()
+{
+	m_pHolders = 0;
+	m_HolderCapacity = 0;
+	m_pData = 0;
+	m_DataCapacity = 0;
+	Init();
+}
+
+CSnapshotStorage::~CSnapshotStorage()
+{
+	if(m_pHolders)
+		mem_free(m_pHolders);
+	if(m_pData)
+		mem_free(m_pData);
+}
+
 void CSnapshotStorage::Init()
 {
-	m_pFirst = 0;
-	m_pLast = 0;
+	// the arena is kept around, it is only allocated on the first add
+	m_FirstHolder = 0;
+	m_NumHolders = 0;
+	m_RetainedBytes = 0;
 }
 
 void CSnapshotStorage::PurgeAll()
 {
-	CHolder *pHolder = m_pFirst;
-	CHolder *pNext;
+	// no more snapshots in storage
+	m_FirstHolder = 0;
+	m_NumHolders = 0;
+	m_RetainedBytes = 0;
+}
 
-	while(pHolder)
+void CSnapshotStorage::PurgeUntil(int Tick)
+{
+	while(m_NumHolders)
 	{
-		pNext = pHolder->m_pNext;
-		mem_free(pHolder);
-		pHolder = pNext;
+		CHolder *pHolder = GetHolder(0);
+		if(pHolder->m_Tick >= Tick)
+			return; // no more to remove
+
+		m_RetainedBytes -= pHolder->m_AllocSize;
+		m_FirstHolder = (m_FirstHolder+1)&(m_HolderCapacity-1);
+		m_NumHolders--;
 	}
 
 	// no more snapshots in storage
-	m_pFirst = 0;
-	m_pLast = 0;
+	PurgeAll();
 }
 
-void CSnapshotStorage::PurgeUntil(int Tick)
+void CSnapshotStorage::GrowHolders()
 {
-	CHolder *pHolder = m_pFirst;
-	CHolder *pNext;
+	int NewCapacity = m_HolderCapacity ? m_HolderCapacity*2 : (int)INITIAL_HOLDERS;
+	CHolder *pNewHolders = (CHolder *)mem_alloc(NewCapacity*sizeof(CHolder), 1);
+
+	for(int i = 0; i < m_NumHolders; i++)
+		pNewHolders[i] = *GetHolder(i);
 
-	while(pHolder)
+	if(m_pHolders)
+		mem_free(m_pHolders);
+	m_pHolders = pNewHolders;
+	m_HolderCapacity = NewCapacity;
+	m_FirstHolder = 0;
+}
+
+void CSnapshotStorage::GrowData(int NeededSize)
+{
+	int NewCapacity = m_DataCapacity ? m_DataCapacity*2 : (int)INITIAL_DATA_SIZE;
+	while(NewCapacity < m_RetainedBytes+NeededSize)
+		NewCapacity *= 2;
+	char *pNewData = (char *)mem_alloc(NewCapacity, 8);
+
+	// compact the live entries to the start of the new arena
+	int Offset = 0;
+	for(int i = 0; i < m_NumHolders; i++)
 	{
-		pNext = pHolder->m_pNext;
-		if(pHolder->m_Tick >= Tick)
-			return; // no more to remove
-		mem_free(pHolder);
+		CHolder *pHolder = GetHolder(i);
+		mem_copy(pNewData+Offset, m_pData+pHolder->m_Offset, pHolder->m_AllocSize);
+		if(pHolder->m_AltOffset >= 0)
+			pHolder->m_AltOffset = Offset + (pHolder->m_AltOffset-pHolder->m_Offset);
+		pHolder->m_Offset = Offset;
+		Offset += pHolder->m_AllocSize;
+	}
 
-		// did we come to the end of the list?
-		if (!pNext)
-			break;
+	if(m_pData)
+		mem_free(m_pData);
+	m_pData = pNewData;
+	m_DataCapacity = NewCapacity;
+}
+
+int CSnapshotStorage::AllocData(int Size)
+{
+	if(!m_NumHolders)
+		return Size <= m_DataCapacity ? 0 : -1;
 
-		m_pFirst = pNext;
-		pNext->m_pPrev = 0x0;
+	CHolder *pFirst = GetHolder(0);
+	CHolder *pLast = GetHolder(m_NumHolders-1);
+	int Head = pFirst->m_Offset;
+	int Tail = pLast->m_Offset + pLast->m_AllocSize;
 
-		pHolder = pNext;
+	if(pLast->m_Offset >= Head)
+	{
+		// live data is contiguous, append or wrap around to the start
+		if(Tail+Size <= m_DataCapacity)
+			return Tail;
+		if(Size <= Head)
+			return 0;
 	}
+	else if(Tail+Size <= Head)
+		return Tail;
 
-	// no more snapshots in storage
-	m_pFirst = 0;
-	m_pLast = 0;
+	return -1;
 }
 
 void CSnapshotStorage::Add(int Tick, int64 Tagtime, int DataSize, void *pData, int CreateAlt)
 {
-	// allocate memory for holder + snapshot_data
-	int TotalSize = sizeof(CHolder)+DataSize;
+	int AlignedSize = (DataSize+7)&~7;
+	int AllocSize = CreateAlt ? AlignedSize*2 : AlignedSize;
 
-	if(CreateAlt)
-		TotalSize += DataSize;
+	if(m_NumHolders == m_HolderCapacity)
+		GrowHolders();
 
-	CHolder *pHolder = (CHolder *)mem_alloc(TotalSize, 1);
+	int Offset = AllocData(AllocSize);
+	if(Offset < 0)
+	{
+		GrowData(AllocSize);
+		Offset = AllocData(AllocSize);
+	}
 
 	// set data
+	CHolder *pHolder = GetHolder(m_NumHolders);
 	pHolder->m_Tick = Tick;
 	pHolder->m_Tagtime = Tagtime;
 	pHolder->m_SnapSize = DataSize;
-	pHolder->m_pSnap = (CSnapshot*)(pHolder+1);
-	mem_copy(pHolder->m_pSnap, pData, DataSize);
+	pHolder->m_Offset = Offset;
+	pHolder->m_AllocSize = AllocSize;
+	mem_copy(m_pData+Offset, pData, DataSize);
 
 	if(CreateAlt) // create alternative if wanted
 	{
-		pHolder->m_pAltSnap = (CSnapshot*)(((char *)pHolder->m_pSnap) + DataSize);
-		mem_copy(pHolder->m_pAltSnap, pData, DataSize);
+		pHolder->m_AltOffset = Offset+AlignedSize;
+		mem_copy(m_pData+pHolder->m_AltOffset, pData, DataSize);
 	}
 	else
-		pHolder->m_pAltSnap = 0;
-
+		pHolder->m_AltOffset = -1;
 
-	// link
-	pHolder->m_pNext = 0;
-	pHolder->m_pPrev = m_pLast;
-	if(m_pLast)
-		m_pLast->m_pNext = pHolder;
-	else
-		m_pFirst = pHolder;
-	m_pLast = pHolder;
+	m_NumHolders++;
+	m_RetainedBytes += AllocSize;
 }
 
 int CSnapshotStorage::Get(int Tick, int64 *pTagtime, CSnapshot **ppData, CSnapshot **ppAltData)
 {
-	CHolder *pHolder = m_pFirst;
-
-	while(pHolder)
+	for(int i = 0; i < m_NumHolders; i++)
 	{
+		CHolder *pHolder = GetHolder(i);
 		if(pHolder->m_Tick == Tick)
 		{
 			if(pTagtime)
 				*pTagtime = pHolder->m_Tagtime;
 			if(ppData)
-				*ppData = pHolder->m_pSnap;
+				*ppData = (CSnapshot *)(m_pData+pHolder->m_Offset);
 			if(ppAltData)
-				*ppAltData = pHolder->m_pAltSnap;
+				*ppAltData = pHolder->m_AltOffset >= 0 ? (CSnapshot *)(m_pData+pHolder->m_AltOffset) : 0;
 			return pHolder->m_SnapSize;
 		}
-
-		pHolder = pHolder->m_pNext;
 	}
 
 	return -1;
@@ -491,6 +552,7 @@ void CSnapshotBuilder::Init()
 {
 	m_DataSize = 0;
 	m_NumItems = 0;
+	m_Overflow = false;
 }
 
 CSnapshotItem *CSnapshotBuilder::GetItem(int Index)
@@ -498,6 +560,13 @@ CSnapshotItem *CSnapshotBuilder::GetItem(int Index)
 	return (CSnapshotItem *)&(m_aData[m_aOffsets[Index]]);
 }
 
+int CSnapshotBuilder::GetItemSize(int Index)
+{
+	if(Index == m_NumItems-1)
+		return (m_DataSize - m_aOffsets[Index]) - sizeof(CSnapshotItem);
+	return (m_aOffsets[Index+1] - m_aOffsets[Index]) - sizeof(CSnapshotItem);
+}
+
 int *CSnapshotBuilder::GetItemData(int Key)
 {
 	int i;
@@ -528,6 +597,7 @@ void *CSnapshotBuilder::NewItem(int Type, int ID, int Size)
 	{
 		dbg_assert(m_DataSize < CSnapshot::MAX_SIZE, "too much data");
 		dbg_assert(m_NumItems < MAX_ITEMS, "too many items");
+		m_Overflow = true;
 		return 0;
 	}
 
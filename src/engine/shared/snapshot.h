@@ -85,29 +85,59 @@ public:
 class CSnapshotStorage
 {
 public:
+	enum
+	{
+		// enough for the 3 second retention window at the highest snapshot rate
+		INITIAL_HOLDERS = 256,
+		INITIAL_DATA_SIZE = 256*1024,
+	};
+
 	class CHolder
 	{
 	public:
-		CHolder *m_pPrev;
-		CHolder *m_pNext;
-
 		int64 m_Tagtime;
 		int m_Tick;
 
 		int m_SnapSize;
-		CSnapshot *m_pSnap;
-		CSnapshot *m_pAltSnap;
+		int m_Offset;
+		int m_AltOffset; // -1 if no alternative snapshot was created
+		int m_AllocSize;
 	};
 
+private:
+	// fifo of holders, m_HolderCapacity is a power of two
+	CHolder *m_pHolders;
+	int m_HolderCapacity;
+	int m_FirstHolder;
+	int m_NumHolders;
+
+	// ring arena for the snapshot data, entries are stored in holder order
+	char *m_pData;
+	int m_DataCapacity;
+	int m_RetainedBytes;
 
-	CHolder *m_pFirst;
-	CHolder *m_pLast;
+	CHolder *GetHolder(int Index) { return &m_pHolders[(m_FirstHolder+Index)&(m_HolderCapacity-1)]; }
+	int AllocData(int Size);
+	void GrowHolders();
+	void GrowData(int NeededSize);
+
+	CSnapshotStorage(const CSnapshotStorage &Other);
+	CSnapshotStorage &operator =(const CSnapshotStorage &Other);
+
+public:
+	CSnapshotStorage();
+	~CSnapshotStorage();
 
 	void Init();
 	void PurgeAll();
 	void PurgeUntil(int Tick);
+	// the pointers returned by Get stay valid until the next Add or Purge call
 	void Add(int Tick, int64 Tagtime, int DataSize, void *pData, int CreateAlt);
 	int Get(int Tick, int64 *Tagtime, CSnapshot **pData, CSnapshot **ppAltData);
+
+	int NumSnapshots() const { return m_NumHolders; }
+	int RetainedBytes() const { return m_RetainedBytes; }
+	int ArenaSize() const { return m_DataCapacity + m_HolderCapacity*(int)sizeof(CHolder); }
 };
 
 class CSnapshotBuilder
@@ -123,12 +153,17 @@ class CSnapshotBuilder
 	int m_aOffsets[MAX_ITEMS];
 	int m_NumItems;
 
+	bool m_Overflow;
+
 public:
 	void Init();
 
 	void *NewItem(int Type, int ID, int Size);
 
+	int NumItems() const { return m_NumItems; }
+	bool Overflowed() const { return m_Overflow; }
 	CSnapshotItem *GetItem(int Index);
+	int GetItemSize(int Index);
 	int *GetItemData(int Key);
 
 	int Finish(void *Snapdata);
@@ -32,6 +32,9 @@ CCollision::~CCollision()
 		delete[] m_pPhysicsTiles;
 	
 	m_pPhysicsTiles = 0;
+
+	for(int i = 0; i < m_apZoneCaches.size(); i++)
+		delete m_apZoneCaches[i];
 }
 
 void CCollision::Init(class CLayers *pLayers)
@@ -75,14 +78,49 @@ bool CCollision::IsTileSolid(int x, int y)
 	return GetTile(x, y)&COLFLAG_SOLID;
 }
 
-// TODO: rewrite this smarter!
+// number of samples (at least one) that can be skipped along one axis before
+// the rounded coordinate may leave the tile column or row it is in now
+static int SamplesToTileBorder(float Coord, float Step, int NumTiles, int MaxSamples)
+{
+	// stay away from the border, the samples are computed with mix() and not by stepping
+	const float Margin = 0.1f;
+
+	int Tile = (int)floorf(round(Coord)/32.0f);
+	float Dist;
+	if(Step > 0.0f)
+	{
+		if(Tile >= NumTiles-1)
+			return MaxSamples; // everything further is clamped to the last tile
+		Dist = (Tile+1)*32-0.5f - Coord;
+	}
+	else if(Step < 0.0f)
+	{
+		if(Tile <= 0)
+			return MaxSamples; // everything further is clamped to the first tile
+		Dist = Coord - (Tile*32-0.5f);
+		Step = -Step;
+	}
+	else
+		return MaxSamples;
+
+	float Samples = (Dist-Margin)/Step;
+	if(Samples < 0.0f)
+		return 1;
+	if(Samples >= MaxSamples)
+		return MaxSamples;
+	return (int)Samples + 1;
+}
+
 int CCollision::IntersectLine(vec2 Pos0, vec2 Pos1, vec2 *pOutCollision, vec2 *pOutBeforeCollision)
 {
 	float Distance = distance(Pos0, Pos1);
 	int End(Distance+1);
-	vec2 Last = Pos0;
+	vec2 Step = Distance > 0.0f ? (Pos1-Pos0)/Distance : vec2(0.0f, 0.0f);
 
-	for(int i = 0; i < End; i++)
+	// the samples are the same as the ones of the old pixel by pixel walk,
+	// but the samples that stay inside an empty tile are skipped, so every
+	// tile on the line is only fetched once or twice
+	for(int i = 0; i < End;)
 	{
 		float a = i/Distance;
 		vec2 Pos = mix(Pos0, Pos1, a);
@@ -91,10 +129,18 @@ int CCollision::IntersectLine(vec2 Pos0, vec2 Pos1, vec2 *pOutCollision, vec2 *p
 			if(pOutCollision)
 				*pOutCollision = Pos;
 			if(pOutBeforeCollision)
-				*pOutBeforeCollision = Last;
+				*pOutBeforeCollision = i > 0 ? mix(Pos0, Pos1, (i-1)/Distance) : Pos0;
 			return GetCollisionAt(Pos.x, Pos.y);
 		}
-		Last = Pos;
+
+		if(Distance > 0.0f)
+		{
+			int Skip = SamplesToTileBorder(Pos.x, Step.x, m_PhysicsWidth, End-i);
+			Skip = min(Skip, SamplesToTileBorder(Pos.y, Step.y, m_PhysicsHeight, End-i));
+			i += Skip;
+		}
+		else
+			i++;
 	}
 	if(pOutCollision)
 		*pOutCollision = Pos1;
@@ -253,6 +299,8 @@ int CCollision::GetZoneHandle(const char* pName)
 		}
 	}
 	
+	m_apZoneCaches.add(BuildZoneCache(Handle));
+	
 	return Handle;
 }
 
@@ -315,6 +363,251 @@ static void Rotate(vec2 *pCenter, vec2 *pPoint, float Rotation)
 	pPoint->y = (x * sinf(Rotation) + y * cosf(Rotation) + pCenter->y);
 }
 
+bool CCollision::IsInsideZoneQuad(const CQuad *pQuad, float x, float y)
+{
+	vec2 Position(0.0f, 0.0f);
+	float Angle = 0.0f;
+	if(pQuad->m_PosEnv >= 0)
+	{
+		GetAnimationTransform(m_Time, pQuad->m_PosEnv, m_pLayers, Position, Angle);
+	}
+	
+	vec2 p0 = Position + vec2(fx2f(pQuad->m_aPoints[0].x), fx2f(pQuad->m_aPoints[0].y));
+	vec2 p1 = Position + vec2(fx2f(pQuad->m_aPoints[1].x), fx2f(pQuad->m_aPoints[1].y));
+	vec2 p2 = Position + vec2(fx2f(pQuad->m_aPoints[2].x), fx2f(pQuad->m_aPoints[2].y));
+	vec2 p3 = Position + vec2(fx2f(pQuad->m_aPoints[3].x), fx2f(pQuad->m_aPoints[3].y));
+	
+	if(Angle != 0)
+	{
+		vec2 center(fx2f(pQuad->m_aPoints[4].x), fx2f(pQuad->m_aPoints[4].y));
+		Rotate(&center, &p0, Angle);
+		Rotate(&center, &p1, Angle);
+		Rotate(&center, &p2, Angle);
+		Rotate(&center, &p3, Angle);
+	}
+	
+	return InsideQuad(p0, p1, p2, p3, vec2(x, y));
+}
+
+//Returns the area that a quad can cover over its whole animation
+void CCollision::GetZoneQuadBounds(const CQuad *pQuad, vec2 *pMin, vec2 *pMax)
+{
+	vec2 Min(fx2f(pQuad->m_aPoints[0].x), fx2f(pQuad->m_aPoints[0].y));
+	vec2 Max = Min;
+	for(int p = 1; p < 4; p++)
+	{
+		vec2 Point(fx2f(pQuad->m_aPoints[p].x), fx2f(pQuad->m_aPoints[p].y));
+		Min = vec2(min(Min.x, Point.x), min(Min.y, Point.y));
+		Max = vec2(max(Max.x, Point.x), max(Max.y, Point.y));
+	}
+	
+	if(pQuad->m_PosEnv >= 0)
+	{
+		//GetAnimationTransform only interpolates between the envelope points,
+		//and returns no offset before the first point or for a missing envelope
+		vec2 EnvMin(0.0f, 0.0f);
+		vec2 EnvMax(0.0f, 0.0f);
+		float EnvRadius = 0.0f;
+		bool Rotates = false;
+		
+		int PointsStart, PointsNum;
+		m_pLayers->Map()->GetType(MAPITEMTYPE_ENVPOINTS, &PointsStart, &PointsNum);
+		int Start, Num;
+		m_pLayers->Map()->GetType(MAPITEMTYPE_ENVELOPE, &Start, &Num);
+		if(pQuad->m_PosEnv < Num && PointsNum)
+		{
+			CEnvPoint *pPoints = (CEnvPoint *)m_pLayers->Map()->GetItem(PointsStart, 0, 0);
+			CMapItemEnvelope *pItem = (CMapItemEnvelope *)m_pLayers->Map()->GetItem(Start+pQuad->m_PosEnv, 0, 0);
+			pPoints += pItem->m_StartPoint;
+			for(int i = 0; i < pItem->m_NumPoints; i++)
+			{
+				vec2 Offset(fx2f(pPoints[i].m_aValues[0]), fx2f(pPoints[i].m_aValues[1]));
+				EnvRadius = max(EnvRadius, length(Offset));
+				EnvMin = vec2(min(EnvMin.x, Offset.x), min(EnvMin.y, Offset.y));
+				EnvMax = vec2(max(EnvMax.x, Offset.x), max(EnvMax.y, Offset.y));
+				if(pPoints[i].m_aValues[2] != 0)
+					Rotates = true;
+			}
+		}
+		
+		if(Rotates)
+		{
+			//The offset is added before rotating around the untranslated center,
+			//so it is rotated as well: the corners stay within the quad radius
+			//plus the largest offset from the center
+			vec2 Center(fx2f(pQuad->m_aPoints[4].x), fx2f(pQuad->m_aPoints[4].y));
+			float Radius = 0.0f;
+			for(int p = 0; p < 4; p++)
+				Radius = max(Radius, distance(Center, vec2(fx2f(pQuad->m_aPoints[p].x), fx2f(pQuad->m_aPoints[p].y))));
+			Radius += EnvRadius;
+			Min = Center - vec2(Radius, Radius);
+			Max = Center + vec2(Radius, Radius);
+		}
+		else
+		{
+			Min += EnvMin;
+			Max += EnvMax;
+		}
+	}
+	
+	*pMin = Min;
+	*pMax = Max;
+}
+
+CCollision::CZoneCache *CCollision::BuildZoneCache(int ZoneHandle)
+{
+	//A cell covers the positions that round to the same tile, [32*x-0.5, 32*x+31.5)
+	//The margin keeps the classification away from float noise at the borders
+	const float Margin = 1.0f;
+	
+	CZoneCache *pCache = new CZoneCache;
+	pCache->m_Width = m_PhysicsWidth;
+	pCache->m_Height = m_PhysicsHeight;
+	int NumCells = m_PhysicsWidth*m_PhysicsHeight;
+	
+	array<int> aOverride; //last layer or quad that sets the whole cell
+	pCache->m_Values.set_size(NumCells);
+	aOverride.set_size(NumCells);
+	pCache->m_CandidateStart.set_size(NumCells+1);
+	for(int c = 0; c < NumCells; c++)
+	{
+		pCache->m_Values[c] = 0;
+		aOverride[c] = -1;
+	}
+	for(int c = 0; c <= NumCells; c++)
+		pCache->m_CandidateStart[c] = 0;
+	
+	array<int> aCursor;
+	
+	//Pass 0 writes the values, pass 1 counts the candidates and pass 2 stores them.
+	//Layers and quads are walked in the order GetZoneValueAt applies them
+	for(int Pass = 0; Pass < 3; Pass++)
+	{
+		if(Pass == 2)
+		{
+			for(int c = 0; c < NumCells; c++)
+				pCache->m_CandidateStart[c+1] += pCache->m_CandidateStart[c];
+			pCache->m_Candidates.set_size(pCache->m_CandidateStart[NumCells]);
+			aCursor.set_size(NumCells);
+			for(int c = 0; c < NumCells; c++)
+				aCursor[c] = pCache->m_CandidateStart[c];
+		}
+		
+		int Seq = 0;
+		for(int i = 0; i < m_Zones[ZoneHandle].size(); i++)
+		{
+			int l = m_Zones[ZoneHandle][i];
+			CMapItemLayer *pLayer = m_pLayers->GetLayer(m_pLayers->ZoneGroup()->m_StartLayer+l);
+			if(pLayer->m_Type == LAYERTYPE_TILES)
+			{
+				if(Pass == 0)
+				{
+					CMapItemLayerTilemap *pTLayer = (CMapItemLayerTilemap *)pLayer;
+					CTile *pTiles = (CTile *) m_pLayers->Map()->GetData(pTLayer->m_Data);
+					for(int cy = 0; cy < m_PhysicsHeight; cy++)
+					{
+						for(int cx = 0; cx < m_PhysicsWidth; cx++)
+						{
+							int Nx = clamp(cx, 0, pTLayer->m_Width-1);
+							int Ny = clamp(cy, 0, pTLayer->m_Height-1);
+							int TileIndex = (pTiles[Ny*pTLayer->m_Width+Nx].m_Index > 128 ? 0 : pTiles[Ny*pTLayer->m_Width+Nx].m_Index);
+							if(TileIndex > 0)
+							{
+								pCache->m_Values[cy*m_PhysicsWidth+cx] = TileIndex;
+								aOverride[cy*m_PhysicsWidth+cx] = Seq;
+							}
+						}
+					}
+				}
+				Seq++;
+			}
+			else if(pLayer->m_Type == LAYERTYPE_QUADS)
+			{
+				CMapItemLayerQuads *pQLayer = (CMapItemLayerQuads *)pLayer;
+				const CQuad *pQuads = (const CQuad *) m_pLayers->Map()->GetDataSwapped(pQLayer->m_Data);
+				
+				for(int q = 0; q < pQLayer->m_NumQuads; q++, Seq++)
+				{
+					const CQuad *pQuad = &pQuads[q];
+					bool Static = pQuad->m_PosEnv < 0;
+					
+					vec2 aPoints[4];
+					for(int p = 0; p < 4; p++)
+						aPoints[p] = vec2(fx2f(pQuad->m_aPoints[p].x), fx2f(pQuad->m_aPoints[p].y));
+					
+					//InsideQuad splits the quad along 1-2, only convex ones can cover whole cells
+					bool Convex = false;
+					if(Static)
+					{
+						vec2 aOutline[4] = { aPoints[0], aPoints[1], aPoints[3], aPoints[2] };
+						int Positive = 0;
+						int Negative = 0;
+						for(int p = 0; p < 4; p++)
+						{
+							vec2 e0 = aOutline[(p+1)%4] - aOutline[p];
+							vec2 e1 = aOutline[(p+2)%4] - aOutline[(p+1)%4];
+							float Cross = e0.x*e1.y - e0.y*e1.x;
+							if(Cross > 0.0f) Positive++;
+							else if(Cross < 0.0f) Negative++;
+						}
+						Convex = (Positive == 4 || Negative == 4);
+					}
+					
+					vec2 Min, Max;
+					GetZoneQuadBounds(pQuad, &Min, &Max);
+					int MinX = clamp((int)floorf((Min.x-Margin+0.5f)/32.0f), 0, m_PhysicsWidth-1);
+					int MinY = clamp((int)floorf((Min.y-Margin+0.5f)/32.0f), 0, m_PhysicsHeight-1);
+					int MaxX = clamp((int)floorf((Max.x+Margin+0.5f)/32.0f), 0, m_PhysicsWidth-1);
+					int MaxY = clamp((int)floorf((Max.y+Margin+0.5f)/32.0f), 0, m_PhysicsHeight-1);
+					
+					for(int cy = MinY; cy <= MaxY; cy++)
+					{
+						for(int cx = MinX; cx <= MaxX; cx++)
+						{
+							int Cell = cy*m_PhysicsWidth+cx;
+							
+							bool Covered = false;
+							if(Convex)
+							{
+								float x0 = cx*32.0f-0.5f-Margin;
+								float y0 = cy*32.0f-0.5f-Margin;
+								float x1 = cx*32.0f+31.5f+Margin;
+								float y1 = cy*32.0f+31.5f+Margin;
+								Covered = InsideQuad(aPoints[0], aPoints[1], aPoints[2], aPoints[3], vec2(x0, y0))
+									&& InsideQuad(aPoints[0], aPoints[1], aPoints[2], aPoints[3], vec2(x1, y0))
+									&& InsideQuad(aPoints[0], aPoints[1], aPoints[2], aPoints[3], vec2(x0, y1))
+									&& InsideQuad(aPoints[0], aPoints[1], aPoints[2], aPoints[3], vec2(x1, y1));
+							}
+							
+							if(Pass == 0)
+							{
+								if(Covered)
+								{
+									pCache->m_Values[Cell] = pQuad->m_ColorEnvOffset;
+									aOverride[Cell] = Seq;
+								}
+							}
+							else if(!Covered && Seq > aOverride[Cell])
+							{
+								if(Pass == 1)
+									pCache->m_CandidateStart[Cell+1]++;
+								else
+								{
+									CZoneCandidate *pCandidate = &pCache->m_Candidates[aCursor[Cell]++];
+									pCandidate->m_Layer = l;
+									pCandidate->m_Quad = q;
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	
+	return pCache;
+}
+
 int CCollision::GetZoneValueAt(int ZoneHandle, float x, float y)
 {
 	if(!m_pLayers->ZoneGroup())
@@ -323,6 +616,28 @@ int CCollision::GetZoneValueAt(int ZoneHandle, float x, float y)
 	if(ZoneHandle < 0 || ZoneHandle >= m_Zones.size())
 		return 0;
 	
+	//Use the precomputed cell, only the quads that can change it are tested
+	CZoneCache *pCache = m_apZoneCaches[ZoneHandle];
+	if(x >= 0.0f && y >= 0.0f)
+	{
+		int Nx = round_to_int(x)/32;
+		int Ny = round_to_int(y)/32;
+		if(Nx < pCache->m_Width && Ny < pCache->m_Height)
+		{
+			int Cell = Ny*pCache->m_Width+Nx;
+			int Index = pCache->m_Values[Cell];
+			for(int c = pCache->m_CandidateStart[Cell]; c < pCache->m_CandidateStart[Cell+1]; c++)
+			{
+				const CZoneCandidate *pCandidate = &pCache->m_Candidates[c];
+				CMapItemLayerQuads *pQLayer = (CMapItemLayerQuads *)m_pLayers->GetLayer(m_pLayers->ZoneGroup()->m_StartLayer+pCandidate->m_Layer);
+				const CQuad *pQuads = (const CQuad *) m_pLayers->Map()->GetDataSwapped(pQLayer->m_Data);
+				if(IsInsideZoneQuad(&pQuads[pCandidate->m_Quad], x, y))
+					Index = pQuads[pCandidate->m_Quad].m_ColorEnvOffset;
+			}
+			return Index;
+		}
+	}
+	
 	int Index = 0;
 	
 	for(int i = 0; i < m_Zones[ZoneHandle].size(); i++)
@@ -351,28 +666,7 @@ int CCollision::GetZoneValueAt(int ZoneHandle, float x, float y)
 
 			for(int q = 0; q < pQLayer->m_NumQuads; q++)
 			{
-				vec2 Position(0.0f, 0.0f);
-				float Angle = 0.0f;
-				if(pQuads[q].m_PosEnv >= 0)
-				{
-					GetAnimationTransform(m_Time, pQuads[q].m_PosEnv, m_pLayers, Position, Angle);
-				}
-				
-				vec2 p0 = Position + vec2(fx2f(pQuads[q].m_aPoints[0].x), fx2f(pQuads[q].m_aPoints[0].y));
-				vec2 p1 = Position + vec2(fx2f(pQuads[q].m_aPoints[1].x), fx2f(pQuads[q].m_aPoints[1].y));
-				vec2 p2 = Position + vec2(fx2f(pQuads[q].m_aPoints[2].x), fx2f(pQuads[q].m_aPoints[2].y));
-				vec2 p3 = Position + vec2(fx2f(pQuads[q].m_aPoints[3].x), fx2f(pQuads[q].m_aPoints[3].y));
-				
-				if(Angle != 0)
-				{
-					vec2 center(fx2f(pQuads[q].m_aPoints[4].x), fx2f(pQuads[q].m_aPoints[4].y));
-					Rotate(&center, &p0, Angle);
-					Rotate(&center, &p1, Angle);
-					Rotate(&center, &p2, Angle);
-					Rotate(&center, &p3, Angle);
-				}
-				
-				if(InsideQuad(p0, p1, p2, p3, vec2(x, y)))
+				if(IsInsideZoneQuad(&pQuads[q], x, y))
 				{
 					Index = pQuads[q].m_ColorEnvOffset;
 				}
@@ -393,64 +687,60 @@ bool CCollision::AreConnected(vec2 Pos1, vec2 Pos2, float Radius)
 	int CenterY = TileRadius;
 	int Width = 2*TileRadius+1;
 	int Height = 2*TileRadius+1;
-	char* pMap = new char[Width*Height];
-	for(int j=0; j<Height; j++)
+	
+	int Pos2X = clamp(CenterX + (int)round((Pos2.x - Pos1.x)/32.0f), 0, Width-1);
+	int Pos2Y = clamp(CenterY + (int)round((Pos2.y - Pos1.y)/32.0f), 0, Height-1);
+	if(Pos2X == CenterX && Pos2Y == CenterY)
+		return true;
+	
+	if(m_aConnectedGrid.size() < Width*Height)
 	{
-		for(int i=0; i<Width; i++)
-		{
-			if(CheckPoint(Pos1.x + 32.0f*(i-CenterX), Pos1.y + 32.0f*(j-CenterY)))
-				pMap[j*Width+i] = 0x0; //This tile can be checked
-			else
-				pMap[j*Width+i] = 0x1;
-		}
+		m_aConnectedGrid.set_size(Width*Height);
+		m_aConnectedQueue.set_size(Width*Height);
 	}
+	char* pMap = m_aConnectedGrid.base_ptr();
+	int* pQueue = m_aConnectedQueue.base_ptr();
 	
-	pMap[CenterY*Width+CenterX] = 0x2; //This tile is checked
+	//0x1: the tile is solid, 0x2: the tile has been reached. Tiles are only
+	//sampled when the flood fill gets next to them
+	for(int i = 0; i < Width*Height; i++)
+		pMap[i] = 0x0;
 	
-	int Pos2X = clamp(CenterX + (int)round((Pos2.x - Pos1.x)/32.0f), 0, Width-1);
-	int Pos2Y = clamp(CenterY + (int)round((Pos2.y - Pos1.y)/32.0f), 0, Height-1);
+	int QueueStart = 0;
+	int QueueEnd = 0;
+	pMap[CenterY*Width+CenterX] = 0x2; //This tile is checked
+	pQueue[QueueEnd++] = CenterY*Width+CenterX;
 	
-	bool Changes = true;
-	while(Changes)
+	while(QueueStart < QueueEnd)
 	{
-		Changes = false;
-		for(int j=0; j<Height; j++)
+		int Cell = pQueue[QueueStart++];
+		int x = Cell%Width;
+		int y = Cell/Width;
+		
+		for(int n = 0; n < 4; n++)
 		{
-			for(int i=0; i<Width; i++)
+			int nx = x + (n == 0 ? -1 : n == 1 ? 1 : 0);
+			int ny = y + (n == 2 ? -1 : n == 3 ? 1 : 0);
+			if(nx < 0 || ny < 0 || nx >= Width || ny >= Height)
+				continue;
+			
+			int Neighbor = ny*Width+nx;
+			if(pMap[Neighbor])
+				continue;
+			
+			if(CheckPoint(Pos1.x + 32.0f*(nx-CenterX), Pos1.y + 32.0f*(ny-CenterY)))
 			{
-				if(pMap[j*Width+i]&0x1 && !(pMap[j*Width+i]&0x2))
-				{
-					if(i>0 && (pMap[j*Width+(i-1)]&0x2))
-					{
-						pMap[j*Width+i] = 0x2;
-						Changes = true;
-					}
-					if(j>0 && (pMap[(j-1)*Width+i]&0x2))
-					{
-						pMap[j*Width+i] = 0x2;
-						Changes = true;
-					}
-					if(i<Width-1 && (pMap[j*Width+(i+1)]&0x2))
-					{
-						pMap[j*Width+i] = 0x2;
-						Changes = true;
-					}
-					if(j<Height-1 && (pMap[(j+1)*Width+i]&0x2))
-					{
-						pMap[j*Width+i] = 0x2;
-						Changes = true;
-					}
-				}
+				pMap[Neighbor] = 0x1; //solid, never visit again
+				continue;
 			}
+			
+			if(nx == Pos2X && ny == Pos2Y)
+				return true;
+			
+			pMap[Neighbor] = 0x2;
+			pQueue[QueueEnd++] = Neighbor;
 		}
-		
-		if(pMap[Pos2Y*Width+Pos2X]&0x2)
-		{
-			delete[] pMap;
-			return true;
-		}
-	}	
+	}
 	
-	delete[] pMap;
 	return false;
 }
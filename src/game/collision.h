@@ -18,9 +18,36 @@ class CCollision
 	
 	array< array<int> > m_Zones;
 
+	struct CZoneCandidate
+	{
+		int m_Layer; // index in the layer list of the zone
+		int m_Quad;
+	};
+
+	// zone values rasterized at tile resolution. Cells that are only partly
+	// covered by a quad, or that an animated quad can reach, keep the list of
+	// quads that have to be tested at lookup time
+	class CZoneCache
+	{
+	public:
+		int m_Width;
+		int m_Height;
+		array<int> m_Values;
+		array<int> m_CandidateStart;
+		array<CZoneCandidate> m_Candidates;
+	};
+	array<CZoneCache *> m_apZoneCaches;
+
+	// scratch space of AreConnected, kept between calls
+	array<char> m_aConnectedGrid;
+	array<int> m_aConnectedQueue;
+
 	bool IsTileSolid(int x, int y);
 	int GetTile(int x, int y);
 	int GetZoneTile(int x, int y);
+	bool IsInsideZoneQuad(const struct CQuad *pQuad, float x, float y);
+	void GetZoneQuadBounds(const struct CQuad *pQuad, vec2 *pMin, vec2 *pMax);
+	CZoneCache *BuildZoneCache(int ZoneHandle);
 
 public:
 	enum
@@ -0,0 +1 @@
+#define GAME_NETVERSION_HASH "868ccbe551010094"
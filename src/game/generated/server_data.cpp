@@ -0,0 +1,501 @@
+#include "server_data.h"
+static CDataSound x1893[] = {
+	/* x1893[0] */ {  0,  "audio/wp_gun_fire-01.wv", },
+	/* x1893[1] */ {  0,  "audio/wp_gun_fire-02.wv", },
+	/* x1893[2] */ {  0,  "audio/wp_gun_fire-03.wv", },
+};
+static CDataSound x1909[] = {
+	/* x1909[0] */ {  0,  "audio/wp_shotty_fire-01.wv", },
+	/* x1909[1] */ {  0,  "audio/wp_shotty_fire-02.wv", },
+	/* x1909[2] */ {  0,  "audio/wp_shotty_fire-03.wv", },
+};
+static CDataSound x1925[] = {
+	/* x1925[0] */ {  0,  "audio/wp_flump_launch-01.wv", },
+	/* x1925[1] */ {  0,  "audio/wp_flump_launch-02.wv", },
+	/* x1925[2] */ {  0,  "audio/wp_flump_launch-03.wv", },
+};
+static CDataSound x1941[] = {
+	/* x1941[0] */ {  0,  "audio/wp_hammer_swing-01.wv", },
+	/* x1941[1] */ {  0,  "audio/wp_hammer_swing-02.wv", },
+	/* x1941[2] */ {  0,  "audio/wp_hammer_swing-03.wv", },
+};
+static CDataSound x1957[] = {
+	/* x1957[0] */ {  0,  "audio/wp_hammer_hit-01.wv", },
+	/* x1957[1] */ {  0,  "audio/wp_hammer_hit-02.wv", },
+	/* x1957[2] */ {  0,  "audio/wp_hammer_hit-03.wv", },
+};
+static CDataSound x1973[] = {
+	/* x1973[0] */ {  0,  "audio/wp_ninja_attack-01.wv", },
+	/* x1973[1] */ {  0,  "audio/wp_ninja_attack-02.wv", },
+	/* x1973[2] */ {  0,  "audio/wp_ninja_attack-03.wv", },
+};
+static CDataSound x1989[] = {
+	/* x1989[0] */ {  0,  "audio/wp_flump_explo-01.wv", },
+	/* x1989[1] */ {  0,  "audio/wp_flump_explo-02.wv", },
+	/* x1989[2] */ {  0,  "audio/wp_flump_explo-03.wv", },
+};
+static CDataSound x2005[] = {
+	/* x2005[0] */ {  0,  "audio/wp_ninja_hit-01.wv", },
+	/* x2005[1] */ {  0,  "audio/wp_ninja_hit-02.wv", },
+	/* x2005[2] */ {  0,  "audio/wp_ninja_hit-03.wv", },
+};
+static CDataSound x2021[] = {
+	/* x2021[0] */ {  0,  "audio/wp_rifle_fire-01.wv", },
+	/* x2021[1] */ {  0,  "audio/wp_rifle_fire-02.wv", },
+	/* x2021[2] */ {  0,  "audio/wp_rifle_fire-03.wv", },
+};
+static CDataSound x2037[] = {
+	/* x2037[0] */ {  0,  "audio/wp_rifle_bnce-01.wv", },
+	/* x2037[1] */ {  0,  "audio/wp_rifle_bnce-02.wv", },
+	/* x2037[2] */ {  0,  "audio/wp_rifle_bnce-03.wv", },
+};
+static CDataSound x2053[] = {
+	/* x2053[0] */ {  0,  "audio/wp_switch-01.wv", },
+	/* x2053[1] */ {  0,  "audio/wp_switch-02.wv", },
+	/* x2053[2] */ {  0,  "audio/wp_switch-03.wv", },
+};
+static CDataSound x2069[] = {
+	/* x2069[0] */ {  0,  "audio/vo_teefault_pain_short-01.wv", },
+	/* x2069[1] */ {  0,  "audio/vo_teefault_pain_short-02.wv", },
+	/* x2069[2] */ {  0,  "audio/vo_teefault_pain_short-03.wv", },
+	/* x2069[3] */ {  0,  "audio/vo_teefault_pain_short-04.wv", },
+	/* x2069[4] */ {  0,  "audio/vo_teefault_pain_short-05.wv", },
+	/* x2069[5] */ {  0,  "audio/vo_teefault_pain_short-06.wv", },
+	/* x2069[6] */ {  0,  "audio/vo_teefault_pain_short-07.wv", },
+	/* x2069[7] */ {  0,  "audio/vo_teefault_pain_short-08.wv", },
+	/* x2069[8] */ {  0,  "audio/vo_teefault_pain_short-09.wv", },
+	/* x2069[9] */ {  0,  "audio/vo_teefault_pain_short-10.wv", },
+	/* x2069[10] */ {  0,  "audio/vo_teefault_pain_short-11.wv", },
+	/* x2069[11] */ {  0,  "audio/vo_teefault_pain_short-12.wv", },
+};
+static CDataSound x2112[] = {
+	/* x2112[0] */ {  0,  "audio/vo_teefault_pain_long-01.wv", },
+	/* x2112[1] */ {  0,  "audio/vo_teefault_pain_long-02.wv", },
+};
+static CDataSound x2125[] = {
+	/* x2125[0] */ {  0,  "audio/foley_land-01.wv", },
+	/* x2125[1] */ {  0,  "audio/foley_land-02.wv", },
+	/* x2125[2] */ {  0,  "audio/foley_land-03.wv", },
+	/* x2125[3] */ {  0,  "audio/foley_land-04.wv", },
+};
+static CDataSound x2144[] = {
+	/* x2144[0] */ {  0,  "audio/foley_dbljump-01.wv", },
+	/* x2144[1] */ {  0,  "audio/foley_dbljump-02.wv", },
+	/* x2144[2] */ {  0,  "audio/foley_dbljump-03.wv", },
+};
+static CDataSound x2160[] = {
+	/* x2160[0] */ {  0,  "audio/foley_foot_left-01.wv", },
+	/* x2160[1] */ {  0,  "audio/foley_foot_left-02.wv", },
+	/* x2160[2] */ {  0,  "audio/foley_foot_left-03.wv", },
+	/* x2160[3] */ {  0,  "audio/foley_foot_left-04.wv", },
+	/* x2160[4] */ {  0,  "audio/foley_foot_right-01.wv", },
+	/* x2160[5] */ {  0,  "audio/foley_foot_right-02.wv", },
+	/* x2160[6] */ {  0,  "audio/foley_foot_right-03.wv", },
+	/* x2160[7] */ {  0,  "audio/foley_foot_right-04.wv", },
+};
+static CDataSound x2191[] = {
+	/* x2191[0] */ {  0,  "audio/foley_body_splat-01.wv", },
+	/* x2191[1] */ {  0,  "audio/foley_body_splat-02.wv", },
+	/* x2191[2] */ {  0,  "audio/foley_body_splat-03.wv", },
+};
+static CDataSound x2207[] = {
+	/* x2207[0] */ {  0,  "audio/vo_teefault_spawn-01.wv", },
+	/* x2207[1] */ {  0,  "audio/vo_teefault_spawn-02.wv", },
+	/* x2207[2] */ {  0,  "audio/vo_teefault_spawn-03.wv", },
+	/* x2207[3] */ {  0,  "audio/vo_teefault_spawn-04.wv", },
+	/* x2207[4] */ {  0,  "audio/vo_teefault_spawn-05.wv", },
+	/* x2207[5] */ {  0,  "audio/vo_teefault_spawn-06.wv", },
+	/* x2207[6] */ {  0,  "audio/vo_teefault_spawn-07.wv", },
+};
+static CDataSound x2235[] = {
+	/* x2235[0] */ {  0,  "audio/sfx_skid-01.wv", },
+	/* x2235[1] */ {  0,  "audio/sfx_skid-02.wv", },
+	/* x2235[2] */ {  0,  "audio/sfx_skid-03.wv", },
+	/* x2235[3] */ {  0,  "audio/sfx_skid-04.wv", },
+};
+static CDataSound x2254[] = {
+	/* x2254[0] */ {  0,  "audio/vo_teefault_cry-01.wv", },
+	/* x2254[1] */ {  0,  "audio/vo_teefault_cry-02.wv", },
+};
+static CDataSound x2267[] = {
+	/* x2267[0] */ {  0,  "audio/hook_loop-01.wv", },
+	/* x2267[1] */ {  0,  "audio/hook_loop-02.wv", },
+};
+static CDataSound x2280[] = {
+	/* x2280[0] */ {  0,  "audio/hook_attach-01.wv", },
+	/* x2280[1] */ {  0,  "audio/hook_attach-02.wv", },
+	/* x2280[2] */ {  0,  "audio/hook_attach-03.wv", },
+};
+static CDataSound x2296[] = {
+	/* x2296[0] */ {  0,  "audio/foley_body_impact-01.wv", },
+	/* x2296[1] */ {  0,  "audio/foley_body_impact-02.wv", },
+	/* x2296[2] */ {  0,  "audio/foley_body_impact-03.wv", },
+};
+static CDataSound x2312[] = {
+	/* x2312[0] */ {  0,  "audio/hook_noattach-01.wv", },
+	/* x2312[1] */ {  0,  "audio/hook_noattach-02.wv", },
+};
+static CDataSound x2325[] = {
+	/* x2325[0] */ {  0,  "audio/sfx_pickup_hrt-01.wv", },
+	/* x2325[1] */ {  0,  "audio/sfx_pickup_hrt-02.wv", },
+};
+static CDataSound x2338[] = {
+	/* x2338[0] */ {  0,  "audio/sfx_pickup_arm-01.wv", },
+	/* x2338[1] */ {  0,  "audio/sfx_pickup_arm-02.wv", },
+	/* x2338[2] */ {  0,  "audio/sfx_pickup_arm-03.wv", },
+	/* x2338[3] */ {  0,  "audio/sfx_pickup_arm-04.wv", },
+};
+static CDataSound x2357[] = {
+	/* x2357[0] */ {  0,  "audio/sfx_pickup_launcher.wv", },
+};
+static CDataSound x2367[] = {
+	/* x2367[0] */ {  0,  "audio/sfx_pickup_sg.wv", },
+};
+static CDataSound x2377[] = {
+	/* x2377[0] */ {  0,  "audio/sfx_pickup_ninja.wv", },
+};
+static CDataSound x2387[] = {
+	/* x2387[0] */ {  0,  "audio/sfx_spawn_wpn-01.wv", },
+	/* x2387[1] */ {  0,  "audio/sfx_spawn_wpn-02.wv", },
+	/* x2387[2] */ {  0,  "audio/sfx_spawn_wpn-03.wv", },
+};
+static CDataSound x2403[] = {
+	/* x2403[0] */ {  0,  "audio/wp_noammo-01.wv", },
+	/* x2403[1] */ {  0,  "audio/wp_noammo-02.wv", },
+	/* x2403[2] */ {  0,  "audio/wp_noammo-03.wv", },
+	/* x2403[3] */ {  0,  "audio/wp_noammo-04.wv", },
+	/* x2403[4] */ {  0,  "audio/wp_noammo-05.wv", },
+};
+static CDataSound x2425[] = {
+	/* x2425[0] */ {  0,  "audio/sfx_hit_weak-01.wv", },
+	/* x2425[1] */ {  0,  "audio/sfx_hit_weak-02.wv", },
+};
+static CDataSound x2438[] = {
+	/* x2438[0] */ {  0,  "audio/sfx_msg-server.wv", },
+};
+static CDataSound x2448[] = {
+	/* x2448[0] */ {  0,  "audio/sfx_msg-client.wv", },
+};
+static CDataSound x2458[] = {
+	/* x2458[0] */ {  0,  "audio/sfx_msg-highlight.wv", },
+};
+static CDataSound x2468[] = {
+	/* x2468[0] */ {  0,  "audio/sfx_ctf_drop.wv", },
+};
+static CDataSound x2478[] = {
+	/* x2478[0] */ {  0,  "audio/sfx_ctf_rtn.wv", },
+};
+static CDataSound x2488[] = {
+	/* x2488[0] */ {  0,  "audio/sfx_ctf_grab_pl.wv", },
+};
+static CDataSound x2498[] = {
+	/* x2498[0] */ {  0,  "audio/sfx_ctf_grab_en.wv", },
+};
+static CDataSound x2508[] = {
+	/* x2508[0] */ {  0,  "audio/sfx_ctf_cap_pl.wv", },
+};
+static CDataSound x2518[] = {
+	/* x2518[0] */ {  0,  "audio/music_menu.wv", },
+};
+static CDataSoundset x9[] = {
+	/* x9[0] */ {  "gun_fire",  3,x1893,  -1, },
+	/* x9[1] */ {  "shotgun_fire",  3,x1909,  -1, },
+	/* x9[2] */ {  "grenade_fire",  3,x1925,  -1, },
+	/* x9[3] */ {  "hammer_fire",  3,x1941,  -1, },
+	/* x9[4] */ {  "hammer_hit",  3,x1957,  -1, },
+	/* x9[5] */ {  "ninja_fire",  3,x1973,  -1, },
+	/* x9[6] */ {  "grenade_explode",  3,x1989,  -1, },
+	/* x9[7] */ {  "ninja_hit",  3,x2005,  -1, },
+	/* x9[8] */ {  "rifle_fire",  3,x2021,  -1, },
+	/* x9[9] */ {  "rifle_bounce",  3,x2037,  -1, },
+	/* x9[10] */ {  "weapon_switch",  3,x2053,  -1, },
+	/* x9[11] */ {  "player_pain_short",  12,x2069,  -1, },
+	/* x9[12] */ {  "player_pain_long",  2,x2112,  -1, },
+	/* x9[13] */ {  "body_land",  4,x2125,  -1, },
+	/* x9[14] */ {  "player_airjump",  3,x2144,  -1, },
+	/* x9[15] */ {  "player_jump",  8,x2160,  -1, },
+	/* x9[16] */ {  "player_die",  3,x2191,  -1, },
+	/* x9[17] */ {  "player_spawn",  7,x2207,  -1, },
+	/* x9[18] */ {  "player_skid",  4,x2235,  -1, },
+	/* x9[19] */ {  "tee_cry",  2,x2254,  -1, },
+	/* x9[20] */ {  "hook_loop",  2,x2267,  -1, },
+	/* x9[21] */ {  "hook_attach_ground",  3,x2280,  -1, },
+	/* x9[22] */ {  "hook_attach_player",  3,x2296,  -1, },
+	/* x9[23] */ {  "hook_noattach",  2,x2312,  -1, },
+	/* x9[24] */ {  "pickup_health",  2,x2325,  -1, },
+	/* x9[25] */ {  "pickup_armor",  4,x2338,  -1, },
+	/* x9[26] */ {  "pickup_grenade",  1,x2357,  -1, },
+	/* x9[27] */ {  "pickup_shotgun",  1,x2367,  -1, },
+	/* x9[28] */ {  "pickup_ninja",  1,x2377,  -1, },
+	/* x9[29] */ {  "weapon_spawn",  3,x2387,  -1, },
+	/* x9[30] */ {  "weapon_noammo",  5,x2403,  -1, },
+	/* x9[31] */ {  "hit",  2,x2425,  -1, },
+	/* x9[32] */ {  "chat_server",  1,x2438,  -1, },
+	/* x9[33] */ {  "chat_client",  1,x2448,  -1, },
+	/* x9[34] */ {  "chat_highlight",  1,x2458,  -1, },
+	/* x9[35] */ {  "ctf_drop",  1,x2468,  -1, },
+	/* x9[36] */ {  "ctf_return",  1,x2478,  -1, },
+	/* x9[37] */ {  "ctf_grab_pl",  1,x2488,  -1, },
+	/* x9[38] */ {  "ctf_grab_en",  1,x2498,  -1, },
+	/* x9[39] */ {  "ctf_capture",  1,x2508,  -1, },
+	/* x9[40] */ {  "menu",  1,x2518,  -1, },
+};
+static CDataImage x14[] = {
+	/* x14[0] */ {  "null",  "",  -1, },
+	/* x14[1] */ {  "game",  "game.png",  -1, },
+	/* x14[2] */ {  "particles",  "particles.png",  -1, },
+	/* x14[3] */ {  "cursor",  "gui_cursor.png",  -1, },
+	/* x14[4] */ {  "banner",  "gui_logo.png",  -1, },
+	/* x14[5] */ {  "emoticons",  "emoticons.png",  -1, },
+	/* x14[6] */ {  "browseicons",  "browse_icons.png",  -1, },
+	/* x14[7] */ {  "console_bg",  "console.png",  -1, },
+	/* x14[8] */ {  "console_bar",  "console_bar.png",  -1, },
+	/* x14[9] */ {  "demobuttons",  "demo_buttons.png",  -1, },
+	/* x14[10] */ {  "fileicons",  "file_icons.png",  -1, },
+	/* x14[11] */ {  "guibuttons",  "gui_buttons.png",  -1, },
+	/* x14[12] */ {  "guiicons",  "gui_icons.png",  -1, },
+};
+static CDataPickupspec x19[] = {
+	/* x19[0] */ {  "health",  15,  0, },
+	/* x19[1] */ {  "armor",  15,  0, },
+	/* x19[2] */ {  "weapon",  15,  0, },
+	/* x19[3] */ {  "ninja",  90,  90, },
+};
+static CDataSpriteset x28[] = {
+	/* x28[0] */ {  &x14[2],  8,  8, },
+	/* x28[1] */ {  &x14[1],  32,  16, },
+	/* x28[2] */ {  &x14[0],  8,  4, },
+	/* x28[3] */ {  &x14[6],  4,  1, },
+	/* x28[4] */ {  &x14[5],  4,  4, },
+	/* x28[5] */ {  &x14[9],  5,  1, },
+	/* x28[6] */ {  &x14[10],  8,  1, },
+	/* x28[7] */ {  &x14[11],  12,  4, },
+	/* x28[8] */ {  &x14[12],  8,  2, },
+};
+static CDataSprite x44[] = {
+	/* x44[0] */ {  "part_slice",  &x28[0],  0,  0,  1,  1, },
+	/* x44[1] */ {  "part_ball",  &x28[0],  1,  0,  1,  1, },
+	/* x44[2] */ {  "part_splat01",  &x28[0],  2,  0,  1,  1, },
+	/* x44[3] */ {  "part_splat02",  &x28[0],  3,  0,  1,  1, },
+	/* x44[4] */ {  "part_splat03",  &x28[0],  4,  0,  1,  1, },
+	/* x44[5] */ {  "part_smoke",  &x28[0],  0,  1,  1,  1, },
+	/* x44[6] */ {  "part_shell",  &x28[0],  0,  2,  2,  2, },
+	/* x44[7] */ {  "part_expl01",  &x28[0],  0,  4,  4,  4, },
+	/* x44[8] */ {  "part_airjump",  &x28[0],  2,  2,  2,  2, },
+	/* x44[9] */ {  "part_hit01",  &x28[0],  4,  1,  2,  2, },
+	/* x44[10] */ {  "health_full",  &x28[1],  21,  0,  2,  2, },
+	/* x44[11] */ {  "health_empty",  &x28[1],  23,  0,  2,  2, },
+	/* x44[12] */ {  "armor_full",  &x28[1],  21,  2,  2,  2, },
+	/* x44[13] */ {  "armor_empty",  &x28[1],  23,  2,  2,  2, },
+	/* x44[14] */ {  "star1",  &x28[1],  15,  0,  2,  2, },
+	/* x44[15] */ {  "star2",  &x28[1],  17,  0,  2,  2, },
+	/* x44[16] */ {  "star3",  &x28[1],  19,  0,  2,  2, },
+	/* x44[17] */ {  "part1",  &x28[1],  6,  0,  1,  1, },
+	/* x44[18] */ {  "part2",  &x28[1],  6,  1,  1,  1, },
+	/* x44[19] */ {  "part3",  &x28[1],  7,  0,  1,  1, },
+	/* x44[20] */ {  "part4",  &x28[1],  7,  1,  1,  1, },
+	/* x44[21] */ {  "part5",  &x28[1],  8,  0,  1,  1, },
+	/* x44[22] */ {  "part6",  &x28[1],  8,  1,  1,  1, },
+	/* x44[23] */ {  "part7",  &x28[1],  9,  0,  2,  2, },
+	/* x44[24] */ {  "part8",  &x28[1],  11,  0,  2,  2, },
+	/* x44[25] */ {  "part9",  &x28[1],  13,  0,  2,  2, },
+	/* x44[26] */ {  "weapon_gun_body",  &x28[1],  2,  4,  4,  2, },
+	/* x44[27] */ {  "weapon_gun_cursor",  &x28[1],  0,  4,  2,  2, },
+	/* x44[28] */ {  "weapon_gun_proj",  &x28[1],  6,  4,  2,  2, },
+	/* x44[29] */ {  "weapon_gun_muzzle1",  &x28[1],  8,  4,  3,  2, },
+	/* x44[30] */ {  "weapon_gun_muzzle2",  &x28[1],  12,  4,  3,  2, },
+	/* x44[31] */ {  "weapon_gun_muzzle3",  &x28[1],  16,  4,  3,  2, },
+	/* x44[32] */ {  "weapon_shotgun_body",  &x28[1],  2,  6,  8,  2, },
+	/* x44[33] */ {  "weapon_shotgun_cursor",  &x28[1],  0,  6,  2,  2, },
+	/* x44[34] */ {  "weapon_shotgun_proj",  &x28[1],  10,  6,  2,  2, },
+	/* x44[35] */ {  "weapon_shotgun_muzzle1",  &x28[1],  12,  6,  3,  2, },
+	/* x44[36] */ {  "weapon_shotgun_muzzle2",  &x28[1],  16,  6,  3,  2, },
+	/* x44[37] */ {  "weapon_shotgun_muzzle3",  &x28[1],  20,  6,  3,  2, },
+	/* x44[38] */ {  "weapon_grenade_body",  &x28[1],  2,  8,  7,  2, },
+	/* x44[39] */ {  "weapon_grenade_cursor",  &x28[1],  0,  8,  2,  2, },
+	/* x44[40] */ {  "weapon_grenade_proj",  &x28[1],  10,  8,  2,  2, },
+	/* x44[41] */ {  "weapon_hammer_body",  &x28[1],  2,  1,  4,  3, },
+	/* x44[42] */ {  "weapon_hammer_cursor",  &x28[1],  0,  0,  2,  2, },
+	/* x44[43] */ {  "weapon_hammer_proj",  &x28[1],  0,  0,  0,  0, },
+	/* x44[44] */ {  "weapon_ninja_body",  &x28[1],  2,  10,  8,  2, },
+	/* x44[45] */ {  "weapon_ninja_cursor",  &x28[1],  0,  10,  2,  2, },
+	/* x44[46] */ {  "weapon_ninja_proj",  &x28[1],  0,  0,  0,  0, },
+	/* x44[47] */ {  "weapon_rifle_body",  &x28[1],  2,  12,  7,  3, },
+	/* x44[48] */ {  "weapon_rifle_cursor",  &x28[1],  0,  12,  2,  2, },
+	/* x44[49] */ {  "weapon_rifle_proj",  &x28[1],  10,  12,  2,  2, },
+	/* x44[50] */ {  "hook_chain",  &x28[1],  2,  0,  1,  1, },
+	/* x44[51] */ {  "hook_head",  &x28[1],  3,  0,  2,  1, },
+	/* x44[52] */ {  "weapon_ninja_muzzle1",  &x28[1],  25,  0,  7,  4, },
+	/* x44[53] */ {  "weapon_ninja_muzzle2",  &x28[1],  25,  4,  7,  4, },
+	/* x44[54] */ {  "weapon_ninja_muzzle3",  &x28[1],  25,  8,  7,  4, },
+	/* x44[55] */ {  "pickup_health",  &x28[1],  10,  2,  2,  2, },
+	/* x44[56] */ {  "pickup_armor",  &x28[1],  12,  2,  2,  2, },
+	/* x44[57] */ {  "pickup_weapon",  &x28[1],  3,  0,  6,  2, },
+	/* x44[58] */ {  "pickup_ninja",  &x28[1],  2,  10,  8,  2, },
+	/* x44[59] */ {  "flag_blue",  &x28[1],  12,  8,  4,  8, },
+	/* x44[60] */ {  "flag_red",  &x28[1],  16,  8,  4,  8, },
+	/* x44[61] */ {  "tee_body",  &x28[2],  0,  0,  3,  3, },
+	/* x44[62] */ {  "tee_body_outline",  &x28[2],  3,  0,  3,  3, },
+	/* x44[63] */ {  "tee_foot",  &x28[2],  6,  1,  2,  1, },
+	/* x44[64] */ {  "tee_foot_outline",  &x28[2],  6,  2,  2,  1, },
+	/* x44[65] */ {  "tee_hand",  &x28[2],  6,  0,  1,  1, },
+	/* x44[66] */ {  "tee_hand_outline",  &x28[2],  7,  0,  1,  1, },
+	/* x44[67] */ {  "tee_eye_normal",  &x28[2],  2,  3,  1,  1, },
+	/* x44[68] */ {  "tee_eye_angry",  &x28[2],  3,  3,  1,  1, },
+	/* x44[69] */ {  "tee_eye_pain",  &x28[2],  4,  3,  1,  1, },
+	/* x44[70] */ {  "tee_eye_happy",  &x28[2],  5,  3,  1,  1, },
+	/* x44[71] */ {  "tee_eye_dead",  &x28[2],  6,  3,  1,  1, },
+	/* x44[72] */ {  "tee_eye_surprise",  &x28[2],  7,  3,  1,  1, },
+	/* x44[73] */ {  "oop",  &x28[4],  0,  0,  1,  1, },
+	/* x44[74] */ {  "exclamation",  &x28[4],  1,  0,  1,  1, },
+	/* x44[75] */ {  "hearts",  &x28[4],  2,  0,  1,  1, },
+	/* x44[76] */ {  "drop",  &x28[4],  3,  0,  1,  1, },
+	/* x44[77] */ {  "dotdot",  &x28[4],  0,  1,  1,  1, },
+	/* x44[78] */ {  "music",  &x28[4],  1,  1,  1,  1, },
+	/* x44[79] */ {  "sorry",  &x28[4],  2,  1,  1,  1, },
+	/* x44[80] */ {  "ghost",  &x28[4],  3,  1,  1,  1, },
+	/* x44[81] */ {  "sushi",  &x28[4],  0,  2,  1,  1, },
+	/* x44[82] */ {  "splattee",  &x28[4],  1,  2,  1,  1, },
+	/* x44[83] */ {  "deviltee",  &x28[4],  2,  2,  1,  1, },
+	/* x44[84] */ {  "zomg",  &x28[4],  3,  2,  1,  1, },
+	/* x44[85] */ {  "zzz",  &x28[4],  0,  3,  1,  1, },
+	/* x44[86] */ {  "wtf",  &x28[4],  1,  3,  1,  1, },
+	/* x44[87] */ {  "eyes",  &x28[4],  2,  3,  1,  1, },
+	/* x44[88] */ {  "question",  &x28[4],  3,  3,  1,  1, },
+	/* x44[89] */ {  "browse_lock",  &x28[3],  0,  0,  1,  1, },
+	/* x44[90] */ {  "browse_heart",  &x28[3],  1,  0,  1,  1, },
+	/* x44[91] */ {  "browse_unpure",  &x28[3],  3,  0,  1,  1, },
+	/* x44[92] */ {  "demobutton_play",  &x28[5],  0,  0,  1,  1, },
+	/* x44[93] */ {  "demobutton_pause",  &x28[5],  1,  0,  1,  1, },
+	/* x44[94] */ {  "demobutton_stop",  &x28[5],  2,  0,  1,  1, },
+	/* x44[95] */ {  "demobutton_slower",  &x28[5],  3,  0,  1,  1, },
+	/* x44[96] */ {  "demobutton_faster",  &x28[5],  4,  0,  1,  1, },
+	/* x44[97] */ {  "file_demo1",  &x28[6],  0,  0,  1,  1, },
+	/* x44[98] */ {  "file_demo2",  &x28[6],  1,  0,  1,  1, },
+	/* x44[99] */ {  "file_folder",  &x28[6],  2,  0,  1,  1, },
+	/* x44[100] */ {  "file_map1",  &x28[6],  5,  0,  1,  1, },
+	/* x44[101] */ {  "file_map2",  &x28[6],  6,  0,  1,  1, },
+	/* x44[102] */ {  "guibutton_off",  &x28[7],  0,  0,  4,  4, },
+	/* x44[103] */ {  "guibutton_on",  &x28[7],  4,  0,  4,  4, },
+	/* x44[104] */ {  "guibutton_hover",  &x28[7],  8,  0,  4,  4, },
+	/* x44[105] */ {  "guiicon_mute",  &x28[8],  0,  0,  4,  2, },
+	/* x44[106] */ {  "guiicon_friend",  &x28[8],  4,  0,  4,  2, },
+};
+static CAnimKeyframe x4276[] = {
+	/* x4276[0] */ {  0.000000,  0.000000,  -4.000000,  0.000000, },
+};
+static CAnimKeyframe x4283[] = {
+	/* x4283[0] */ {  0.000000,  0.000000,  10.000000,  0.000000, },
+};
+static CAnimKeyframe x4290[] = {
+	/* x4290[0] */ {  0.000000,  0.000000,  10.000000,  0.000000, },
+};
+static CAnimKeyframe *x4297 = 0;
+static CAnimKeyframe *x4321 = 0;
+static CAnimKeyframe x4328[] = {
+	/* x4328[0] */ {  0.000000,  -7.000000,  0.000000,  0.000000, },
+};
+static CAnimKeyframe x4335[] = {
+	/* x4335[0] */ {  0.000000,  7.000000,  0.000000,  0.000000, },
+};
+static CAnimKeyframe *x4342 = 0;
+static CAnimKeyframe *x4361 = 0;
+static CAnimKeyframe x4368[] = {
+	/* x4368[0] */ {  0.000000,  -3.000000,  0.000000,  -0.100000, },
+};
+static CAnimKeyframe x4375[] = {
+	/* x4375[0] */ {  0.000000,  3.000000,  0.000000,  -0.100000, },
+};
+static CAnimKeyframe *x4382 = 0;
+static CAnimKeyframe x4401[] = {
+	/* x4401[0] */ {  0.000000,  0.000000,  0.000000,  0.000000, },
+	/* x4401[1] */ {  0.200000,  0.000000,  -1.000000,  0.000000, },
+	/* x4401[2] */ {  0.400000,  0.000000,  0.000000,  0.000000, },
+	/* x4401[3] */ {  0.600000,  0.000000,  0.000000,  0.000000, },
+	/* x4401[4] */ {  0.800000,  0.000000,  -1.000000,  0.000000, },
+	/* x4401[5] */ {  1.000000,  0.000000,  0.000000,  0.000000, },
+};
+static CAnimKeyframe x4408[] = {
+	/* x4408[0] */ {  0.000000,  8.000000,  0.000000,  0.000000, },
+	/* x4408[1] */ {  0.200000,  -8.000000,  0.000000,  0.000000, },
+	/* x4408[2] */ {  0.400000,  -10.000000,  -4.000000,  0.200000, },
+	/* x4408[3] */ {  0.600000,  -8.000000,  -8.000000,  0.300000, },
+	/* x4408[4] */ {  0.800000,  4.000000,  -4.000000,  -0.200000, },
+	/* x4408[5] */ {  1.000000,  8.000000,  0.000000,  0.000000, },
+};
+static CAnimKeyframe x4415[] = {
+	/* x4415[0] */ {  0.000000,  -10.000000,  -4.000000,  0.200000, },
+	/* x4415[1] */ {  0.200000,  -8.000000,  -8.000000,  0.300000, },
+	/* x4415[2] */ {  0.400000,  4.000000,  -4.000000,  -0.200000, },
+	/* x4415[3] */ {  0.600000,  8.000000,  0.000000,  0.000000, },
+	/* x4415[4] */ {  0.800000,  8.000000,  0.000000,  0.000000, },
+	/* x4415[5] */ {  1.000000,  -10.000000,  -4.000000,  0.200000, },
+};
+static CAnimKeyframe *x4422 = 0;
+static CAnimKeyframe *x4521 = 0;
+static CAnimKeyframe *x4528 = 0;
+static CAnimKeyframe *x4535 = 0;
+static CAnimKeyframe x4542[] = {
+	/* x4542[0] */ {  0.000000,  0.000000,  0.000000,  -0.100000, },
+	/* x4542[1] */ {  0.300000,  0.000000,  0.000000,  0.250000, },
+	/* x4542[2] */ {  0.400000,  0.000000,  0.000000,  0.300000, },
+	/* x4542[3] */ {  0.500000,  0.000000,  0.000000,  0.250000, },
+	/* x4542[4] */ {  1.000000,  0.000000,  0.000000,  -0.100000, },
+};
+static CAnimKeyframe *x4576 = 0;
+static CAnimKeyframe *x4583 = 0;
+static CAnimKeyframe *x4590 = 0;
+static CAnimKeyframe x4597[] = {
+	/* x4597[0] */ {  0.000000,  0.000000,  0.000000,  -0.250000, },
+	/* x4597[1] */ {  0.100000,  0.000000,  0.000000,  -0.050000, },
+	/* x4597[2] */ {  0.150000,  0.000000,  0.000000,  0.350000, },
+	/* x4597[3] */ {  0.420000,  0.000000,  0.000000,  0.400000, },
+	/* x4597[4] */ {  0.500000,  0.000000,  0.000000,  0.350000, },
+	/* x4597[5] */ {  1.000000,  0.000000,  0.000000,  -0.250000, },
+};
+static CAnimation x75[] = {
+	/* x75[0] */ {  "base",  /* x75[0].body */ {  1,x4276, },  /* x75[0].back_foot */ {  1,x4283, },  /* x75[0].front_foot */ {  1,x4290, },  /* x75[0].attach */ {  0,x4297, }, },
+	/* x75[1] */ {  "idle",  /* x75[1].body */ {  0,x4321, },  /* x75[1].back_foot */ {  1,x4328, },  /* x75[1].front_foot */ {  1,x4335, },  /* x75[1].attach */ {  0,x4342, }, },
+	/* x75[2] */ {  "inair",  /* x75[2].body */ {  0,x4361, },  /* x75[2].back_foot */ {  1,x4368, },  /* x75[2].front_foot */ {  1,x4375, },  /* x75[2].attach */ {  0,x4382, }, },
+	/* x75[3] */ {  "walk",  /* x75[3].body */ {  6,x4401, },  /* x75[3].back_foot */ {  6,x4408, },  /* x75[3].front_foot */ {  6,x4415, },  /* x75[3].attach */ {  0,x4422, }, },
+	/* x75[4] */ {  "hammer_swing",  /* x75[4].body */ {  0,x4521, },  /* x75[4].back_foot */ {  0,x4528, },  /* x75[4].front_foot */ {  0,x4535, },  /* x75[4].attach */ {  5,x4542, }, },
+	/* x75[5] */ {  "ninja_swing",  /* x75[5].body */ {  0,x4576, },  /* x75[5].back_foot */ {  0,x4583, },  /* x75[5].front_foot */ {  0,x4590, },  /* x75[5].attach */ {  6,x4597, }, },
+};
+static CDataSprite* *x4754 = 0;
+static CDataSprite* x4891[] = {
+	&x44[29],
+	&x44[30],
+	&x44[31],
+};
+static CDataSprite* x5076[] = {
+	&x44[35],
+	&x44[36],
+	&x44[37],
+};
+static CDataSprite* *x5261 = 0;
+static CDataSprite* *x5398 = 0;
+static CDataSprite* x5535[] = {
+	&x44[52],
+	&x44[53],
+	&x44[54],
+};
+static CDataWeaponspec x1887[] = {
+	/* x1887[0] */ {  "hammer",  &x44[41],  &x44[42],  &x44[43],  0,x4754,  96,  125,  10,  0,  3,  4.000000,  -20.000000,  0.000000,  0.000000,  5.000000, },
+	/* x1887[1] */ {  "gun",  &x44[26],  &x44[27],  &x44[28],  3,x4891,  64,  125,  10,  500,  1,  32.000000,  4.000000,  50.000000,  6.000000,  5.000000, },
+	/* x1887[2] */ {  "shotgun",  &x44[32],  &x44[33],  &x44[34],  3,x5076,  96,  500,  10,  0,  1,  24.000000,  -2.000000,  70.000000,  6.000000,  5.000000, },
+	/* x1887[3] */ {  "grenade",  &x44[38],  &x44[39],  &x44[40],  0,x5261,  96,  500,  10,  0,  1,  24.000000,  -2.000000,  0.000000,  0.000000,  5.000000, },
+	/* x1887[4] */ {  "rifle",  &x44[47],  &x44[48],  &x44[49],  0,x5398,  92,  800,  10,  0,  5,  24.000000,  -2.000000,  0.000000,  0.000000,  5.000000, },
+	/* x1887[5] */ {  "ninja",  &x44[44],  &x44[45],  &x44[46],  3,x5535,  96,  800,  10,  0,  9,  0.000000,  0.000000,  40.000000,  -4.000000,  5.000000, },
+};
+CDataContainer datacontainer = 
+/* datacontainer */ {
+	41,x9,
+	13,x14,
+	4,x19,
+	9,x28,
+	107,x44,
+	6,x75,
+	/* datacontainer.weapons */ { 	/* datacontainer.weapons.hammer */ { 	&x1887[0], }, 	/* datacontainer.weapons.gun */ { 	&x1887[1], 	1.250000, 	2200.000000, 	2.000000, }, 	/* datacontainer.weapons.shotgun */ { 	&x1887[2], 	1.250000, 	2200.000000, 	0.800000, 	0.250000, }, 	/* datacontainer.weapons.grenade */ { 	&x1887[3], 	7.000000, 	1000.000000, 	2.000000, }, 	/* datacontainer.weapons.rifle */ { 	&x1887[4], 	800.000000, 	150, 	1, 	0.000000, }, 	/* datacontainer.weapons.ninja */ { 	&x1887[5], 	15000, 	200, 	50, }, 	6,x1887, },
+}
+;
+CDataContainer *g_pData = &datacontainer;
@@ -4,12 +4,15 @@
 #include <game/server/gamecontext.h>
 #include "biologist-laser.h"
 
+MACRO_ALLOC_SLAB_IMPL(CBiologistLaser, "biologist-laser")
+
 CBiologistLaser::CBiologistLaser(CGameWorld *pGameWorld, vec2 Pos, vec2 Direction, int Owner, int Dmg)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_LASER)
 {
 	m_Dmg = Dmg;
 	m_Pos = Pos;
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_Energy = 400.0f;
 	m_Dir = Direction;
 	m_Bounces = 0;
@@ -53,13 +56,13 @@ void CBiologistLaser::DoBounce()
 		
 		// intersected
 		m_From = m_Pos;
-		m_Pos = To;
+		SetPosition(To);
 
 		vec2 TempPos = m_Pos;
 		vec2 TempDir = m_Dir * 4.0f;
 
 		GameServer()->Collision()->MovePoint(&TempPos, &TempDir, 1.0f, 0);
-		m_Pos = TempPos;
+		SetPosition(TempPos);
 		m_Dir = normalize(TempDir);
 
 		m_Energy += 100.0f;
@@ -76,7 +79,7 @@ void CBiologistLaser::DoBounce()
 		HitCharacter(m_Pos, To);
 		
 		m_From = m_Pos;
-		m_Pos = To;
+		SetPosition(To);
 		m_Energy = -1;
 	}
 }
@@ -7,6 +7,8 @@
 
 class CBiologistLaser : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	CBiologistLaser(CGameWorld *pGameWorld, vec2 Pos, vec2 Direction, int Owner, int Dmg);
 
@@ -14,6 +16,7 @@ public:
 	virtual void Tick();
 	virtual void TickPaused();
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 	
 protected:
 	void HitCharacter(vec2 From, vec2 To);
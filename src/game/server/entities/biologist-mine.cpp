@@ -6,12 +6,15 @@
 #include "biologist-mine.h"
 #include "biologist-laser.h"
 
+MACRO_ALLOC_SLAB_IMPL(CBiologistMine, "biologist-mine")
+
 CBiologistMine::CBiologistMine(CGameWorld *pGameWorld, vec2 Pos, vec2 EndPos, int Owner)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_BIOLOGIST_MINE)
 {
 	m_Pos = Pos;
 	m_EndPos = EndPos;
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	GameWorld()->InsertEntity(this);
 	
 	for(int i=0; i<NUM_IDS; i++)
@@ -7,6 +7,8 @@
 
 class CBiologistMine : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	enum
 	{
@@ -20,6 +22,7 @@ public:
 	virtual ~CBiologistMine();
 
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 	virtual void Reset();
 	virtual void Tick();
 
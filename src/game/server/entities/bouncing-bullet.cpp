@@ -7,6 +7,8 @@
 
 #include "bouncing-bullet.h"
 
+MACRO_ALLOC_SLAB_IMPL(CBouncingBullet, "bouncing-bullet")
+
 CBouncingBullet::CBouncingBullet(CGameWorld *pGameWorld, int Owner, vec2 Pos, vec2 Dir)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_BOUNCING_BULLET)
 {
@@ -15,6 +17,7 @@ CBouncingBullet::CBouncingBullet(CGameWorld *pGameWorld, int Owner, vec2 Pos, ve
 	m_ActualDir = Dir;
 	m_Direction = Dir;
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_StartTick = Server()->Tick();
 	m_LifeSpan = Server()->TickSpeed()*2;
 	m_BounceLeft = 3; // the number of time that a bullet can bounce. It's usefull to remove bullets laying on the ground
@@ -90,7 +93,7 @@ void CBouncingBullet::Tick()
 			CollisionPos.y = LastPos.y;
 			int CollideX = GameServer()->Collision()->IntersectLine(PrevPos, CollisionPos, NULL, NULL);
 
-			m_Pos = LastPos;
+			SetPosition(LastPos);
 			m_ActualPos = m_Pos;
 			vec2 vel;
 			vel.x = m_Direction.x;
@@ -5,6 +5,8 @@
 
 class CBouncingBullet : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	int m_Owner;
 	
@@ -18,6 +20,7 @@ public:
 	virtual void Tick();
 	virtual void TickPaused();
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 
 private:
 	vec2 m_ActualPos;
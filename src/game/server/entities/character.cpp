@@ -720,10 +720,9 @@ void CCharacter::FireWeapon()
 /* INFECTION MODIFICATION START ***************************************/
 			if(GetClass() == PLAYERCLASS_ENGINEER)
 			{
-				for(CEngineerWall *pWall = (CEngineerWall*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_ENGINEER_WALL); pWall; pWall = (CEngineerWall*) pWall->TypeNext())
+				for(CEngineerWall *pWall = (CEngineerWall*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_ENGINEER_WALL); pWall; pWall = (CEngineerWall*) pWall->OwnerNext())
 				{
-					if(pWall->m_Owner == m_pPlayer->GetCID())
-						GameServer()->m_World.DestroyEntity(pWall);
+					GameServer()->m_World.DestroyEntity(pWall);
 				}
 					
 				if(m_FirstShot)
@@ -757,10 +756,9 @@ void CCharacter::FireWeapon()
 			else if(GetClass() == PLAYERCLASS_LOOPER)
 			{
 				//Potential variable name conflicts with engineers wall (for example *pWall is used twice for both Looper and Engineer)
-				for(CLooperWall *pWall = (CLooperWall*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_LOOPER_WALL); pWall; pWall = (CLooperWall*) pWall->TypeNext())
+				for(CLooperWall *pWall = (CLooperWall*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_LOOPER_WALL); pWall; pWall = (CLooperWall*) pWall->OwnerNext())
 				{
-					if(pWall->m_Owner == m_pPlayer->GetCID())
-						GameServer()->m_World.DestroyEntity(pWall);
+					GameServer()->m_World.DestroyEntity(pWall);
 				}
 					
 				if(m_FirstShot)
@@ -794,13 +792,10 @@ void CCharacter::FireWeapon()
 			else if(GetClass() == PLAYERCLASS_SOLDIER)
 			{
 				bool BombFound = false;
-				for(CSoldierBomb *pBomb = (CSoldierBomb*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_SOLDIER_BOMB); pBomb; pBomb = (CSoldierBomb*) pBomb->TypeNext())
+				for(CSoldierBomb *pBomb = (CSoldierBomb*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_SOLDIER_BOMB); pBomb; pBomb = (CSoldierBomb*) pBomb->OwnerNext())
 				{
-					if(pBomb->m_Owner == m_pPlayer->GetCID())
-					{
-						pBomb->Explode();
-						BombFound = true;
-					}
+					pBomb->Explode();
+					BombFound = true;
 				}
 				
 				if(!BombFound)
@@ -829,13 +824,10 @@ void CCharacter::FireWeapon()
 			else if(GetClass() == PLAYERCLASS_MERCENARY && g_Config.m_InfMercLove && !GameServer()->m_FunRound)
 			{
 				CMercenaryBomb* pCurrentBomb = NULL;
-				for(CMercenaryBomb *pBomb = (CMercenaryBomb*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_MERCENARY_BOMB); pBomb; pBomb = (CMercenaryBomb*) pBomb->TypeNext())
+				for(CMercenaryBomb *pBomb = (CMercenaryBomb*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_MERCENARY_BOMB); pBomb; pBomb = (CMercenaryBomb*) pBomb->OwnerNext())
 				{
-					if(pBomb->m_Owner == m_pPlayer->GetCID())
-					{
-						pCurrentBomb = pBomb;
-						break;
-					}
+					pCurrentBomb = pBomb;
+					break;
 				}
 				
 				if(pCurrentBomb)
@@ -1298,9 +1290,8 @@ void CCharacter::FireWeapon()
 			{				
 				//Find bomb
 				bool BombFound = false;
-				for(CScatterGrenade *pGrenade = (CScatterGrenade*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_SCATTER_GRENADE); pGrenade; pGrenade = (CScatterGrenade*) pGrenade->TypeNext())
+				for(CScatterGrenade *pGrenade = (CScatterGrenade*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_SCATTER_GRENADE); pGrenade; pGrenade = (CScatterGrenade*) pGrenade->OwnerNext())
 				{
-					if(pGrenade->m_Owner != m_pPlayer->GetCID()) continue;
 					pGrenade->Explode();
 					BombFound = true;
 				}
@@ -1336,9 +1327,8 @@ void CCharacter::FireWeapon()
 			{
 				//Find bomb
 				bool BombFound = false;
-				for(CMedicGrenade *pGrenade = (CMedicGrenade*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_MEDIC_GRENADE); pGrenade; pGrenade = (CMedicGrenade*) pGrenade->TypeNext())
+				for(CMedicGrenade *pGrenade = (CMedicGrenade*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_MEDIC_GRENADE); pGrenade; pGrenade = (CMedicGrenade*) pGrenade->OwnerNext())
 				{
-					if(pGrenade->m_Owner != m_pPlayer->GetCID()) continue;
 					pGrenade->Explode();
 					BombFound = true;
 				}
@@ -1497,10 +1487,9 @@ void CCharacter::FireWeapon()
 		{
 			if(GetClass() == PLAYERCLASS_BIOLOGIST)
 			{
-				for(CBiologistMine* pMine = (CBiologistMine*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_BIOLOGIST_MINE); pMine; pMine = (CBiologistMine*) pMine->TypeNext())
+				for(CBiologistMine *pMine = (CBiologistMine*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_BIOLOGIST_MINE); pMine; pMine = (CBiologistMine*) pMine->OwnerNext())
 				{
-					if(pMine->m_Owner != m_pPlayer->GetCID()) continue;
-						GameServer()->m_World.DestroyEntity(pMine);
+					GameServer()->m_World.DestroyEntity(pMine);
 				}
 				
 				vec2 To = m_Pos + Direction*400.0f;
@@ -2569,13 +2558,10 @@ void CCharacter::Tick()
 	if(GetClass() == PLAYERCLASS_ENGINEER)
 	{
 		CEngineerWall* pCurrentWall = NULL;
-		for(CEngineerWall *pWall = (CEngineerWall*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_ENGINEER_WALL); pWall; pWall = (CEngineerWall*) pWall->TypeNext())
+		for(CEngineerWall *pWall = (CEngineerWall*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_ENGINEER_WALL); pWall; pWall = (CEngineerWall*) pWall->OwnerNext())
 		{
-			if(pWall->m_Owner == m_pPlayer->GetCID())
-			{
-				pCurrentWall = pWall;
-				break;
-			}
+			pCurrentWall = pWall;
+			break;
 		}
 		
 		if(pCurrentWall)
@@ -2592,13 +2578,10 @@ void CCharacter::Tick()
 	{
 		//Potential variable name conflict with engineerwall with pCurrentWall
 		CLooperWall* pCurrentWall = NULL;
-		for(CLooperWall *pWall = (CLooperWall*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_LOOPER_WALL); pWall; pWall = (CLooperWall*) pWall->TypeNext())
+		for(CLooperWall *pWall = (CLooperWall*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_LOOPER_WALL); pWall; pWall = (CLooperWall*) pWall->OwnerNext())
 		{
-			if(pWall->m_Owner == m_pPlayer->GetCID())
-			{
-				pCurrentWall = pWall;
-				break;
-			}
+			pCurrentWall = pWall;
+			break;
 		}
 		
 		if(pCurrentWall)
@@ -2615,13 +2598,10 @@ void CCharacter::Tick()
 	{
 		CPoliceShield* pCurrentShield = NULL;
 
-		for(CPoliceShield *pShield = (CPoliceShield*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_POLICE_SHIELD); pShield; pShield = (CPoliceShield*) pShield->TypeNext())
+		for(CPoliceShield *pShield = (CPoliceShield*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_POLICE_SHIELD); pShield; pShield = (CPoliceShield*) pShield->OwnerNext())
 		{
-			if(pShield->m_Owner == m_pPlayer->GetCID())
-			{
-				pCurrentShield = pShield;
-				break;
-			}
+			pCurrentShield = pShield;
+			break;
 		}
 		if(GetInfWeaponID(m_ActiveWeapon) != INFWEAPON_POLICE_HAMMER)
 		{
@@ -2654,10 +2634,9 @@ void CCharacter::Tick()
 	else if(GetClass() == PLAYERCLASS_SOLDIER)
 	{
 		int NumBombs = 0;
-		for(CSoldierBomb *pBomb = (CSoldierBomb*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_SOLDIER_BOMB); pBomb; pBomb = (CSoldierBomb*) pBomb->TypeNext())
+		for(CSoldierBomb *pBomb = (CSoldierBomb*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_SOLDIER_BOMB); pBomb; pBomb = (CSoldierBomb*) pBomb->OwnerNext())
 		{
-			if(pBomb->m_Owner == m_pPlayer->GetCID())
-				NumBombs += pBomb->GetNbBombs();
+			NumBombs += pBomb->GetNbBombs();
 		}
 		
 		if(NumBombs)
@@ -2672,20 +2651,16 @@ void CCharacter::Tick()
 	else if(GetClass() == PLAYERCLASS_SCIENTIST)
 	{
 		int NumMines = 0;
-		for(CScientistMine *pMine = (CScientistMine*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_SCIENTIST_MINE); pMine; pMine = (CScientistMine*) pMine->TypeNext())
+		for(CScientistMine *pMine = (CScientistMine*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_SCIENTIST_MINE); pMine; pMine = (CScientistMine*) pMine->OwnerNext())
 		{
-			if(pMine->m_Owner == m_pPlayer->GetCID())
-				NumMines++;
+			NumMines++;
 		}
 
 		CWhiteHole* pCurrentWhiteHole = NULL;
-		for(CWhiteHole *pWhiteHole = (CWhiteHole*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_WHITE_HOLE); pWhiteHole; pWhiteHole = (CWhiteHole*) pWhiteHole->TypeNext())
+		for(CWhiteHole *pWhiteHole = (CWhiteHole*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_WHITE_HOLE); pWhiteHole; pWhiteHole = (CWhiteHole*) pWhiteHole->OwnerNext())
 		{
-			if(pWhiteHole->m_Owner == m_pPlayer->GetCID())
-			{
-				pCurrentWhiteHole = pWhiteHole;
-				break;
-			}
+			pCurrentWhiteHole = pWhiteHole;
+			break;
 		}
 		
 		//Reset superweapon kill counter, two seconds after whiteHole explosion
@@ -2739,10 +2714,9 @@ void CCharacter::Tick()
 	else if(GetClass() == PLAYERCLASS_BIOLOGIST)
 	{
 		int NumMines = 0;
-		for(CBiologistMine *pMine = (CBiologistMine*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_BIOLOGIST_MINE); pMine; pMine = (CBiologistMine*) pMine->TypeNext())
+		for(CBiologistMine *pMine = (CBiologistMine*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_BIOLOGIST_MINE); pMine; pMine = (CBiologistMine*) pMine->OwnerNext())
 		{
-			if(pMine->m_Owner == m_pPlayer->GetCID())
-				NumMines++;
+			NumMines++;
 		}
 		
 		if(NumMines > 0)
@@ -2756,20 +2730,16 @@ void CCharacter::Tick()
 	else if(GetClass() == PLAYERCLASS_SCIOGIST)
 	{
 		int NumMines = 0;
-		for(CScientistMine *pMine = (CScientistMine*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_SCIENTIST_MINE); pMine; pMine = (CScientistMine*) pMine->TypeNext())
+		for(CScientistMine *pMine = (CScientistMine*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_SCIENTIST_MINE); pMine; pMine = (CScientistMine*) pMine->OwnerNext())
 		{
-			if(pMine->m_Owner == m_pPlayer->GetCID())
-				NumMines++;
+			NumMines++;
 		}
 		
 		CElasticHole* pCurrentElasticHole = NULL;
-		for(CElasticHole *pElasticHole = (CElasticHole*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_ELASTIC_HOLE); pElasticHole; pElasticHole = (CElasticHole*) pElasticHole->TypeNext())
+		for(CElasticHole *pElasticHole = (CElasticHole*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_ELASTIC_HOLE); pElasticHole; pElasticHole = (CElasticHole*) pElasticHole->OwnerNext())
 		{
-			if(pElasticHole->m_Owner == m_pPlayer->GetCID())
-			{
-				pCurrentElasticHole = pElasticHole;
-				break;
-			}
+			pCurrentElasticHole = pElasticHole;
+			break;
 		}
 		
 		//Reset superweapon kill counter, two seconds after whiteHole explosion
@@ -2826,13 +2796,10 @@ void CCharacter::Tick()
 	}else if(GetClass() == PLAYERCLASS_REVIVER)
 	{
 		CHealBoom* pCurrentHealBoom = NULL;
-		for(CHealBoom *pHealBoom = (CHealBoom*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_HEAL_BOOM); pHealBoom; pHealBoom = (CHealBoom*)pHealBoom->TypeNext())
+		for(CHealBoom *pHealBoom = (CHealBoom*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_HEAL_BOOM); pHealBoom; pHealBoom = (CHealBoom*) pHealBoom->OwnerNext())
 		{
-			if(pHealBoom->m_Owner == m_pPlayer->GetCID())
-			{
-				pCurrentHealBoom = pHealBoom;
-				break;
-			}
+			pCurrentHealBoom = pHealBoom;
+			break;
 		}
 		
 		//Reset superweapon kill counter, two seconds after whiteHole explosion
@@ -2905,13 +2872,10 @@ void CCharacter::Tick()
 	else if(GetClass() == PLAYERCLASS_MERCENARY)
 	{
 		CMercenaryBomb* pCurrentBomb = NULL;
-		for(CMercenaryBomb *pBomb = (CMercenaryBomb*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_MERCENARY_BOMB); pBomb; pBomb = (CMercenaryBomb*) pBomb->TypeNext())
+		for(CMercenaryBomb *pBomb = (CMercenaryBomb*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_MERCENARY_BOMB); pBomb; pBomb = (CMercenaryBomb*) pBomb->OwnerNext())
 		{
-			if(pBomb->m_Owner == m_pPlayer->GetCID())
-			{
-				pCurrentBomb = pBomb;
-				break;
-			}
+			pCurrentBomb = pBomb;
+			break;
 		}
 		
 		if(pCurrentBomb)
@@ -3060,7 +3024,7 @@ void CCharacter::TickDefered()
 	bool StuckAfterMove = GameServer()->Collision()->TestBox(m_Core.m_Pos, vec2(28.0f, 28.0f));
 	m_Core.Quantize();
 	bool StuckAfterQuant = GameServer()->Collision()->TestBox(m_Core.m_Pos, vec2(28.0f, 28.0f));
-	m_Pos = m_Core.m_Pos;
+	SetPosition(m_Core.m_Pos);
 
 	if(!StuckBefore && (StuckAfterMove || StuckAfterQuant))
 	{
@@ -3103,8 +3067,7 @@ void CCharacter::TickDefered()
 
 	if(m_pPlayer->GetTeam() == TEAM_SPECTATORS)
 	{
-		m_Pos.x = m_Input.m_TargetX;
-		m_Pos.y = m_Input.m_TargetY;
+		SetPosition(vec2(m_Input.m_TargetX, m_Input.m_TargetY));
 	}
 
 	// update the m_SendCore if needed
@@ -3670,13 +3633,10 @@ void CCharacter::Snap(int SnappingClient)
 	if(pClient && pClient->IsHuman() && GetClass() == PLAYERCLASS_ENGINEER && !m_FirstShot)
 	{
 		CEngineerWall* pCurrentWall = NULL;
-		for(CEngineerWall *pWall = (CEngineerWall*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_ENGINEER_WALL); pWall; pWall = (CEngineerWall*) pWall->TypeNext())
+		for(CEngineerWall *pWall = (CEngineerWall*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_ENGINEER_WALL); pWall; pWall = (CEngineerWall*) pWall->OwnerNext())
 		{
-			if(pWall->m_Owner == m_pPlayer->GetCID())
-			{
-				pCurrentWall = pWall;
-				break;
-			}
+			pCurrentWall = pWall;
+			break;
 		}
 		
 		if(!pCurrentWall)
@@ -3696,13 +3656,10 @@ void CCharacter::Snap(int SnappingClient)
 	if(pClient && pClient->IsHuman() && GetClass() == PLAYERCLASS_LOOPER && !m_FirstShot)
 	{
 		CLooperWall* pCurrentWall = NULL;
-		for(CLooperWall *pWall = (CLooperWall*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_LOOPER_WALL); pWall; pWall = (CLooperWall*) pWall->TypeNext())
+		for(CLooperWall *pWall = (CLooperWall*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_LOOPER_WALL); pWall; pWall = (CLooperWall*) pWall->OwnerNext())
 		{
-			if(pWall->m_Owner == m_pPlayer->GetCID())
-			{
-				pCurrentWall = pWall;
-				break;
-			}
+			pCurrentWall = pWall;
+			break;
 		}
 		
 		if(!pCurrentWall)
@@ -4429,124 +4386,100 @@ void CCharacter::DestroyChildEntities()
 	m_NinjaStrengthBuff = 0;
 	m_NinjaAmmoBuff = 0;
 	
-	for(CProjectile *pProjectile = (CProjectile*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_PROJECTILE); pProjectile; pProjectile = (CProjectile*) pProjectile->TypeNext())
+	for(CProjectile *pProjectile = (CProjectile*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_PROJECTILE); pProjectile; pProjectile = (CProjectile*) pProjectile->OwnerNext())
 	{
-		if(pProjectile->GetOwner() != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pProjectile);
+		GameServer()->m_World.DestroyEntity(pProjectile);
 	}
-	for(CPoliceShield *pShield = (CPoliceShield*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_POLICE_SHIELD); pShield; pShield = (CPoliceShield*) pShield->TypeNext())
+	for(CPoliceShield *pShield = (CPoliceShield*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_POLICE_SHIELD); pShield; pShield = (CPoliceShield*) pShield->OwnerNext())
 	{
-		if(pShield->m_Owner != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pShield);
+		GameServer()->m_World.DestroyEntity(pShield);
 	}
-	for(CEngineerWall *pWall = (CEngineerWall*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_ENGINEER_WALL); pWall; pWall = (CEngineerWall*) pWall->TypeNext())
+	for(CEngineerWall *pWall = (CEngineerWall*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_ENGINEER_WALL); pWall; pWall = (CEngineerWall*) pWall->OwnerNext())
 	{
-		if(pWall->m_Owner != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pWall);
+		GameServer()->m_World.DestroyEntity(pWall);
 	}
-	for(CLooperWall *pWall = (CLooperWall*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_LOOPER_WALL); pWall; pWall = (CLooperWall*) pWall->TypeNext())
+	for(CLooperWall *pWall = (CLooperWall*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_LOOPER_WALL); pWall; pWall = (CLooperWall*) pWall->OwnerNext())
 	{
-		if(pWall->m_Owner != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pWall);
+		GameServer()->m_World.DestroyEntity(pWall);
 	}
-	for(CSoldierBomb *pBomb = (CSoldierBomb*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_SOLDIER_BOMB); pBomb; pBomb = (CSoldierBomb*) pBomb->TypeNext())
+	for(CSoldierBomb *pBomb = (CSoldierBomb*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_SOLDIER_BOMB); pBomb; pBomb = (CSoldierBomb*) pBomb->OwnerNext())
 	{
-		if(pBomb->m_Owner != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pBomb);
+		GameServer()->m_World.DestroyEntity(pBomb);
 	}
-	for(CScatterGrenade* pGrenade = (CScatterGrenade*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_SCATTER_GRENADE); pGrenade; pGrenade = (CScatterGrenade*) pGrenade->TypeNext())
+	for(CScatterGrenade *pGrenade = (CScatterGrenade*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_SCATTER_GRENADE); pGrenade; pGrenade = (CScatterGrenade*) pGrenade->OwnerNext())
 	{
-		if(pGrenade->m_Owner != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pGrenade);
+		GameServer()->m_World.DestroyEntity(pGrenade);
 	}
-	for(CMedicGrenade* pGrenade = (CMedicGrenade*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_MEDIC_GRENADE); pGrenade; pGrenade = (CMedicGrenade*) pGrenade->TypeNext())
+	for(CMedicGrenade *pGrenade = (CMedicGrenade*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_MEDIC_GRENADE); pGrenade; pGrenade = (CMedicGrenade*) pGrenade->OwnerNext())
 	{
-		if(pGrenade->m_Owner != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pGrenade);
+		GameServer()->m_World.DestroyEntity(pGrenade);
 	}
-	for(CSciogistGrenade* pGrenade = (CSciogistGrenade*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_SCIOGIST_GRENADE); pGrenade; pGrenade = (CSciogistGrenade*) pGrenade->TypeNext())
+	for(CSciogistGrenade *pGrenade = (CSciogistGrenade*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_SCIOGIST_GRENADE); pGrenade; pGrenade = (CSciogistGrenade*) pGrenade->OwnerNext())
 	{
-		if(pGrenade->m_Owner != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pGrenade);
+		GameServer()->m_World.DestroyEntity(pGrenade);
 	}
-	for(CElasticGrenade* pGrenade = (CElasticGrenade*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_ELASTIC_GRENADE); pGrenade; pGrenade = (CElasticGrenade*) pGrenade->TypeNext())
+	for(CElasticGrenade *pGrenade = (CElasticGrenade*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_ELASTIC_GRENADE); pGrenade; pGrenade = (CElasticGrenade*) pGrenade->OwnerNext())
 	{
-		if(pGrenade->m_Owner != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pGrenade);
+		GameServer()->m_World.DestroyEntity(pGrenade);
 	}
-	for(CReviverGrenade* pGrenade = (CReviverGrenade*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_REVIVER_GRENADE); pGrenade; pGrenade = (CReviverGrenade*) pGrenade->TypeNext())
+	for(CReviverGrenade *pGrenade = (CReviverGrenade*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_REVIVER_GRENADE); pGrenade; pGrenade = (CReviverGrenade*) pGrenade->OwnerNext())
 	{
-		if(pGrenade->m_Owner != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pGrenade);
+		GameServer()->m_World.DestroyEntity(pGrenade);
 	}
-	for(CHealBoom* pHB = (CHealBoom*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_HEAL_BOOM); pHB; pHB = (CHealBoom*) pHB->TypeNext())
+	for(CHealBoom *pHB = (CHealBoom*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_HEAL_BOOM); pHB; pHB = (CHealBoom*) pHB->OwnerNext())
 	{
-		if(pHB->m_Owner != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pHB);
+		GameServer()->m_World.DestroyEntity(pHB);
 	}
-	for(CMercenaryBomb *pBomb = (CMercenaryBomb*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_MERCENARY_BOMB); pBomb; pBomb = (CMercenaryBomb*) pBomb->TypeNext())
+	for(CMercenaryBomb *pBomb = (CMercenaryBomb*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_MERCENARY_BOMB); pBomb; pBomb = (CMercenaryBomb*) pBomb->OwnerNext())
 	{
-		if(pBomb->m_Owner != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pBomb);
+		GameServer()->m_World.DestroyEntity(pBomb);
 	}
-	for(CScientistMine* pMine = (CScientistMine*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_SCIENTIST_MINE); pMine; pMine = (CScientistMine*) pMine->TypeNext())
+	for(CScientistMine *pMine = (CScientistMine*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_SCIENTIST_MINE); pMine; pMine = (CScientistMine*) pMine->OwnerNext())
 	{
-		if(pMine->m_Owner != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pMine);
+		GameServer()->m_World.DestroyEntity(pMine);
 	}
-	for(CBiologistMine* pMine = (CBiologistMine*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_BIOLOGIST_MINE); pMine; pMine = (CBiologistMine*) pMine->TypeNext())
+	for(CBiologistMine *pMine = (CBiologistMine*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_BIOLOGIST_MINE); pMine; pMine = (CBiologistMine*) pMine->OwnerNext())
 	{
-		if(pMine->m_Owner != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pMine);
+		GameServer()->m_World.DestroyEntity(pMine);
 	}
-	for(CSlugSlime* pSlime = (CSlugSlime*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_SLUG_SLIME); pSlime; pSlime = (CSlugSlime*) pSlime->TypeNext())
+	for(CSlugSlime *pSlime = (CSlugSlime*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_SLUG_SLIME); pSlime; pSlime = (CSlugSlime*) pSlime->OwnerNext())
 	{
-		if(pSlime->GetOwner() != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pSlime);
+		GameServer()->m_World.DestroyEntity(pSlime);
 	}
-	for(CSlimeEntity* pSlime = (CSlimeEntity*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_SLIME_ENTITY); pSlime; pSlime = (CSlimeEntity*) pSlime->TypeNext())
+	for(CSlimeEntity *pSlime = (CSlimeEntity*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_SLIME_ENTITY); pSlime; pSlime = (CSlimeEntity*) pSlime->OwnerNext())
 	{
-		if(pSlime->m_Owner != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pSlime);
+		GameServer()->m_World.DestroyEntity(pSlime);
 	}
-	for(CGrowingExplosion* pGrowiExpl = (CGrowingExplosion*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_GROWINGEXPLOSION); pGrowiExpl; pGrowiExpl = (CGrowingExplosion*) pGrowiExpl->TypeNext())
+	for(CGrowingExplosion *pGrowiExpl = (CGrowingExplosion*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_GROWINGEXPLOSION); pGrowiExpl; pGrowiExpl = (CGrowingExplosion*) pGrowiExpl->OwnerNext())
 	{
-		if(pGrowiExpl->GetOwner() != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pGrowiExpl);
+		GameServer()->m_World.DestroyEntity(pGrowiExpl);
 	}
-	for(CWhiteHole* pWhiteHole = (CWhiteHole*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_WHITE_HOLE); pWhiteHole; pWhiteHole = (CWhiteHole*) pWhiteHole->TypeNext())
+	for(CWhiteHole *pWhiteHole = (CWhiteHole*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_WHITE_HOLE); pWhiteHole; pWhiteHole = (CWhiteHole*) pWhiteHole->OwnerNext())
 	{
-		if(pWhiteHole->GetOwner() != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pWhiteHole);
+		GameServer()->m_World.DestroyEntity(pWhiteHole);
 	}
-	for(CElasticHole* pElasticHole = (CElasticHole*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_ELASTIC_HOLE); pElasticHole; pElasticHole = (CElasticHole*) pElasticHole->TypeNext())
+	for(CElasticHole *pElasticHole = (CElasticHole*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_ELASTIC_HOLE); pElasticHole; pElasticHole = (CElasticHole*) pElasticHole->OwnerNext())
 	{
-		if(pElasticHole->GetOwner() != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pElasticHole);
+		GameServer()->m_World.DestroyEntity(pElasticHole);
 	}
-	for(CElasticEntity* pElasticEntity = (CElasticEntity*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_ELASTIC_ENTITY); pElasticEntity; pElasticEntity = (CElasticEntity*) pElasticEntity->TypeNext())
+	for(CElasticEntity *pElasticEntity = (CElasticEntity*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_ELASTIC_ENTITY); pElasticEntity; pElasticEntity = (CElasticEntity*) pElasticEntity->OwnerNext())
 	{
-		if(pElasticEntity->GetOwner() != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pElasticEntity);
+		GameServer()->m_World.DestroyEntity(pElasticEntity);
 	}
-	for(CSuperWeaponIndicator* pIndicator = (CSuperWeaponIndicator*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_SUPERWEAPON_INDICATOR); pIndicator; pIndicator = (CSuperWeaponIndicator*) pIndicator->TypeNext())
+	for(CSuperWeaponIndicator *pIndicator = (CSuperWeaponIndicator*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_SUPERWEAPON_INDICATOR); pIndicator; pIndicator = (CSuperWeaponIndicator*) pIndicator->OwnerNext())
 	{
-		if(pIndicator->GetOwner() != m_pPlayer->GetCID()) continue;
-			GameServer()->m_World.DestroyEntity(pIndicator);
+		GameServer()->m_World.DestroyEntity(pIndicator);
 	}
-	for(CTurret* pTurret = (CTurret*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_TURRET); pTurret; pTurret = (CTurret*) pTurret->TypeNext())
+	for(CTurret *pTurret = (CTurret*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_TURRET); pTurret; pTurret = (CTurret*) pTurret->OwnerNext())
 	{
-		if(pTurret->GetOwner() != m_pPlayer->GetCID()) continue;
 		GameServer()->m_World.DestroyEntity(pTurret);
 	}
-	for(CPlasma* pPlasma = (CPlasma*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_PLASMA); pPlasma; pPlasma = (CPlasma*) pPlasma->TypeNext())
+	for(CPlasma *pPlasma = (CPlasma*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_PLASMA); pPlasma; pPlasma = (CPlasma*) pPlasma->OwnerNext())
 	{
-		if(pPlasma->GetOwner() != m_pPlayer->GetCID()) continue;
 		GameServer()->m_World.DestroyEntity(pPlasma);
 	}
-	for(CHeroFlag* pFlag = (CHeroFlag*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_HERO_FLAG); pFlag; pFlag = (CHeroFlag*) pFlag->TypeNext())
+	for(CHeroFlag *pFlag = (CHeroFlag*) GameWorld()->FindFirstOwned(m_pPlayer->GetCID(), CGameWorld::ENTTYPE_HERO_FLAG); pFlag; pFlag = (CHeroFlag*) pFlag->OwnerNext())
 	{
-		if(pFlag->GetOwner() != m_pPlayer->GetCID()) continue;
 		GameServer()->m_World.DestroyEntity(pFlag);
 	}
 			
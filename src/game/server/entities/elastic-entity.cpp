@@ -9,6 +9,8 @@
 #include "laser.h"
 #include "growingexplosion.h"
 
+MACRO_ALLOC_SLAB_IMPL(CElasticEntity, "elastic-entity")
+
 CElasticEntity::CElasticEntity(CGameWorld *pGameWorld, vec2 CenterPos, vec2 Dir,int OwnerClientID)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_ELASTIC_ENTITY)
 {
@@ -18,6 +20,7 @@ CElasticEntity::CElasticEntity(CGameWorld *pGameWorld, vec2 CenterPos, vec2 Dir,
 	m_DetectionRadius = 60.0f;
 	m_StartTick = Server()->Tick();
 	m_Owner = OwnerClientID;
+	GameWorld()->SetEntityOwner(this, m_Owner);
     m_Direction = Dir;
 	m_ActualDir = Dir;
 	m_Damage = 3;
@@ -103,7 +106,7 @@ void CElasticEntity::Collision()
 	CollisionPos.y = m_LastPos.y;
 	int CollideX = GameServer()->Collision()->IntersectLine(PrevPos, CollisionPos, NULL, NULL);
 	
-	m_Pos = m_LastPos;
+	SetPosition(m_LastPos);
 	m_ActualPos = m_Pos;
 	vec2 vel;
 	vel.x = m_Direction.x;
@@ -210,7 +213,7 @@ void CElasticEntity::Snap(int SnappingClient)
 		pObj->m_StartTick = Server()->Tick();
 	}
 	
-	if(Server()->GetClientAntiPing(SnappingClient))
+	if(SnapAntiPing(SnappingClient))
 		return;
 
 	for(int i=0;i < CElasticEntity::NUM_PARTICLES;i++)
@@ -9,6 +9,8 @@
 
 class CElasticEntity : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	enum
 	{
@@ -21,6 +23,7 @@ public:
 	virtual void Tick();
 	virtual void Reset();
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 	int GetTick() { return m_LifeSpan; }
 
 	int GetOwner() { return m_Owner; }
@@ -8,6 +8,8 @@
 
 #include "elastic-grenade.h"
 
+MACRO_ALLOC_SLAB_IMPL(CElasticGrenade, "elastic-grenade")
+
 CElasticGrenade::CElasticGrenade(CGameWorld *pGameWorld, int Owner, int Weapon, vec2 Pos, vec2 Dir)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_ELASTIC_GRENADE)
 {
@@ -16,6 +18,7 @@ CElasticGrenade::CElasticGrenade(CGameWorld *pGameWorld, int Owner, int Weapon,
 	m_ActualDir = Dir;
 	m_Direction = Dir;
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_Weapon = Weapon;
 	m_CollisionNum = 0;
 	m_LifeSpan =  g_Config.m_InfElasticGrenadeLifeSpan * Server()->TickSpeed();
@@ -89,7 +92,7 @@ void CElasticGrenade::Tick()
 		CollisionPos.y = LastPos.y;
 		int CollideX = GameServer()->Collision()->IntersectLine(PrevPos, CollisionPos, NULL, NULL);
 		
-		m_Pos = LastPos;
+		SetPosition(LastPos);
 		m_ActualPos = m_Pos;
 		vec2 vel;
 		vel.x = m_Direction.x;
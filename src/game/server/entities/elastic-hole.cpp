@@ -7,6 +7,8 @@
 #include "elastic-hole.h"
 #include "growingexplosion.h"
 
+MACRO_ALLOC_SLAB_IMPL(CElasticHole, "elastic-hole")
+
 CElasticHole::CElasticHole(CGameWorld *pGameWorld, vec2 CenterPos, int OwnerClientID, bool IsExplode, float MaxRadius)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_ELASTIC_HOLE)
 {
@@ -15,6 +17,7 @@ CElasticHole::CElasticHole(CGameWorld *pGameWorld, vec2 CenterPos, int OwnerClie
 	m_DetectionRadius = 60.0f;
 	m_StartTick = Server()->Tick();
 	m_Owner = OwnerClientID;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_Damage = 0;
 	m_MaxRadius = MaxRadius;
 	m_IsExplode = IsExplode;
@@ -143,7 +146,7 @@ void CElasticHole::Snap(int SnappingClient)
 
 			
 	}
-	if(!Server()->GetClientAntiPing(SnappingClient))
+	if(!SnapAntiPing(SnappingClient))
 	{
 		for(int i=0;i < CElasticHole::NUM_PARTICLES;i++)
 		{
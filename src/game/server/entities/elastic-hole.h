@@ -10,6 +10,8 @@
 
 class CElasticHole : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	enum
 	{
@@ -29,6 +31,7 @@ public:
 	virtual void Tick();
 	virtual void Reset();
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 	int GetTick() { return m_LifeSpan; }
 
 	int GetOwner(){ return m_Owner; }
@@ -8,6 +8,8 @@
 #include <engine/shared/config.h>
 #include "engineer-wall.h"
 
+MACRO_ALLOC_SLAB_IMPL(CEngineerWall, "engineer-wall")
+
 const float g_BarrierMaxLength = 300.0;
 const float g_BarrierRadius = 0.0;
 
@@ -21,6 +23,7 @@ CEngineerWall::CEngineerWall(CGameWorld *pGameWorld, vec2 Pos1, vec2 Pos2, int O
 	}
 	else m_Pos2 = Pos2;
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_LifeSpan = Server()->TickSpeed()*g_Config.m_InfBarrierLifeSpan;
 	GameWorld()->InsertEntity(this);
 	m_EndPointID = Server()->SnapNewID();
@@ -155,7 +158,7 @@ void CEngineerWall::Snap(int SnappingClient)
 		pObj->m_FromY = (int)m_Pos2.y;
 		pObj->m_StartTick = Server()->Tick()-LifeDiff;
 	}
-	if(!Server()->GetClientAntiPing(SnappingClient))
+	if(!SnapAntiPing(SnappingClient))
 	{
 		CNetObj_Laser *pObj = static_cast<CNetObj_Laser *>(Server()->SnapNewItem(NETOBJTYPE_LASER, m_EndPointID, sizeof(CNetObj_Laser)));
 		if(!pObj)
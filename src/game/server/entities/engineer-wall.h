@@ -7,6 +7,8 @@
 
 class CEngineerWall : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	CEngineerWall(CGameWorld *pGameWorld, vec2 Pos, vec2 Direction, int Owner);
 	virtual ~CEngineerWall();
@@ -15,6 +17,7 @@ public:
 	virtual void Tick();
 	virtual void TickPaused();
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 	int GetTick() { return m_LifeSpan; }
 
 public:
@@ -4,6 +4,8 @@
 #include <engine/server/roundstatistics.h>
 #include "flyingpoint.h"
 
+MACRO_ALLOC_SLAB_IMPL(CFlyingPoint, "flyingpoint")
+
 CFlyingPoint::CFlyingPoint(CGameWorld *pGameWorld, vec2 Pos, int TrackedPlayer, int Points, vec2 InitialVel)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_FLYINGPOINT)
 {
@@ -30,7 +32,7 @@ void CFlyingPoint::Tick()
 		else
 		{
 			vec2 Dir = normalize(OwnerChar->m_Pos - m_Pos);
-			m_Pos += Dir*clamp(Dist, 0.0f, 16.0f) * (1.0f - m_InitialAmount) + m_InitialVel * m_InitialAmount;
+			SetPosition(m_Pos + Dir*clamp(Dist, 0.0f, 16.0f) * (1.0f - m_InitialAmount) + m_InitialVel * m_InitialAmount);
 			
 			m_InitialAmount *= 0.98f;
 		}
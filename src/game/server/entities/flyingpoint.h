@@ -7,6 +7,8 @@
 
 class CFlyingPoint : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 private:
 	int m_TrackedPlayer;
 	vec2 m_InitialVel;
@@ -18,6 +20,7 @@ public:
 	
 	virtual void Tick();
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 };
 
 #endif
@@ -1,25 +1,31 @@
 /* (c) Magnus Auvinen. See licence.txt in the root of the distribution for more information. */
 /* If you are missing that file, acquire a complete release at teeworlds.com.                */
 
+#include <algorithm>
+
 #include "growingexplosion.h"
 
 #include <game/server/gamecontext.h>
 
+MACRO_ALLOC_SLAB_IMPL(CGrowingExplosion, "growingexplosion")
+
 CGrowingExplosion::CGrowingExplosion(CGameWorld *pGameWorld, vec2 Pos, vec2 Dir, int Owner, int Radius, int ExplosionEffect)
-		: CEntity(pGameWorld, CGameWorld::ENTTYPE_GROWINGEXPLOSION),
-		m_pGrowingMap(NULL),
-		m_pGrowingMapVec(NULL)
+		: CEntity(pGameWorld, CGameWorld::ENTTYPE_GROWINGEXPLOSION)
 {
 	m_MaxGrowing = Radius;
 	m_GrowingMap_Length = (2*m_MaxGrowing+1);
 	m_GrowingMap_Size = (m_GrowingMap_Length*m_GrowingMap_Length);
 	
-	m_pGrowingMap = new int[m_GrowingMap_Size];
-	m_pGrowingMapVec = new vec2[m_GrowingMap_Size];
+	m_pBuffers = AllocBuffers(m_MaxGrowing, m_GrowingMap_Size);
+	m_pGrowingMap = (int *)m_pBuffers;
+	m_pFrontier = m_pGrowingMap + m_GrowingMap_Size;
+	m_pNextFrontier = m_pFrontier + m_GrowingMap_Size;
+	m_pGrowingMapVec = (vec2 *)(m_pNextFrontier + m_GrowingMap_Size);
 	
 	m_Pos = Pos;
 	m_StartTick = Server()->Tick();
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_ExplosionEffect = ExplosionEffect;
 	
 	mem_zero(m_Hit, sizeof(m_Hit));
@@ -64,6 +70,8 @@ CGrowingExplosion::CGrowingExplosion(CGameWorld *pGameWorld, vec2 Pos, vec2 Dir,
 	}
 	
 	m_pGrowingMap[m_MaxGrowing*m_GrowingMap_Length+m_MaxGrowing] = Server()->Tick();
+	m_pFrontier[0] = m_MaxGrowing*m_GrowingMap_Length+m_MaxGrowing;
+	m_NumFrontier = 1;
 	
 	switch(m_ExplosionEffect)
 	{
@@ -90,19 +98,36 @@ CGrowingExplosion::CGrowingExplosion(CGameWorld *pGameWorld, vec2 Pos, vec2 Dir,
 	}
 }
 
-CGrowingExplosion::~CGrowingExplosion()
+void *CGrowingExplosion::ms_apFreeBuffers[MAX_POOLED_RADIUS+1] = {0};
+
+void *CGrowingExplosion::AllocBuffers(int Radius, int Size)
 {
-	if(m_pGrowingMap)
+	// the free list is linked through the first bytes of the buffers
+	if(Radius >= 0 && Radius <= MAX_POOLED_RADIUS && ms_apFreeBuffers[Radius])
 	{
-		delete[] m_pGrowingMap;
-		m_pGrowingMap = NULL;
+		void *pBuffers = ms_apFreeBuffers[Radius];
+		ms_apFreeBuffers[Radius] = *(void **)pBuffers;
+		return pBuffers;
 	}
-		
-	if(m_pGrowingMapVec)
+
+	// growing map, two frontiers and the electric end points
+	return mem_alloc(Size*(3*sizeof(int)+sizeof(vec2)), sizeof(void *));
+}
+
+void CGrowingExplosion::FreeBuffers(void *pBuffers, int Radius)
+{
+	if(Radius >= 0 && Radius <= MAX_POOLED_RADIUS)
 	{
-		delete[] m_pGrowingMapVec;
-		m_pGrowingMapVec = NULL;
+		*(void **)pBuffers = ms_apFreeBuffers[Radius];
+		ms_apFreeBuffers[Radius] = pBuffers;
 	}
+	else
+		mem_free(pBuffers);
+}
+
+CGrowingExplosion::~CGrowingExplosion()
+{
+	FreeBuffers(m_pBuffers, m_MaxGrowing);
 }
 
 void CGrowingExplosion::Reset()
@@ -115,129 +140,147 @@ int CGrowingExplosion::GetOwner() const
 	return m_Owner;
 }
 
-void CGrowingExplosion::Tick()
+void CGrowingExplosion::Grow(int Tick)
 {
-	if(m_MarkedForDestroy) return;
+	// tiles only grow from tiles reached in an earlier tick
+	if(m_NumFrontier == 0 || m_pGrowingMap[m_pFrontier[0]] >= Tick)
+		return;
 
-	int tick = Server()->Tick();
-	//~ if((tick - m_StartTick) > Server()->TickSpeed())
-	if((tick - m_StartTick) > m_MaxGrowing)
+	// every free tile next to the frontier is reached now, older tiles
+	// had all their neighbours reached when they were the frontier
+	int NumNew = 0;
+	for(int f=0; f<m_NumFrontier; f++)
 	{
-		GameServer()->m_World.DestroyEntity(this);
-		return;
+		int k = m_pFrontier[f];
+		int i = k%m_GrowingMap_Length;
+		int j = k/m_GrowingMap_Length;
+		int aNeighbours[4];
+		int NumNeighbours = 0;
+		if(i > 0) aNeighbours[NumNeighbours++] = k-1;
+		if(i < m_GrowingMap_Length-1) aNeighbours[NumNeighbours++] = k+1;
+		if(j > 0) aNeighbours[NumNeighbours++] = k-m_GrowingMap_Length;
+		if(j < m_GrowingMap_Length-1) aNeighbours[NumNeighbours++] = k+m_GrowingMap_Length;
+		for(int n=0; n<NumNeighbours; n++)
+		{
+			if(m_pGrowingMap[aNeighbours[n]] == -1)
+			{
+				m_pGrowingMap[aNeighbours[n]] = -3; // queued
+				m_pNextFrontier[NumNew++] = aNeighbours[n];
+			}
+		}
 	}
-	
-	bool NewTile = false;
-	
-	for(int j=0; j<m_GrowingMap_Length; j++)
+
+	// visit the new tiles in the order of the map, it decides the random effects
+	std::sort(m_pNextFrontier, m_pNextFrontier+NumNew);
+
+	for(int f=0; f<NumNew; f++)
 	{
-		for(int i=0; i<m_GrowingMap_Length; i++)
+		int k = m_pNextFrontier[f];
+		int i = k%m_GrowingMap_Length;
+		int j = k/m_GrowingMap_Length;
+
+		bool FromLeft = (i > 0 && m_pGrowingMap[k-1] < Tick && m_pGrowingMap[k-1] >= 0);
+		bool FromRight = (i < m_GrowingMap_Length-1 && m_pGrowingMap[k+1] < Tick && m_pGrowingMap[k+1] >= 0);
+		bool FromTop = (j > 0 && m_pGrowingMap[k-m_GrowingMap_Length] < Tick && m_pGrowingMap[k-m_GrowingMap_Length] >= 0);
+		bool FromBottom = (j < m_GrowingMap_Length-1 && m_pGrowingMap[k+m_GrowingMap_Length] < Tick && m_pGrowingMap[k+m_GrowingMap_Length] >= 0);
+		
+		m_pGrowingMap[k] = Tick;
+		vec2 TileCenter = m_SeedPos + vec2(32.0f*(i-m_MaxGrowing) - 16.0f + random_float()*32.0f, 32.0f*(j-m_MaxGrowing) - 16.0f + random_float()*32.0f);
+		switch(m_ExplosionEffect)
 		{
-			if(m_pGrowingMap[j*m_GrowingMap_Length+i] == -1)
-			{
-				bool FromLeft = (i > 0 && m_pGrowingMap[j*m_GrowingMap_Length+i-1] < tick && m_pGrowingMap[j*m_GrowingMap_Length+i-1] >= 0);
-				bool FromRight = (i < m_GrowingMap_Length-1 && m_pGrowingMap[j*m_GrowingMap_Length+i+1] < tick && m_pGrowingMap[j*m_GrowingMap_Length+i+1] >= 0);
-				bool FromTop = (j > 0 && m_pGrowingMap[(j-1)*m_GrowingMap_Length+i] < tick && m_pGrowingMap[(j-1)*m_GrowingMap_Length+i] >= 0);
-				bool FromBottom = (j < m_GrowingMap_Length-1 && m_pGrowingMap[(j+1)*m_GrowingMap_Length+i] < tick && m_pGrowingMap[(j+1)*m_GrowingMap_Length+i] >= 0);
-				
-				if(FromLeft || FromRight || FromTop || FromBottom)
+			case GROWINGEXPLOSIONEFFECT_FREEZE_INFECTED:
+				if(random_prob(0.1f))
+				{
+					GameServer()->CreateHammerHit(TileCenter);
+				}
+				break;
+			case GROWINGEXPLOSIONEFFECT_POISON_INFECTED:
+				if(random_prob(0.1f))
 				{
-					m_pGrowingMap[j*m_GrowingMap_Length+i] = tick;
-					NewTile = true;
-					vec2 TileCenter = m_SeedPos + vec2(32.0f*(i-m_MaxGrowing) - 16.0f + random_float()*32.0f, 32.0f*(j-m_MaxGrowing) - 16.0f + random_float()*32.0f);
-					switch(m_ExplosionEffect)
+					GameServer()->CreateDeath(TileCenter, m_Owner);
+				}
+				break;
+			case GROWINGEXPLOSIONEFFECT_HEAL_HUMANS:
+				if(random_prob(0.1f))
+				{
+					GameServer()->CreateDeath(TileCenter, m_Owner);
+				}
+				break;
+			case GROWINGEXPLOSIONEFFECT_LOVE_INFECTED:
+				if(random_prob(0.2f))
+				{
+					GameServer()->CreateLoveEvent(TileCenter);
+				}
+				break;
+			case GROWINGEXPLOSIONEFFECT_BOOM_INFECTED:
+				if (random_prob(0.2f))
+				{
+					GameServer()->CreateExplosion(TileCenter, m_Owner, WEAPON_HAMMER, false, TAKEDAMAGEMODE_NOINFECTION);
+				}
+				break;
+			case GROWINGEXPLOSIONEFFECT_MERC_INFECTED:
+				if (random_prob(0.2f))
+				{
+					GameServer()->CreateExplosion(TileCenter, m_Owner, WEAPON_HAMMER, false, TAKEDAMAGEMODE_SELFHARM);
+				}
+				break;
+			case GROWINGEXPLOSIONEFFECT_BOOM_ALL:
+				if (random_prob(0.2f))
+				{
+					GameServer()->CreateExplosion(TileCenter, m_Owner, WEAPON_HAMMER, false, TAKEDAMAGEMODE_ALL);
+				}
+				break;
+			case GROWINGEXPLOSIONEFFECT_ELECTRIC_INFECTED:
+				{
+					vec2 EndPoint = m_SeedPos + vec2(32.0f*(i-m_MaxGrowing) - 16.0f + random_float()*32.0f, 32.0f*(j-m_MaxGrowing) - 16.0f + random_float()*32.0f);
+					m_pGrowingMapVec[k] = EndPoint;
+					
+					int NumPossibleStartPoint = 0;
+					vec2 PossibleStartPoint[4];
+					
+					if(FromLeft)
+					{
+						PossibleStartPoint[NumPossibleStartPoint] = m_pGrowingMapVec[j*m_GrowingMap_Length+i-1];
+						NumPossibleStartPoint++;
+					}
+					if(FromRight)
+					{
+						PossibleStartPoint[NumPossibleStartPoint] = m_pGrowingMapVec[j*m_GrowingMap_Length+i+1];
+						NumPossibleStartPoint++;
+					}
+					if(FromTop)
+					{
+						PossibleStartPoint[NumPossibleStartPoint] = m_pGrowingMapVec[(j-1)*m_GrowingMap_Length+i];
+						NumPossibleStartPoint++;
+					}
+					if(FromBottom)
+					{
+						PossibleStartPoint[NumPossibleStartPoint] = m_pGrowingMapVec[(j+1)*m_GrowingMap_Length+i];
+						NumPossibleStartPoint++;
+					}
+					
+					if(NumPossibleStartPoint > 0)
 					{
-						case GROWINGEXPLOSIONEFFECT_FREEZE_INFECTED:
-							if(random_prob(0.1f))
-							{
-								GameServer()->CreateHammerHit(TileCenter);
-							}
-							break;
-						case GROWINGEXPLOSIONEFFECT_POISON_INFECTED:
-							if(random_prob(0.1f))
-							{
-								GameServer()->CreateDeath(TileCenter, m_Owner);
-							}
-							break;
-						case GROWINGEXPLOSIONEFFECT_HEAL_HUMANS:
-							if(random_prob(0.1f))
-							{
-								GameServer()->CreateDeath(TileCenter, m_Owner);
-							}
-							break;
-						case GROWINGEXPLOSIONEFFECT_LOVE_INFECTED:
-							if(random_prob(0.2f))
-							{
-								GameServer()->CreateLoveEvent(TileCenter);
-							}
-							break;
-						case GROWINGEXPLOSIONEFFECT_BOOM_INFECTED:
-							if (random_prob(0.2f))
-							{
-								GameServer()->CreateExplosion(TileCenter, m_Owner, WEAPON_HAMMER, false, TAKEDAMAGEMODE_NOINFECTION);
-							}
-							break;
-						case GROWINGEXPLOSIONEFFECT_MERC_INFECTED:
-							if (random_prob(0.2f))
-							{
-								GameServer()->CreateExplosion(TileCenter, m_Owner, WEAPON_HAMMER, false, TAKEDAMAGEMODE_SELFHARM);
-							}
-							break;
-						case GROWINGEXPLOSIONEFFECT_BOOM_ALL:
-							if (random_prob(0.2f))
-							{
-								GameServer()->CreateExplosion(TileCenter, m_Owner, WEAPON_HAMMER, false, TAKEDAMAGEMODE_ALL);
-							}
-							break;
-						case GROWINGEXPLOSIONEFFECT_ELECTRIC_INFECTED:
-							{
-								vec2 EndPoint = m_SeedPos + vec2(32.0f*(i-m_MaxGrowing) - 16.0f + random_float()*32.0f, 32.0f*(j-m_MaxGrowing) - 16.0f + random_float()*32.0f);
-								m_pGrowingMapVec[j*m_GrowingMap_Length+i] = EndPoint;
-								
-								int NumPossibleStartPoint = 0;
-								vec2 PossibleStartPoint[4];
-								
-								if(FromLeft)
-								{
-									PossibleStartPoint[NumPossibleStartPoint] = m_pGrowingMapVec[j*m_GrowingMap_Length+i-1];
-									NumPossibleStartPoint++;
-								}
-								if(FromRight)
-								{
-									PossibleStartPoint[NumPossibleStartPoint] = m_pGrowingMapVec[j*m_GrowingMap_Length+i+1];
-									NumPossibleStartPoint++;
-								}
-								if(FromTop)
-								{
-									PossibleStartPoint[NumPossibleStartPoint] = m_pGrowingMapVec[(j-1)*m_GrowingMap_Length+i];
-									NumPossibleStartPoint++;
-								}
-								if(FromBottom)
-								{
-									PossibleStartPoint[NumPossibleStartPoint] = m_pGrowingMapVec[(j+1)*m_GrowingMap_Length+i];
-									NumPossibleStartPoint++;
-								}
-								
-								if(NumPossibleStartPoint > 0)
-								{
-									int randNb = random_int(0, NumPossibleStartPoint-1);
-									vec2 StartPoint = PossibleStartPoint[randNb];
-									GameServer()->CreateLaserDotEvent(StartPoint, EndPoint, Server()->TickSpeed()/6);
-								}
-								
-								if(random_prob(0.1f))
-								{
-									GameServer()->CreateSound(EndPoint, SOUND_RIFLE_BOUNCE);
-								}
-							}
-							break;
+						int randNb = random_int(0, NumPossibleStartPoint-1);
+						vec2 StartPoint = PossibleStartPoint[randNb];
+						GameServer()->CreateLaserDotEvent(StartPoint, EndPoint, Server()->TickSpeed()/6);
+					}
+					
+					if(random_prob(0.1f))
+					{
+						GameServer()->CreateSound(EndPoint, SOUND_RIFLE_BOUNCE);
 					}
 				}
-			}
+				break;
 		}
 	}
-	
-	if(NewTile)
+
+	int *pFrontier = m_pFrontier;
+	m_pFrontier = m_pNextFrontier;
+	m_pNextFrontier = pFrontier;
+	m_NumFrontier = NumNew;
+
+	if(NumNew > 0)
 	{
 		switch(m_ExplosionEffect)
 		{
@@ -249,10 +292,28 @@ void CGrowingExplosion::Tick()
 				break;
 		}
 	}
+}
+
+void CGrowingExplosion::Tick()
+{
+	if(m_MarkedForDestroy) return;
+
+	int tick = Server()->Tick();
+	//~ if((tick - m_StartTick) > Server()->TickSpeed())
+	if((tick - m_StartTick) > m_MaxGrowing)
+	{
+		GameServer()->m_World.DestroyEntity(this);
+		return;
+	}
+	
+	Grow(tick);
 	
 	// Find other players
-	for(CCharacter *p = (CCharacter*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_CHARACTER); p; p = (CCharacter *)p->TypeNext())
+	CCharacter *apCloseCharacters[MAX_CLIENTS];
+	int NumCharacters = GameWorld()->FindEntities(m_SeedPos, (m_MaxGrowing+2)*32.0f, (CEntity**)apCloseCharacters, MAX_CLIENTS, CGameWorld::ENTTYPE_CHARACTER);
+	for(int c = 0; c < NumCharacters; c++)
 	{
+		CCharacter *p = apCloseCharacters[c];
 		int tileX = m_MaxGrowing + static_cast<int>(round(p->m_Pos.x))/32 - m_SeedX;
 		int tileY = m_MaxGrowing + static_cast<int>(round(p->m_Pos.y))/32 - m_SeedY;
 		
@@ -323,6 +384,11 @@ void CGrowingExplosion::Tick()
 				}
 			}
 		}
+		
+		// a killed character left the type list and ended the walk over it,
+		// the next ones are only hit in the next tick
+		if(!p->IsAlive())
+			break;
 	}
 	
 	// clean slug slime
@@ -21,6 +21,8 @@ enum
 
 class CGrowingExplosion : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	CGrowingExplosion(CGameWorld *pGameWorld, vec2 Pos, vec2 Dir, int Owner, int Radius, int ExplosionEffect);
 	virtual ~CGrowingExplosion();
@@ -32,6 +34,18 @@ public:
 	int GetOwner() const;
 
 private:
+	enum
+	{
+		MAX_POOLED_RADIUS = 64,
+	};
+
+	// grid buffers are kept per radius and reused by the next explosions
+	static void *ms_apFreeBuffers[MAX_POOLED_RADIUS+1];
+	static void *AllocBuffers(int Radius, int Size);
+	static void FreeBuffers(void *pBuffers, int Radius);
+
+	void Grow(int Tick);
+
 	int m_MaxGrowing;
 	int m_GrowingMap_Length;
 	int m_GrowingMap_Size;
@@ -41,8 +55,13 @@ private:
 	int m_SeedX;
 	int m_SeedY;
 	int m_StartTick;
+	void *m_pBuffers;
 	int* m_pGrowingMap;
 	vec2* m_pGrowingMapVec;
+	// tiles reached in the last growing tick, the only ones that can reach new tiles
+	int* m_pFrontier;
+	int* m_pNextFrontier;
+	int m_NumFrontier;
 	int m_ExplosionEffect;
 	bool m_Hit[MAX_CLIENTS];
 };
@@ -8,6 +8,8 @@
 #include "growingexplosion.h"
 #include <engine/server/roundstatistics.h>
 
+MACRO_ALLOC_SLAB_IMPL(CHealBoom, "heal-boom")
+
 CHealBoom::CHealBoom(CGameWorld *pGameWorld, vec2 CenterPos, int OwnerClientID)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_HEAL_BOOM)
 {
@@ -16,6 +18,7 @@ CHealBoom::CHealBoom(CGameWorld *pGameWorld, vec2 CenterPos, int OwnerClientID)
 	m_DetectionRadius = 60.0f;
 	m_StartTick = Server()->Tick();
 	m_Owner = OwnerClientID;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_Damage = 0;
 	m_MaxRadius = g_Config.m_InfHealBoomRadius;
 	m_Radius = 0;
@@ -10,6 +10,8 @@
 
 class CHealBoom : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	enum
 	{
@@ -27,6 +29,7 @@ public:
 	virtual void Tick();
 	virtual void Reset();
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 	int GetTick() { return m_LifeSpan; }
 
 	int GetOwner(){ return m_Owner; }
@@ -5,11 +5,14 @@
 #include <engine/shared/config.h>
 #include "hero-flag.h"
 
+MACRO_ALLOC_SLAB_IMPL(CHeroFlag, "hero-flag")
+
 CHeroFlag::CHeroFlag(CGameWorld *pGameWorld, int ClientID)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_HERO_FLAG)
 {
 	m_ProximityRadius = ms_PhysSize;
 	m_OwnerID = ClientID;
+	GameWorld()->SetEntityOwner(this, m_OwnerID);
 	m_CoolDownTick = 0;
 	for(int i=0; i<CHeroFlag::SHIELD_COUNT; i++)
 	{
@@ -37,7 +40,7 @@ void CHeroFlag::FindPosition()
 	int NbPos = GameServer()->m_pController->HeroFlagPositions().size();
 	int Index = random_int(0, NbPos-1);
 	
-	m_Pos = GameServer()->m_pController->HeroFlagPositions()[Index];
+	SetPosition(GameServer()->m_pController->HeroFlagPositions()[Index]);
 }
 
 void CHeroFlag::SetCoolDown()
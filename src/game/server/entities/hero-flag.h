@@ -7,6 +7,8 @@
 
 class CHeroFlag : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	enum
 	{
@@ -3,6 +3,8 @@
 #include <game/server/gamecontext.h>
 #include "laser-teleport.h"
 
+MACRO_ALLOC_SLAB_IMPL(CLaserTeleport, "laser-teleport")
+
 CLaserTeleport::CLaserTeleport(CGameWorld *pGameWorld, vec2 StartPos, vec2 EndPos)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_LASER_TELEPORT)
 {
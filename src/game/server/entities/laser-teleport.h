@@ -5,6 +5,8 @@
 
 class CLaserTeleport : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 
 public:
 	CLaserTeleport(CGameWorld *pGameWorld, vec2 StartPos, vec2 EndPos);
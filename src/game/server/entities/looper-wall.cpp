@@ -7,6 +7,8 @@
 #include <engine/shared/config.h>
 #include "looper-wall.h"
 
+MACRO_ALLOC_SLAB_IMPL(CLooperWall, "looper-wall")
+
 CLooperWall::CLooperWall(CGameWorld *pGameWorld, vec2 Pos1, vec2 Pos2, int Owner)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_LOOPER_WALL)
 {
@@ -17,6 +19,7 @@ CLooperWall::CLooperWall(CGameWorld *pGameWorld, vec2 Pos1, vec2 Pos2, int Owner
 	}
 	else m_Pos2 = Pos2;
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_LifeSpan = Server()->TickSpeed()*g_Config.m_InfLooperBarrierLifeSpan;
 	GameWorld()->InsertEntity(this);
 	
@@ -155,7 +158,7 @@ void CLooperWall::Snap(int SnappingClient)
 		}
 		
 		// draws one dot at the end of each laser
-		if(!Server()->GetClientAntiPing(SnappingClient))
+		if(!SnapAntiPing(SnappingClient))
 		{
 			CNetObj_Laser *pObj = static_cast<CNetObj_Laser *>(Server()->SnapNewItem(NETOBJTYPE_LASER, m_EndPointIDs[i], sizeof(CNetObj_Laser)));
 			if(!pObj)
@@ -171,7 +174,7 @@ void CLooperWall::Snap(int SnappingClient)
 	}
 
 	// draw particles inside wall
-	if(!Server()->GetClientAntiPing(SnappingClient))
+	if(!SnapAntiPing(SnappingClient))
 	{
 		vec2 startPos = vec2(m_Pos2.x+dirVecT.x, m_Pos2.y+dirVecT.y);
 		dirVecT.x = -dirVecT.x*2.0f;
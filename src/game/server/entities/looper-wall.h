@@ -5,6 +5,8 @@
 
 class CLooperWall : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	enum
 	{
@@ -20,6 +22,7 @@ public:
 	virtual void Tick();
 	virtual void TickPaused();
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 	int GetTick() { return m_LifeSpan; }
 
 public:
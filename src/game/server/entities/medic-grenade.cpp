@@ -6,6 +6,8 @@
 
 #include "medic-grenade.h"
 
+MACRO_ALLOC_SLAB_IMPL(CMedicGrenade, "medic-grenade")
+
 CMedicGrenade::CMedicGrenade(CGameWorld *pGameWorld, int Owner, vec2 Pos, vec2 Dir)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_MEDIC_GRENADE)
 {
@@ -14,6 +16,7 @@ CMedicGrenade::CMedicGrenade(CGameWorld *pGameWorld, int Owner, vec2 Pos, vec2 D
 	m_ActualDir = Dir;
 	m_Direction = Dir;
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_StartTick = Server()->Tick();
 
 	GameWorld()->InsertEntity(this);
@@ -66,7 +69,7 @@ void CMedicGrenade::Tick()
 		CollisionPos.y = LastPos.y;
 		int CollideX = GameServer()->Collision()->IntersectLine(PrevPos, CollisionPos, NULL, NULL);
 
-		m_Pos = LastPos;
+		SetPosition(LastPos);
 		m_ActualPos = m_Pos;
 		vec2 vel;
 		vel.x = m_Direction.x;
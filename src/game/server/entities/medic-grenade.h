@@ -3,6 +3,8 @@
 
 class CMedicGrenade : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	int m_Owner;
 	
@@ -17,6 +19,7 @@ public:
 	virtual void TickPaused();
 	virtual void Explode();
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 
 private:
 	vec2 m_ActualPos;
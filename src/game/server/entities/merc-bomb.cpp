@@ -5,6 +5,8 @@
 #include "growingexplosion.h"
 #include "merc-bomb.h"
 
+MACRO_ALLOC_SLAB_IMPL(CMercenaryBomb, "merc-bomb")
+
 CMercenaryBomb::CMercenaryBomb(CGameWorld *pGameWorld, vec2 Pos, int Owner)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_MERCENARY_BOMB)
 {
@@ -12,6 +14,7 @@ CMercenaryBomb::CMercenaryBomb(CGameWorld *pGameWorld, vec2 Pos, int Owner)
 	GameWorld()->InsertEntity(this);
 	m_LoadingTick = Server()->TickSpeed();
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_Damage = 0;
 	
 	for(int i=0; i<NUM_IDS; i++)
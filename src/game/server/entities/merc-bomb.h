@@ -8,6 +8,8 @@
 
 class CMercenaryBomb : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	enum
 	{
@@ -6,10 +6,13 @@
 #include <game/server/gamecontext.h>
 #include "plasma.h"
 
+MACRO_ALLOC_SLAB_IMPL(CPlasma, "plasma")
+
 CPlasma::CPlasma(CGameWorld *pGameWorld, vec2 Pos, int Owner, int TrackedPlayer,vec2 Direction, bool Freeze, bool Explosive)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_PLASMA)
 {
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_Pos = Pos;
 	m_Freeze = Freeze;
 	m_TrackedPlayer = TrackedPlayer;
@@ -62,7 +65,7 @@ void CPlasma::Tick()
 			
 			m_Dir = normalize(pTarget->m_Pos - m_Pos);
 			m_Speed = clamp(Dist, 0.0f, 16.0f) * (1.0f - m_InitialAmount);
-			m_Pos += m_Dir*m_Speed;
+			SetPosition(m_Pos + m_Dir*m_Speed);
 			
 			m_InitialAmount *= 0.98f;
 			
@@ -6,6 +6,8 @@
 
 class CPlasma: public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 	
 public:
 	CPlasma(CGameWorld *pGameWorld, vec2 Pos, int Owner,int TrackedPlayer, vec2 Direction, bool Freeze, bool Explosive);
@@ -15,6 +17,7 @@ public:
 	virtual void Reset();
 	virtual void Tick();
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 	
 private:
 	void Explode();
@@ -7,10 +7,13 @@
 #include <engine/server/roundstatistics.h>
 #include <engine/shared/config.h>
 
+MACRO_ALLOC_SLAB_IMPL(CPoliceShield, "police-shield")
+
 CPoliceShield::CPoliceShield(CGameWorld *pGameWorld, int Owner)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_POLICE_SHIELD)
 {
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_ExplodeTick = 0;
     m_Radius = g_Config.m_InfPoliceShieldRadius;
 	GameWorld()->InsertEntity(this);
@@ -50,7 +53,7 @@ void CPoliceShield::Tick()
 	if(m_ExplodeTick)
 		m_ExplodeTick--;
 
-    m_Pos = m_OwnerChrCore.m_Pos;
+    SetPosition(m_OwnerChrCore.m_Pos);
     int Angle = int(m_OwnerChrCore.m_Angle / 4.5);
 
     for(CCharacter *pChr = (CCharacter*) GameWorld()->FindFirst(CGameWorld::ENTTYPE_CHARACTER); pChr; pChr = (CCharacter *)pChr->TypeNext())
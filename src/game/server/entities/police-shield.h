@@ -5,6 +5,8 @@
 
 class CPoliceShield : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	enum
 	{
@@ -16,6 +18,7 @@ public:
 	virtual void Reset();
 	virtual void Tick();
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 	int m_Owner;
 	int m_ExplodeTick;
 	array<int> m_IDs;
@@ -7,6 +7,8 @@
 #include <game/server/entities/growingexplosion.h>
 #include "projectile.h"
 
+MACRO_ALLOC_SLAB_IMPL(CProjectile, "projectile")
+
 CProjectile::CProjectile(CGameWorld *pGameWorld, int Type, int Owner, vec2 Pos, vec2 Dir, int Span,
 		int Damage, bool Explosive, float Force, int SoundImpact, int Weapon, int TakeDamageMode)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_PROJECTILE)
@@ -16,6 +18,7 @@ CProjectile::CProjectile(CGameWorld *pGameWorld, int Type, int Owner, vec2 Pos,
 	m_Direction = Dir;
 	m_LifeSpan = Span;
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_Force = Force;
 	m_Damage = Damage;
 	m_SoundImpact = SoundImpact;
@@ -8,6 +8,8 @@
 #include "growingexplosion.h"
 #include "reviver-grenade.h"
 
+MACRO_ALLOC_SLAB_IMPL(CReviverGrenade, "reviver-grenade")
+
 CReviverGrenade::CReviverGrenade(CGameWorld *pGameWorld, int Owner, vec2 Pos, vec2 Dir)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_REVIVER_GRENADE)
 {
@@ -16,6 +18,7 @@ CReviverGrenade::CReviverGrenade(CGameWorld *pGameWorld, int Owner, vec2 Pos, ve
 	m_ActualDir = Dir;
 	m_Direction = Dir;
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_LifeSpan =  g_Config.m_InfElasticGrenadeLifeSpan * Server()->TickSpeed();
 	m_StartTick = Server()->Tick();
 
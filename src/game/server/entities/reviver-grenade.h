@@ -5,6 +5,8 @@
 
 class CReviverGrenade : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	int m_Owner;
 	
@@ -19,6 +21,7 @@ public:
 	virtual void TickPaused();
 	virtual void Explode(vec2 Pos);
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 	
 	int GetTick() { return m_LifeSpan; }
 
@@ -8,6 +8,8 @@
 
 #include "scatter-grenade.h"
 
+MACRO_ALLOC_SLAB_IMPL(CScatterGrenade, "scatter-grenade")
+
 CScatterGrenade::CScatterGrenade(CGameWorld *pGameWorld, int Owner, vec2 Pos, vec2 Dir)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_SCATTER_GRENADE)
 {
@@ -16,6 +18,7 @@ CScatterGrenade::CScatterGrenade(CGameWorld *pGameWorld, int Owner, vec2 Pos, ve
 	m_ActualDir = Dir;
 	m_Direction = Dir;
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_StartTick = Server()->Tick();
 	m_IsFlashGrenade = false;
 
@@ -85,7 +88,7 @@ void CScatterGrenade::Tick()
 		CollisionPos.y = LastPos.y;
 		int CollideX = GameServer()->Collision()->IntersectLine(PrevPos, CollisionPos, NULL, NULL);
 		
-		m_Pos = LastPos;
+		SetPosition(LastPos);
 		m_ActualPos = m_Pos;
 		vec2 vel;
 		vel.x = m_Direction.x;
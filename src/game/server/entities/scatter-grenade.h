@@ -5,6 +5,8 @@
 
 class CScatterGrenade : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	int m_Owner;
 	
@@ -19,6 +21,7 @@ public:
 	virtual void TickPaused();
 	virtual void Explode();
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 	virtual void FlashGrenade();
 
 private:
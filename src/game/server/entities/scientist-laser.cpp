@@ -8,12 +8,15 @@
 #include "white-hole.h"
 #include "growingexplosion.h"
 
+MACRO_ALLOC_SLAB_IMPL(CScientistLaser, "scientist-laser")
+
 CScientistLaser::CScientistLaser(CGameWorld *pGameWorld, vec2 Pos, vec2 Direction, float StartEnergy, int Owner, int Dmg)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_LASER)
 {
 	m_Dmg = Dmg;
 	m_Pos = Pos;
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_Energy = StartEnergy;
 	m_Dir = Direction;
 	m_Bounces = 0;
@@ -32,7 +35,7 @@ bool CScientistLaser::HitCharacter(vec2 From, vec2 To)
 		return false;
 
 	m_From = From;
-	m_Pos = At;
+	SetPosition(At);
 	m_Energy = -1;
 	
 	return true;
@@ -55,7 +58,7 @@ void CScientistLaser::DoBounce()
 		if(!HitCharacter(m_Pos, To))
 		{
 			m_From = m_Pos;
-			m_Pos = To;
+			SetPosition(To);
 			m_Energy = -1;
 		}
 	}
@@ -64,7 +67,7 @@ void CScientistLaser::DoBounce()
 		if(!HitCharacter(m_Pos, To))
 		{
 			m_From = m_Pos;
-			m_Pos = To;
+			SetPosition(To);
 			m_Energy = -1;
 		}
 	}
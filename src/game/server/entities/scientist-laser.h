@@ -7,6 +7,8 @@
 
 class CScientistLaser : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	CScientistLaser(CGameWorld *pGameWorld, vec2 Pos, vec2 Direction, float StartEnergy, int Owner, int Dmg);
 
@@ -14,6 +16,7 @@ public:
 	virtual void Tick();
 	virtual void TickPaused();
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 	
 protected:
 	bool HitCharacter(vec2 From, vec2 To);
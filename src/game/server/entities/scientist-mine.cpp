@@ -7,6 +7,8 @@
 
 #include "growingexplosion.h"
 
+MACRO_ALLOC_SLAB_IMPL(CScientistMine, "scientist-mine")
+
 CScientistMine::CScientistMine(CGameWorld *pGameWorld, vec2 Pos, int Owner)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_SCIENTIST_MINE)
 {
@@ -15,6 +17,7 @@ CScientistMine::CScientistMine(CGameWorld *pGameWorld, vec2 Pos, int Owner)
 	m_DetectionRadius = 60.0f;
 	m_StartTick = Server()->Tick();
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	
 	for(int i=0; i<NUM_IDS; i++)
 	{
@@ -69,7 +72,7 @@ void CScientistMine::Snap(int SnappingClient)
 	float Radius = g_Config.m_InfMineRadius;
 	
 	int NumSide = CScientistMine::NUM_SIDE;
-	if(Server()->GetClientAntiPing(SnappingClient))
+	if(SnapAntiPing(SnappingClient))
 		NumSide = std::min(6, NumSide);
 	
 	float AngleStep = 2.0f * pi / NumSide;
@@ -90,7 +93,7 @@ void CScientistMine::Snap(int SnappingClient)
 		pObj->m_StartTick = Server()->Tick();
 	}
 	
-	if(!Server()->GetClientAntiPing(SnappingClient))
+	if(!SnapAntiPing(SnappingClient))
 	{
 		for(int i=0; i<CScientistMine::NUM_PARTICLES; i++)
 		{
@@ -7,6 +7,8 @@
 
 class CScientistMine : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	enum
 	{
@@ -20,6 +22,7 @@ public:
 	virtual ~CScientistMine();
 
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 	virtual void Reset();
 	virtual void TickPaused();
 	virtual void Tick();
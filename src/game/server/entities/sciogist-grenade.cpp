@@ -11,11 +11,14 @@
 #include "elastic-hole.h"
 #include "growingexplosion.h"
 
+MACRO_ALLOC_SLAB_IMPL(CSciogistGrenade, "sciogist-grenade")
+
 CSciogistGrenade::CSciogistGrenade(CGameWorld *pGameWorld, int Owner, vec2 Pos, vec2 Dir)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_SCIOGIST_GRENADE)
 {
 	m_Pos = Pos;
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_Direction = Dir;
 	m_ActualDir = Dir;
 	m_StartTick = Server()->Tick();
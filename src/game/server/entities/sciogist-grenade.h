@@ -7,6 +7,8 @@
 
 class CSciogistGrenade : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	CSciogistGrenade(CGameWorld *pGameWorld, int Owner, vec2 Pos, vec2 Dir);
 
@@ -14,6 +16,7 @@ public:
 	virtual void Tick();
 	virtual void TickPaused();
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 	void Explode();	
 	int m_Owner;
 	
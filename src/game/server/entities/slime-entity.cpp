@@ -8,6 +8,8 @@
 
 #include "growingexplosion.h"
 
+MACRO_ALLOC_SLAB_IMPL(CSlimeEntity, "slime-entity")
+
 CSlimeEntity::CSlimeEntity(CGameWorld *pGameWorld, int Owner, vec2 Pos, vec2 Dir)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_SLIME_ENTITY)
 {
@@ -16,6 +18,7 @@ CSlimeEntity::CSlimeEntity(CGameWorld *pGameWorld, int Owner, vec2 Pos, vec2 Dir
 	m_ActualDir = Dir;
 	m_Direction = Dir;
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_StartTick = Server()->Tick();
 
 	GameWorld()->InsertEntity(this);
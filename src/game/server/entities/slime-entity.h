@@ -7,6 +7,8 @@
 
 class CSlimeEntity : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	int m_Owner;
 	
@@ -21,6 +23,7 @@ public:
 	virtual void TickPaused();
 	virtual void Explode();
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 	vec2 m_ActualPos;
 
 private:
@@ -5,11 +5,14 @@
 
 #include "slug-slime.h"
 
+MACRO_ALLOC_SLAB_IMPL(CSlugSlime, "slug-slime")
+
 CSlugSlime::CSlugSlime(CGameWorld *pGameWorld, vec2 Pos, int Owner)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_SLUG_SLIME)
 {
 	m_Pos = Pos;
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_LifeSpan = Server()->TickSpeed()*g_Config.m_InfSlimeDuration;
 	GameWorld()->InsertEntity(this);
 	m_HealTick = 0;
@@ -7,6 +7,8 @@
 
 class CSlugSlime : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	CSlugSlime(CGameWorld *pGameWorld, vec2 Pos, int Owner);
 
@@ -4,6 +4,8 @@
 #include <engine/shared/config.h>
 #include "soldier-bomb.h"
 
+MACRO_ALLOC_SLAB_IMPL(CSoldierBomb, "soldier-bomb")
+
 CSoldierBomb::CSoldierBomb(CGameWorld *pGameWorld, vec2 Pos, int Owner)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_SOLDIER_BOMB)
 {
@@ -12,6 +14,7 @@ CSoldierBomb::CSoldierBomb(CGameWorld *pGameWorld, vec2 Pos, int Owner)
 	m_DetectionRadius = 60.0f;
 	m_StartTick = Server()->Tick();
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_nbBomb = g_Config.m_InfSoldierBombs;
 	
 	m_IDBomb.set_size(g_Config.m_InfSoldierBombs);
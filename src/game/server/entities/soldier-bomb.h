@@ -8,11 +8,14 @@
 
 class CSoldierBomb : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	CSoldierBomb(CGameWorld *pGameWorld, vec2 Pos, int Owner);
 	virtual ~CSoldierBomb();
 
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 	virtual void Reset();
 	virtual void TickPaused();
 	void Explode();
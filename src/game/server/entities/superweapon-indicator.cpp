@@ -4,6 +4,8 @@
 #include <engine/shared/config.h>
 #include "superweapon-indicator.h"
 
+MACRO_ALLOC_SLAB_IMPL(CSuperWeaponIndicator, "superweapon-indicator")
+
 CSuperWeaponIndicator::CSuperWeaponIndicator(CGameWorld *pGameWorld, vec2 Pos, int Owner)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_SUPERWEAPON_INDICATOR)
 {
@@ -12,6 +14,7 @@ CSuperWeaponIndicator::CSuperWeaponIndicator(CGameWorld *pGameWorld, vec2 Pos, i
 	m_Radius = 40.0f;
 	m_StartTick = Server()->Tick();
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_OwnerChar = GameServer()->GetPlayerChar(m_Owner);
 	m_warmUpCounter = Server()->TickSpeed()*3;
 	m_IsWarmingUp = true;
@@ -43,7 +46,7 @@ void CSuperWeaponIndicator::Snap(int SnappingClient)
 {
 	if(NetworkClipped(SnappingClient))
 		return;
-	if (Server()->GetClientAntiPing(SnappingClient))
+	if (SnapAntiPing(SnappingClient))
 		return;
 
 	float time = (Server()->Tick()-m_StartTick)/(float)Server()->TickSpeed();
@@ -69,7 +72,7 @@ void CSuperWeaponIndicator::Tick()
 	if (!m_OwnerChar) return;
 
 	//refresh indicator position
-	m_Pos = m_OwnerChar->m_Core.m_Pos;
+	SetPosition(m_OwnerChar->m_Core.m_Pos);
 	
 	if (m_IsWarmingUp) 
 	{
@@ -8,11 +8,14 @@
 
 class CSuperWeaponIndicator : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	CSuperWeaponIndicator(CGameWorld *pGameWorld, vec2 Pos, int Owner);
 	virtual ~CSuperWeaponIndicator();
 	
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 	virtual void Reset();
 	virtual void Tick();
 	
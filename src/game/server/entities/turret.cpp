@@ -9,11 +9,14 @@
 #include "plasma.h"
 #include "laser.h"
 
+MACRO_ALLOC_SLAB_IMPL(CTurret, "turret")
+
 CTurret::CTurret(CGameWorld *pGameWorld, vec2 Pos, int Owner, vec2 Direction, float StartEnergy, int Type)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_TURRET)
 {
 	m_Pos = Pos;
 	m_Owner = Owner;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_Energy = StartEnergy;
 	m_Dir = Direction;
 	m_StartTick = Server()->Tick();
@@ -203,7 +206,7 @@ void CTurret::Snap(int SnappingClient)
 	if(NetworkClipped(SnappingClient))
 		return;
 	// Draw AntiPing  effect
-	if (Server()->GetClientAntiPing(SnappingClient)) {	
+	if (SnapAntiPing(SnappingClient)) {	
 		float time = (Server()->Tick()-m_StartTick)/(float)Server()->TickSpeed();
 		float angle = fmodf(time*pi/2, 2.0f*pi);
 		
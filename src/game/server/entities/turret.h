@@ -7,6 +7,8 @@
 
 class CTurret : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 public:
 	CTurret(CGameWorld *pGameWorld, vec2 Pos, int Owner, vec2 Direction, float StartEnergy, int Type);
 	virtual ~CTurret();
@@ -14,6 +16,7 @@ public:
 	virtual void Reset();
 	virtual void Tick();
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 	
 	int GetOwner() const;
 
@@ -6,6 +6,8 @@
 #include "white-hole.h"
 #include "growingexplosion.h"
 
+MACRO_ALLOC_SLAB_IMPL(CWhiteHole, "white-hole")
+
 CWhiteHole::CWhiteHole(CGameWorld *pGameWorld, vec2 CenterPos, int OwnerClientID)
 : CEntity(pGameWorld, CGameWorld::ENTTYPE_WHITE_HOLE)
 {
@@ -13,6 +15,7 @@ CWhiteHole::CWhiteHole(CGameWorld *pGameWorld, vec2 CenterPos, int OwnerClientID
 	GameWorld()->InsertEntity(this);
 	m_StartTick = Server()->Tick();
 	m_Owner = OwnerClientID;
+	GameWorld()->SetEntityOwner(this, m_Owner);
 	m_LifeSpan = Server()->TickSpeed()*g_Config.m_InfWhiteHoleLifeSpan;
 	m_Radius = 0.0f;
 	isDieing = false;
@@ -93,7 +96,7 @@ void CWhiteHole::Snap(int SnappingClient)
 	if(NetworkClipped(SnappingClient))
 		return;
 	// Draw AntiPing white hole effect
-	if (Server()->GetClientAntiPing(SnappingClient)) {	
+	if (SnapAntiPing(SnappingClient)) {	
 		int NumSide = 6;
 		float AngleStep = 2.0f * pi / NumSide;
 		float Radius = g_Config.m_InfWhiteHoleRadius;
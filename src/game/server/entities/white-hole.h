@@ -7,6 +7,8 @@
 
 class CWhiteHole : public CEntity
 {
+	MACRO_ALLOC_SLAB()
+
 	
 private:
 	void StartVisualEffect();
@@ -18,6 +20,7 @@ public:
 	virtual ~CWhiteHole();
 	
 	virtual void Snap(int SnappingClient);
+	virtual bool IsSnapShared() { return true; }
 	virtual void Reset();
 	virtual void TickPaused();
 	virtual void Tick();
@@ -30,6 +30,17 @@ CEntity::CEntity(CGameWorld *pGameWorld, int ObjType)
 
 	m_pPrevTypeEntity = 0;
 	m_pNextTypeEntity = 0;
+
+	m_pPrevCellEntity = 0;
+	m_pNextCellEntity = 0;
+	m_GridBucket = -1;
+	m_CellX = 0;
+	m_CellY = 0;
+	m_WorldSeq = 0;
+
+	m_pPrevOwnerEntity = 0;
+	m_pNextOwnerEntity = 0;
+	m_IndexedOwner = -1;
 }
 
 CEntity::~CEntity()
@@ -60,25 +71,47 @@ int CEntity::NetworkClipped(int SnappingClient)
 int CEntity::NetworkClipped(int SnappingClient, vec2 CheckPos)
 {
 	if(SnappingClient == -1)
+	{
+		// the shared snapshot pass clips later for each client
+		GameWorld()->OnSharedSnapClip(CheckPos);
 		return 0;
+	}
 
-	float dx = GameServer()->m_apPlayers[SnappingClient]->m_ViewPos.x-CheckPos.x;
-	float dy = GameServer()->m_apPlayers[SnappingClient]->m_ViewPos.y-CheckPos.y;
+	return NetworkClippedView(GameServer()->m_apPlayers[SnappingClient]->m_ViewPos, CheckPos);
+}
+
+int CEntity::NetworkClippedView(vec2 ViewPos, vec2 CheckPos)
+{
+	float dx = ViewPos.x-CheckPos.x;
+	float dy = ViewPos.y-CheckPos.y;
 
 	if(absolute(dx) > 1000.0f || absolute(dy) > 800.0f)
 		return 1;
 
-	if(distance(GameServer()->m_apPlayers[SnappingClient]->m_ViewPos, CheckPos) > 1100.0f)
+	if(distance(ViewPos, CheckPos) > 1100.0f)
 		return 1;
 	return 0;
 }
 
+bool CEntity::SnapAntiPing(int SnappingClient)
+{
+	if(SnappingClient == -1)
+		return GameWorld()->SharedSnapAntiPing();
+	return Server()->GetClientAntiPing(SnappingClient);
+}
+
 bool CEntity::GameLayerClipped(vec2 CheckPos)
 {
 	return round(CheckPos.x)/32 < -200 || round(CheckPos.x)/32 > GameServer()->Collision()->GetWidth()+200 ||
 			round(CheckPos.y)/32 < -200 || round(CheckPos.y)/32 > GameServer()->Collision()->GetHeight()+200 ? true : false;
 }
 
+void CEntity::SetPosition(vec2 Pos)
+{
+	m_Pos = Pos;
+	GameWorld()->UpdateEntityCell(this);
+}
+
 CAnimatedEntity::CAnimatedEntity(CGameWorld *pGameWorld, int Objtype, vec2 Pivot) :
 	CEntity(pGameWorld, Objtype),
 	m_Pivot(Pivot),
@@ -109,5 +142,5 @@ void CAnimatedEntity::Tick()
 	float x = (m_RelPosition.x * cosf(Angle) - m_RelPosition.y * sinf(Angle));
 	float y = (m_RelPosition.x * sinf(Angle) + m_RelPosition.y * cosf(Angle));
 	
-	m_Pos = Position + m_Pivot + vec2(x, y);
+	SetPosition(Position + m_Pivot + vec2(x, y));
 }
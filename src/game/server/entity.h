@@ -6,6 +6,7 @@
 #include <new>
 #include <base/vmath.h>
 #include <game/server/gameworld.h>
+#include <game/server/entityslab.h>
 
 #define MACRO_ALLOC_HEAP() \
 	public: \
@@ -50,6 +51,24 @@
 		mem_zero(ms_PoolData##POOLTYPE[id], sizeof(POOLTYPE)); \
 	}
 
+#define MACRO_ALLOC_SLAB() \
+	public: \
+	void *operator new(size_t Size); \
+	void operator delete(void *pPtr); \
+	private:
+
+#define MACRO_ALLOC_SLAB_IMPL(POOLTYPE, Name) \
+	static CEntitySlab ms_Slab##POOLTYPE(Name, sizeof(POOLTYPE)); \
+	void *POOLTYPE::operator new(size_t Size) \
+	{ \
+		dbg_assert(sizeof(POOLTYPE) == Size, "size error"); \
+		return ms_Slab##POOLTYPE.Alloc(); \
+	} \
+	void POOLTYPE::operator delete(void *pPtr) \
+	{ \
+		ms_Slab##POOLTYPE.Free(pPtr); \
+	}
+
 /*
 	Class: Entity
 		Basic entity class.
@@ -62,6 +81,19 @@ class CEntity
 	CEntity *m_pPrevTypeEntity;
 	CEntity *m_pNextTypeEntity;
 
+	// spatial grid handling
+	CEntity *m_pPrevCellEntity;
+	CEntity *m_pNextCellEntity;
+	int m_GridBucket;
+	int m_CellX;
+	int m_CellY;
+	int64 m_WorldSeq;
+
+	// owner index handling
+	CEntity *m_pPrevOwnerEntity;
+	CEntity *m_pNextOwnerEntity;
+	int m_IndexedOwner;
+
 	class CGameWorld *m_pGameWorld;
 protected:
 	bool m_MarkedForDestroy;
@@ -79,6 +111,7 @@ public:
 
 	CEntity *TypeNext() { return m_pNextTypeEntity; }
 	CEntity *TypePrev() { return m_pPrevTypeEntity; }
+	CEntity *OwnerNext() { return m_pNextOwnerEntity; }
 
 	/*
 		Function: destroy
@@ -125,6 +158,22 @@ public:
 	*/
 	virtual void Snap(int SnappingClient) {}
 
+	/*
+		Function: is_snap_shared
+			Returns true if the entity snaps the same items for
+			every client, apart from network clipping and the
+			anti ping mode. These entities are snapped once per
+			snapshot and copied into each client's snapshot.
+	*/
+	virtual bool IsSnapShared() { return false; }
+
+	/*
+		Function: snap_anti_ping
+			Returns the anti ping mode to use when snapping for
+			a client, including the shared snapshot pass.
+	*/
+	bool SnapAntiPing(int SnappingClient);
+
 	/*
 		Function: networkclipped(int snapping_client)
 			Performs a series of test to see if a client can see the
@@ -141,9 +190,22 @@ public:
 	*/
 	int NetworkClipped(int SnappingClient);
 	int NetworkClipped(int SnappingClient, vec2 CheckPos);
+	static int NetworkClippedView(vec2 ViewPos, vec2 CheckPos);
 
 	bool GameLayerClipped(vec2 CheckPos);
 
+	/*
+		Function: set_position
+			Moves the entity and its grid cell at once, so that
+			queries made before the end of its tick find it at the
+			new position. Use this rather than writing m_Pos once
+			the entity is in the world.
+
+		Arguments:
+			pos - New position
+	*/
+	void SetPosition(vec2 Pos);
+
 	/*
 		Variable: proximity_radius
 			Contains the physical size of the entity.
@@ -0,0 +1,80 @@
+#include "entityslab.h"
+
+CEntitySlab *CEntitySlab::ms_pFirst = 0;
+
+CEntitySlab::CEntitySlab(const char *pName, int ObjectSize)
+{
+	m_pName = pName;
+	m_ObjectSize = ObjectSize;
+	m_Stride = (ObjectSize + OBJECT_ALIGNMENT - 1) & ~(OBJECT_ALIGNMENT - 1);
+	m_pChunks = 0;
+	m_pFreeObjects = 0;
+	m_NumLive = 0;
+	m_NumPeak = 0;
+	m_NumChunks = 0;
+
+	// slabs are static objects, the list is complete before the game starts
+	m_pNext = ms_pFirst;
+	ms_pFirst = this;
+}
+
+CEntitySlab::~CEntitySlab()
+{
+	// objects that are still alive are released with the process
+	if(m_NumLive)
+		return;
+
+	while(m_pChunks)
+	{
+		CChunk *pNext = m_pChunks->m_pNext;
+		mem_free(m_pChunks);
+		m_pChunks = pNext;
+	}
+}
+
+void CEntitySlab::AllocChunk()
+{
+	// the chunk header takes a whole cache line so that the objects start on one
+	char *pData = (char *)mem_alloc(CHUNK_ALIGNMENT + m_Stride*OBJECTS_PER_CHUNK, CHUNK_ALIGNMENT);
+	CChunk *pChunk = (CChunk *)pData;
+	pChunk->m_pNext = m_pChunks;
+	m_pChunks = pChunk;
+	m_NumChunks++;
+
+	// link the objects backwards so that they are handed out in memory order
+	char *pObjects = pData + CHUNK_ALIGNMENT;
+	for(int i = OBJECTS_PER_CHUNK-1; i >= 0; i--)
+	{
+		CFreeObject *pObject = (CFreeObject *)(pObjects + i*m_Stride);
+		pObject->m_pNext = m_pFreeObjects;
+		m_pFreeObjects = pObject;
+	}
+}
+
+void *CEntitySlab::Alloc()
+{
+	if(!m_pFreeObjects)
+		AllocChunk();
+
+	CFreeObject *pObject = m_pFreeObjects;
+	m_pFreeObjects = pObject->m_pNext;
+
+	m_NumLive++;
+	if(m_NumLive > m_NumPeak)
+		m_NumPeak = m_NumLive;
+
+	// entities expect zeroed memory, like with MACRO_ALLOC_HEAP
+	mem_zero(pObject, m_ObjectSize);
+	return pObject;
+}
+
+void CEntitySlab::Free(void *pPtr)
+{
+	if(!pPtr)
+		return;
+
+	CFreeObject *pObject = (CFreeObject *)pPtr;
+	pObject->m_pNext = m_pFreeObjects;
+	m_pFreeObjects = pObject;
+	m_NumLive--;
+}
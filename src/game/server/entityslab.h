@@ -0,0 +1,64 @@
+#ifndef GAME_SERVER_ENTITYSLAB_H
+#define GAME_SERVER_ENTITYSLAB_H
+
+#include <base/system.h>
+
+/*
+	Class: Entity Slab
+		Fixed size allocator for one entity class. Objects are carved
+		out of cache line aligned chunks and recycled through a free
+		list, chunks are kept until the end of the program. The game
+		only creates entities from the main thread, so there is no lock.
+*/
+class CEntitySlab
+{
+	enum
+	{
+		OBJECTS_PER_CHUNK = 32,
+		CHUNK_ALIGNMENT = 64,
+		OBJECT_ALIGNMENT = 16,
+	};
+
+	struct CChunk
+	{
+		CChunk *m_pNext;
+	};
+
+	struct CFreeObject
+	{
+		CFreeObject *m_pNext;
+	};
+
+	static CEntitySlab *ms_pFirst;
+	CEntitySlab *m_pNext;
+
+	const char *m_pName;
+	int m_ObjectSize;
+	int m_Stride;
+	CChunk *m_pChunks;
+	CFreeObject *m_pFreeObjects;
+
+	int m_NumLive;
+	int m_NumPeak;
+	int m_NumChunks;
+
+	void AllocChunk();
+
+public:
+	CEntitySlab(const char *pName, int ObjectSize);
+	~CEntitySlab();
+
+	void *Alloc();
+	void Free(void *pPtr);
+
+	const char *Name() const { return m_pName; }
+	int NumLive() const { return m_NumLive; }
+	int NumPeak() const { return m_NumPeak; }
+	int Capacity() const { return m_NumChunks*OBJECTS_PER_CHUNK; }
+	void ResetPeak() { m_NumPeak = m_NumLive; }
+
+	static CEntitySlab *First() { return ms_pFirst; }
+	CEntitySlab *Next() const { return m_pNext; }
+};
+
+#endif
@@ -9,50 +9,335 @@
 CEventHandler::CEventHandler()
 {
 	m_pGameServer = 0;
+	m_pEvents = 0;
+	m_Capacity = 0;
+	m_NumEvents = 0;
+	m_Pending = -1;
+	for(int p = 0; p < NUM_PRIORITIES; p++)
+		m_aNumPriority[p] = 0;
+	for(int i = 0; i < HASH_SIZE; i++)
+		m_aHashFirst[i] = -1;
+	ResetStats();
 	Clear();
 }
 
+CEventHandler::~CEventHandler()
+{
+	if(m_pEvents)
+		mem_free(m_pEvents);
+}
+
 void CEventHandler::SetGameServer(CGameContext *pGameServer)
 {
 	m_pGameServer = pGameServer;
 }
 
-void *CEventHandler::Create(int Type, int Size, int64_t Mask)
+unsigned CEventHandler::HashEvent(const CEvent *pEvent)
+{
+	unsigned Hash = (unsigned)pEvent->m_Type * 2654435761u ^ (unsigned)pEvent->m_Size;
+	for(int i = 0; i < pEvent->m_Size/(int)sizeof(int); i++)
+		Hash = (Hash ^ (unsigned)pEvent->m_aData[i]) * 16777619u;
+	return Hash;
+}
+
+int CEventHandler::CellCoord(int Value)
+{
+	// floor division, events can be slightly outside of the map
+	return Value >= 0 ? Value / CELL_SIZE : -((-Value + CELL_SIZE - 1) / CELL_SIZE);
+}
+
+int CEventHandler::CellBucket(int CellX, int CellY)
+{
+	unsigned Hash = (unsigned)CellX * 73856093u ^ (unsigned)CellY * 19349663u;
+	return Hash & (NUM_CELL_BUCKETS - 1);
+}
+
+int CEventHandler::AllocEvent(int Priority)
+{
+	if(m_FirstFree >= 0)
+	{
+		int Index = m_FirstFree;
+		m_FirstFree = m_pEvents[Index].m_HashNext;
+		return Index;
+	}
+
+	if(m_NumEvents == m_Capacity && m_Capacity < MAX_EVENTS)
+	{
+		int NewCapacity = m_Capacity ? m_Capacity*2 : MIN_EVENTS;
+		if(NewCapacity > MAX_EVENTS)
+			NewCapacity = MAX_EVENTS;
+		CEvent *pNewEvents = (CEvent *)mem_alloc(sizeof(CEvent)*NewCapacity, 1);
+		if(m_pEvents)
+		{
+			mem_copy(pNewEvents, m_pEvents, sizeof(CEvent)*m_NumEvents);
+			mem_free(m_pEvents);
+		}
+		m_pEvents = pNewEvents;
+		m_Capacity = NewCapacity;
+	}
+
+	if(m_NumEvents < m_Capacity)
+		return m_NumEvents++;
+
+	// the arena is full, replace an event that matters less than the new one
+	int VictimPriority = -1;
+	for(int p = 0; p < Priority; p++)
+	{
+		if(m_aNumPriority[p] > 0)
+		{
+			VictimPriority = p;
+			break;
+		}
+	}
+	if(VictimPriority < 0)
+		return -1;
+
+	// slots before the cursor only get this priority again through eviction,
+	// so wrap around once before giving up
+	int Index = m_aEvictCursor[VictimPriority];
+	for(int i = 0; i < m_NumEvents; i++, Index++)
+	{
+		if(Index >= m_NumEvents)
+			Index = 0;
+		if(m_pEvents[Index].m_Type >= 0 && m_pEvents[Index].m_Priority == VictimPriority)
+			break;
+	}
+	m_aEvictCursor[VictimPriority] = Index+1;
+
+	UnlinkHash(Index);
+	m_aNumPriority[VictimPriority]--;
+	m_TickStats.m_NumEvicted++;
+	return Index;
+}
+
+void CEventHandler::FreeEvent(int Index)
+{
+	CEvent *pEvent = &m_pEvents[Index];
+	m_aNumPriority[pEvent->m_Priority]--;
+	pEvent->m_Type = -1;
+	pEvent->m_HashNext = m_FirstFree;
+	m_FirstFree = Index;
+}
+
+void CEventHandler::UnlinkHash(int Index)
+{
+	int *pLink = &m_aHashFirst[m_pEvents[Index].m_Hash & (HASH_SIZE - 1)];
+	while(*pLink >= 0)
+	{
+		if(*pLink == Index)
+		{
+			*pLink = m_pEvents[Index].m_HashNext;
+			return;
+		}
+		pLink = &m_pEvents[*pLink].m_HashNext;
+	}
+}
+
+void CEventHandler::CommitPending()
+{
+	if(m_Pending < 0)
+		return;
+
+	int Index = m_Pending;
+	m_Pending = -1;
+
+	CEvent *pEvent = &m_pEvents[Index];
+	pEvent->m_Hash = HashEvent(pEvent);
+
+	// the same effect at the same position twice in a snapshot looks like one,
+	// send it once to everybody who would have seen either of them
+	int *pFirst = &m_aHashFirst[pEvent->m_Hash & (HASH_SIZE - 1)];
+	for(int i = *pFirst; i >= 0; i = m_pEvents[i].m_HashNext)
+	{
+		CEvent *pOther = &m_pEvents[i];
+		if(pOther->m_Hash == pEvent->m_Hash && pOther->m_Type == pEvent->m_Type && pOther->m_Size == pEvent->m_Size &&
+			mem_comp(pOther->m_aData, pEvent->m_aData, pEvent->m_Size) == 0)
+		{
+			pOther->m_Mask |= pEvent->m_Mask;
+			FreeEvent(Index);
+			m_TickStats.m_NumCoalesced++;
+			return;
+		}
+	}
+
+	pEvent->m_HashNext = *pFirst;
+	*pFirst = Index;
+}
+
+void *CEventHandler::Create(int Type, int Size, int64_t Mask, int Priority)
 {
-	if(m_NumEvents == MAX_EVENTS)
+	m_TickStats.m_NumCreated++;
+	if(Size > MAX_EVENT_SIZE)
+	{
+		m_TickStats.m_NumDropped++;
 		return 0;
-	if(m_CurrentOffset+Size >= MAX_DATASIZE)
+	}
+
+	CommitPending();
+
+	int Index = AllocEvent(Priority);
+	if(Index < 0)
+	{
+		m_TickStats.m_NumDropped++;
 		return 0;
+	}
+
+	CEvent *pEvent = &m_pEvents[Index];
+	pEvent->m_Type = Type;
+	pEvent->m_Size = Size;
+	pEvent->m_Priority = Priority;
+	pEvent->m_Mask = Mask;
+	mem_zero(pEvent->m_aData, sizeof(pEvent->m_aData));
+	m_aNumPriority[Priority]++;
 
-	void *p = &m_aData[m_CurrentOffset];
-	m_aOffsets[m_NumEvents] = m_CurrentOffset;
-	m_aTypes[m_NumEvents] = Type;
-	m_aSizes[m_NumEvents] = Size;
-	m_aClientMasks[m_NumEvents] = Mask;
-	m_CurrentOffset += Size;
-	m_NumEvents++;
-	return p;
+	m_Pending = Index;
+	m_CellsValid = false;
+	return pEvent->m_aData;
 }
 
 void CEventHandler::Clear()
 {
+	CommitPending();
+
+	for(int i = 0; i < m_NumEvents; i++)
+	{
+		if(m_pEvents[i].m_Type >= 0)
+			m_aHashFirst[m_pEvents[i].m_Hash & (HASH_SIZE - 1)] = -1;
+	}
+
+	int NumEvents = 0;
+	for(int p = 0; p < NUM_PRIORITIES; p++)
+	{
+		NumEvents += m_aNumPriority[p];
+		m_aNumPriority[p] = 0;
+		m_aEvictCursor[p] = 0;
+	}
+	if(NumEvents > m_TickStats.m_MaxEvents)
+		m_TickStats.m_MaxEvents = NumEvents;
+
+	m_TotalStats.m_NumCreated += m_TickStats.m_NumCreated;
+	m_TotalStats.m_NumCoalesced += m_TickStats.m_NumCoalesced;
+	m_TotalStats.m_NumEvicted += m_TickStats.m_NumEvicted;
+	m_TotalStats.m_NumDropped += m_TickStats.m_NumDropped;
+	m_TotalStats.m_NumSnapDropped += m_TickStats.m_NumSnapDropped;
+	if(m_TickStats.m_MaxEvents > m_TotalStats.m_MaxEvents)
+		m_TotalStats.m_MaxEvents = m_TickStats.m_MaxEvents;
+	m_LastTickStats = m_TickStats;
+	mem_zero(&m_TickStats, sizeof(m_TickStats));
+
 	m_NumEvents = 0;
-	m_CurrentOffset = 0;
+	m_FirstFree = -1;
+	m_Pending = -1;
+	m_CellsValid = false;
+}
+
+void CEventHandler::ResetStats()
+{
+	mem_zero(&m_TickStats, sizeof(m_TickStats));
+	mem_zero(&m_LastTickStats, sizeof(m_LastTickStats));
+	mem_zero(&m_TotalStats, sizeof(m_TotalStats));
+}
+
+void CEventHandler::BuildCells()
+{
+	for(int i = 0; i < NUM_CELL_BUCKETS; i++)
+		m_aCellFirst[i] = -1;
+
+	// link backwards so that every cell lists its events in creation order
+	for(int i = m_NumEvents-1; i >= 0; i--)
+	{
+		CEvent *pEvent = &m_pEvents[i];
+		if(pEvent->m_Type < 0)
+			continue;
+		const CNetEvent_Common *pCommon = (const CNetEvent_Common *)pEvent->m_aData;
+		pEvent->m_CellX = CellCoord(pCommon->m_X);
+		pEvent->m_CellY = CellCoord(pCommon->m_Y);
+		int Bucket = CellBucket(pEvent->m_CellX, pEvent->m_CellY);
+		pEvent->m_CellNext = m_aCellFirst[Bucket];
+		m_aCellFirst[Bucket] = i;
+	}
+
+	m_CellsValid = true;
+}
+
+void CEventHandler::SnapEvent(int Index)
+{
+	const CEvent *pEvent = &m_pEvents[Index];
+	void *d = GameServer()->Server()->SnapNewItem(pEvent->m_Type, Index, pEvent->m_Size);
+	if(d)
+		mem_copy(d, pEvent->m_aData, pEvent->m_Size);
+}
+
+void CEventHandler::SnapEvents(const int *pIndices, int NumIndices)
+{
+	if(NumIndices <= MAX_SNAP_EVENTS)
+	{
+		for(int i = 0; i < NumIndices; i++)
+			SnapEvent(pIndices[i]);
+		return;
+	}
+
+	// too many for one snapshot, send the ones that matter most
+	int NumSnapped = 0;
+	for(int p = NUM_PRIORITIES-1; p >= 0 && NumSnapped < MAX_SNAP_EVENTS; p--)
+	{
+		for(int i = 0; i < NumIndices && NumSnapped < MAX_SNAP_EVENTS; i++)
+		{
+			if(m_pEvents[pIndices[i]].m_Priority == p)
+			{
+				SnapEvent(pIndices[i]);
+				NumSnapped++;
+			}
+		}
+	}
+	m_TickStats.m_NumSnapDropped += NumIndices - NumSnapped;
 }
 
 void CEventHandler::Snap(int SnappingClient)
 {
-	for(int i = 0; i < m_NumEvents; i++)
+	CommitPending();
+
+	int aIndices[MAX_EVENTS];
+	int NumIndices = 0;
+
+	if(SnappingClient == -1)
 	{
-		if(SnappingClient == -1 || CmaskIsSet(m_aClientMasks[i], SnappingClient))
+		for(int i = 0; i < m_NumEvents; i++)
 		{
-			CNetEvent_Common *ev = (CNetEvent_Common *)&m_aData[m_aOffsets[i]];
-			if(SnappingClient == -1 || distance(GameServer()->m_apPlayers[SnappingClient]->m_ViewPos, vec2(ev->m_X, ev->m_Y)) < 1500.0f)
+			if(m_pEvents[i].m_Type >= 0)
+				aIndices[NumIndices++] = i;
+		}
+		SnapEvents(aIndices, NumIndices);
+		return;
+	}
+
+	if(!m_CellsValid)
+		BuildCells();
+
+	const float Radius = 1500.0f;
+	vec2 ViewPos = GameServer()->m_apPlayers[SnappingClient]->m_ViewPos;
+	int MinX = CellCoord((int)(ViewPos.x - Radius));
+	int MinY = CellCoord((int)(ViewPos.y - Radius));
+	int MaxX = CellCoord((int)(ViewPos.x + Radius));
+	int MaxY = CellCoord((int)(ViewPos.y + Radius));
+
+	for(int y = MinY; y <= MaxY; y++)
+	{
+		for(int x = MinX; x <= MaxX; x++)
+		{
+			for(int i = m_aCellFirst[CellBucket(x, y)]; i >= 0; i = m_pEvents[i].m_CellNext)
 			{
-				void *d = GameServer()->Server()->SnapNewItem(m_aTypes[i], i, m_aSizes[i]);
-				if(d)
-					mem_copy(d, &m_aData[m_aOffsets[i]], m_aSizes[i]);
+				const CEvent *pEvent = &m_pEvents[i];
+				// different cells can share a bucket, only take the events of this one
+				if(pEvent->m_CellX != x || pEvent->m_CellY != y || !CmaskIsSet(pEvent->m_Mask, SnappingClient))
+					continue;
+
+				const CNetEvent_Common *pCommon = (const CNetEvent_Common *)pEvent->m_aData;
+				if(distance(ViewPos, vec2(pCommon->m_X, pCommon->m_Y)) < Radius)
+					aIndices[NumIndices++] = i;
 			}
 		}
 	}
+
+	SnapEvents(aIndices, NumIndices);
 }
@@ -14,27 +14,105 @@ typedef unsigned __int64 uint64_t;
 //
 class CEventHandler
 {
-	static const int MAX_EVENTS = 128;
-	static const int MAX_DATASIZE = 128*64;
+public:
+	enum
+	{
+		PRIORITY_LOW = 0,
+		PRIORITY_NORMAL,
+		PRIORITY_HIGH,
+		NUM_PRIORITIES,
+	};
+
+	struct CStats
+	{
+		int64_t m_NumCreated;
+		int64_t m_NumCoalesced;
+		int64_t m_NumEvicted;
+		int64_t m_NumDropped;
+		int64_t m_NumSnapDropped; // left out of a client's snapshot, over MAX_SNAP_EVENTS
+		int m_MaxEvents;
+	};
+
+private:
+	enum
+	{
+		MIN_EVENTS = 128,
+		MAX_EVENTS = 1024,
+		MAX_EVENT_SIZE = 32,
+
+		// events sent in one snapshot, the rest of the snapshot items
+		// (world, players) must still fit in CSnapshotBuilder::MAX_ITEMS
+		MAX_SNAP_EVENTS = 128,
 
-	int m_aTypes[MAX_EVENTS]; // TODO: remove some of these arrays
-	int m_aOffsets[MAX_EVENTS];
-	int m_aSizes[MAX_EVENTS];
-	int64_t m_aClientMasks[MAX_EVENTS];
-	char m_aData[MAX_DATASIZE];
+		HASH_SIZE = 1024,
+
+		CELL_SIZE = 1024,
+		NUM_CELL_BUCKETS = 256,
+	};
+
+	struct CEvent
+	{
+		int m_Type; // -1 for a free slot
+		int m_Size;
+		int m_Priority;
+		int64_t m_Mask;
+		unsigned m_Hash;
+		int m_HashNext; // next event with the same hash bucket, or next free slot
+		int m_CellX;
+		int m_CellY;
+		int m_CellNext;
+		int m_aData[MAX_EVENT_SIZE/sizeof(int)];
+	};
 
 	class CGameContext *m_pGameServer;
 
-	int m_CurrentOffset;
+	// arena of event slots, grown on demand up to MAX_EVENTS and kept between ticks
+	CEvent *m_pEvents;
+	int m_Capacity;
 	int m_NumEvents;
+	int m_FirstFree;
+	int m_aNumPriority[NUM_PRIORITIES];
+	int m_aEvictCursor[NUM_PRIORITIES];
+
+	// the last created event is still being filled by the caller,
+	// it is checked for duplicates on the next Create() or Snap()
+	int m_Pending;
+	int m_aHashFirst[HASH_SIZE];
+
+	// events bucketed by position, rebuilt once per snapshot
+	bool m_CellsValid;
+	int m_aCellFirst[NUM_CELL_BUCKETS];
+
+	CStats m_TickStats;
+	CStats m_LastTickStats;
+	CStats m_TotalStats;
+
+	static unsigned HashEvent(const CEvent *pEvent);
+	static int CellCoord(int Value);
+	static int CellBucket(int CellX, int CellY);
+
+	int AllocEvent(int Priority);
+	void FreeEvent(int Index);
+	void UnlinkHash(int Index);
+	void CommitPending();
+	void BuildCells();
+	void SnapEvent(int Index);
+	void SnapEvents(const int *pIndices, int NumIndices);
+
 public:
 	CGameContext *GameServer() const { return m_pGameServer; }
 	void SetGameServer(CGameContext *pGameServer);
 
 	CEventHandler();
-	void *Create(int Type, int Size, int64_t Mask = -1LL);
+	~CEventHandler();
+	void *Create(int Type, int Size, int64_t Mask = -1LL, int Priority = PRIORITY_NORMAL);
 	void Clear();
 	void Snap(int SnappingClient);
+
+	const CStats *GetLastTickStats() const { return &m_LastTickStats; }
+	const CStats *GetTotalStats() const { return &m_TotalStats; }
+	int Capacity() const { return m_Capacity; }
+	void ResetStats();
 };
 
 #endif
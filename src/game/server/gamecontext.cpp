@@ -300,7 +300,7 @@ void CGameContext::CreateDamageInd(vec2 Pos, float Angle, int Amount)
 	for(int i = 0; i < Amount; i++)
 	{
 		float f = mix(s, e, float(i+1)/float(Amount+2));
-		CNetEvent_DamageInd *pEvent = (CNetEvent_DamageInd *)m_Events.Create(NETEVENTTYPE_DAMAGEIND, sizeof(CNetEvent_DamageInd));
+		CNetEvent_DamageInd *pEvent = (CNetEvent_DamageInd *)m_Events.Create(NETEVENTTYPE_DAMAGEIND, sizeof(CNetEvent_DamageInd), -1LL, CEventHandler::PRIORITY_LOW);
 		if(pEvent)
 		{
 			pEvent->m_X = (int)Pos.x;
@@ -313,7 +313,7 @@ void CGameContext::CreateDamageInd(vec2 Pos, float Angle, int Amount)
 void CGameContext::CreateHammerHit(vec2 Pos)
 {
 	// create the event
-	CNetEvent_HammerHit *pEvent = (CNetEvent_HammerHit *)m_Events.Create(NETEVENTTYPE_HAMMERHIT, sizeof(CNetEvent_HammerHit));
+	CNetEvent_HammerHit *pEvent = (CNetEvent_HammerHit *)m_Events.Create(NETEVENTTYPE_HAMMERHIT, sizeof(CNetEvent_HammerHit), -1LL, CEventHandler::PRIORITY_LOW);
 	if(pEvent)
 	{
 		pEvent->m_X = (int)Pos.x;
@@ -427,7 +427,7 @@ void CGameContext::CreateExplosionDisk(vec2 Pos, float InnerRadius, float Damage
 	float AngleStep = pi*2.0f/static_cast<float>(NumSuroundingExplosions);
 	for(int i=0; i<NumSuroundingExplosions; i++)
 	{
-		CNetEvent_Explosion *pEvent = (CNetEvent_Explosion *)m_Events.Create(NETEVENTTYPE_EXPLOSION, sizeof(CNetEvent_Explosion));
+		CNetEvent_Explosion *pEvent = (CNetEvent_Explosion *)m_Events.Create(NETEVENTTYPE_EXPLOSION, sizeof(CNetEvent_Explosion), -1LL, CEventHandler::PRIORITY_LOW);
 		if(pEvent)
 		{
 			pEvent->m_X = (int)Pos.x + (DamageRadius-135.0f) * cos(AngleStart + i*AngleStep);
@@ -451,7 +451,7 @@ void create_smoke(vec2 Pos)
 void CGameContext::CreatePlayerSpawn(vec2 Pos)
 {
 	// create the event
-	CNetEvent_Spawn *ev = (CNetEvent_Spawn *)m_Events.Create(NETEVENTTYPE_SPAWN, sizeof(CNetEvent_Spawn));
+	CNetEvent_Spawn *ev = (CNetEvent_Spawn *)m_Events.Create(NETEVENTTYPE_SPAWN, sizeof(CNetEvent_Spawn), -1LL, CEventHandler::PRIORITY_HIGH);
 	if(ev)
 	{
 		ev->m_X = (int)Pos.x;
@@ -477,7 +477,7 @@ void CGameContext::CreateSound(vec2 Pos, int Sound, int64_t Mask)
 		return;
 
 	// create a sound
-	CNetEvent_SoundWorld *pEvent = (CNetEvent_SoundWorld *)m_Events.Create(NETEVENTTYPE_SOUNDWORLD, sizeof(CNetEvent_SoundWorld), Mask);
+	CNetEvent_SoundWorld *pEvent = (CNetEvent_SoundWorld *)m_Events.Create(NETEVENTTYPE_SOUNDWORLD, sizeof(CNetEvent_SoundWorld), Mask, CEventHandler::PRIORITY_HIGH);
 	if(pEvent)
 	{
 		pEvent->m_X = (int)Pos.x;
@@ -518,6 +518,31 @@ void CGameContext::SendChatTarget(int To, const char *pText)
 }
 
 /* INFECTION MODIFICATION START ***************************************/
+static void AppendChatCategory(dynamic_string& Buffer, int Category)
+{
+	switch(Category)
+	{
+		case CHATCATEGORY_INFECTION:
+			Buffer.append("☣ | ");
+			break;
+		case CHATCATEGORY_SCORE:
+			Buffer.append("★ | ");
+			break;
+		case CHATCATEGORY_PLAYER:
+			Buffer.append("♟ | ");
+			break;
+		case CHATCATEGORY_INFECTED:
+			Buffer.append("⛃ | ");
+			break;
+		case CHATCATEGORY_HUMANS:
+			Buffer.append("⛁ | ");
+			break;
+		case CHATCATEGORY_ACCUSATION:
+			Buffer.append("☹ | ");
+			break;
+	}
+}
+
 void CGameContext::SendChatTarget_Localization(int To, int Category, const char* pText, ...)
 {
 	int Start = (To < 0 ? 0 : To);
@@ -532,45 +557,35 @@ void CGameContext::SendChatTarget_Localization(int To, int Category, const char*
 	va_list VarArgs;
 	va_start(VarArgs, pText);
 	
+	if(To < 0)
+	{
+		// one message for record
+		AppendChatCategory(Buffer, Category);
+		Server()->Localization()->Format_VL(Buffer, "en", pText, VarArgs);
+		Msg.m_pMessage = Buffer.buffer();
+		Server()->SendPackMsg(&Msg, MSGFLAG_VITAL|MSGFLAG_NOSEND, -1);
+	}
+	
+	// format the message once per language and send it to everybody who uses it
+	bool aSent[MAX_CLIENTS] = { false };
 	for(int i = Start; i < End; i++)
 	{
-		if(m_apPlayers[i])
+		if(!m_apPlayers[i] || aSent[i])
+			continue;
+		
+		int LanguageID = m_apPlayers[i]->GetLanguageID();
+		Buffer.clear();
+		AppendChatCategory(Buffer, Category);
+		Server()->Localization()->Format_VL(Buffer, LanguageID, pText, VarArgs);
+		Msg.m_pMessage = Buffer.buffer();
+		
+		for(int j = i; j < End; j++)
 		{
-			Buffer.clear();
-			switch(Category)
-			{
-				case CHATCATEGORY_INFECTION:
-					Buffer.append("☣ | ");
-					break;
-				case CHATCATEGORY_SCORE:
-					Buffer.append("★ | ");
-					break;
-				case CHATCATEGORY_PLAYER:
-					Buffer.append("♟ | ");
-					break;
-				case CHATCATEGORY_INFECTED:
-					Buffer.append("⛃ | ");
-					break;
-				case CHATCATEGORY_HUMANS:
-					Buffer.append("⛁ | ");
-					break;
-				case CHATCATEGORY_ACCUSATION:
-					Buffer.append("☹ | ");
-					break;
-			}
-			if(To < 0 && i == 0)
+			if(m_apPlayers[j] && !aSent[j] && m_apPlayers[j]->GetLanguageID() == LanguageID)
 			{
-				// one message for record
-				dynamic_string tmpBuf;
-				tmpBuf.copy(Buffer);
-				Server()->Localization()->Format_VL(tmpBuf, "en", pText, VarArgs);
-				Msg.m_pMessage = tmpBuf.buffer();
-				Server()->SendPackMsg(&Msg, MSGFLAG_VITAL|MSGFLAG_NOSEND, -1);
+				Server()->SendPackMsg(&Msg, MSGFLAG_VITAL|MSGFLAG_NORECORD, j);
+				aSent[j] = true;
 			}
-			Server()->Localization()->Format_VL(Buffer, m_apPlayers[i]->GetLanguage(), pText, VarArgs);
-			
-			Msg.m_pMessage = Buffer.buffer();
-			Server()->SendPackMsg(&Msg, MSGFLAG_VITAL|MSGFLAG_NORECORD, i);
 		}
 	}
 	
@@ -591,36 +606,25 @@ void CGameContext::SendChatTarget_Localization_P(int To, int Category, int Numbe
 	va_list VarArgs;
 	va_start(VarArgs, pText);
 	
+	bool aSent[MAX_CLIENTS] = { false };
 	for(int i = Start; i < End; i++)
 	{
-		if(m_apPlayers[i])
+		if(!m_apPlayers[i] || aSent[i])
+			continue;
+		
+		int LanguageID = m_apPlayers[i]->GetLanguageID();
+		Buffer.clear();
+		AppendChatCategory(Buffer, Category);
+		Server()->Localization()->Format_VLP(Buffer, LanguageID, Number, pText, VarArgs);
+		Msg.m_pMessage = Buffer.buffer();
+		
+		for(int j = i; j < End; j++)
 		{
-			Buffer.clear();
-			switch(Category)
+			if(m_apPlayers[j] && !aSent[j] && m_apPlayers[j]->GetLanguageID() == LanguageID)
 			{
-				case CHATCATEGORY_INFECTION:
-					Buffer.append("☣ | ");
-					break;
-				case CHATCATEGORY_SCORE:
-					Buffer.append("★ | ");
-					break;
-				case CHATCATEGORY_PLAYER:
-					Buffer.append("♟ | ");
-					break;
-				case CHATCATEGORY_INFECTED:
-					Buffer.append("⛃ | ");
-					break;
-				case CHATCATEGORY_HUMANS:
-					Buffer.append("⛁ | ");
-					break;
-				case CHATCATEGORY_ACCUSATION:
-					Buffer.append("☹ | ");
-					break;
+				Server()->SendPackMsg(&Msg, MSGFLAG_VITAL, j);
+				aSent[j] = true;
 			}
-			Server()->Localization()->Format_VLP(Buffer, m_apPlayers[i]->GetLanguage(), Number, pText, VarArgs);
-			
-			Msg.m_pMessage = Buffer.buffer();
-			Server()->SendPackMsg(&Msg, MSGFLAG_VITAL, i);
 		}
 	}
 	
@@ -649,7 +653,7 @@ void CGameContext::SendMOTD_Localization(int To, const char* pText, ...)
 		va_list VarArgs;
 		va_start(VarArgs, pText);
 		
-		Server()->Localization()->Format_VL(Buffer, m_apPlayers[To]->GetLanguage(), pText, VarArgs);
+		Server()->Localization()->Format_VL(Buffer, m_apPlayers[To]->GetLanguageID(), pText, VarArgs);
 	
 		va_end(VarArgs);
 		
@@ -723,13 +727,23 @@ void CGameContext::SendBroadcast_Localization(int To, int Priority, int LifeSpan
 		Server()->SendPackMsg(&Msg, MSGFLAG_VITAL|MSGFLAG_NOSEND, -1);
 	}
 
+	bool aSent[MAX_CLIENTS] = { false };
 	for(int i = Start; i < End; i++)
 	{
-		if(m_apPlayers[i])
+		if(!m_apPlayers[i] || aSent[i])
+			continue;
+		
+		int LanguageID = m_apPlayers[i]->GetLanguageID();
+		Buffer.clear();
+		Server()->Localization()->Format_VL(Buffer, LanguageID, pText, VarArgs);
+		
+		for(int j = i; j < End; j++)
 		{
-			Buffer.clear();
-			Server()->Localization()->Format_VL(Buffer, m_apPlayers[i]->GetLanguage(), pText, VarArgs);
-			AddBroadcast(i, Buffer.buffer(), Priority, LifeSpan);
+			if(m_apPlayers[j] && !aSent[j] && m_apPlayers[j]->GetLanguageID() == LanguageID)
+			{
+				AddBroadcast(j, Buffer.buffer(), Priority, LifeSpan);
+				aSent[j] = true;
+			}
 		}
 	}
 	
@@ -746,12 +760,23 @@ void CGameContext::SendBroadcast_Localization_P(int To, int Priority, int LifeSp
 	va_list VarArgs;
 	va_start(VarArgs, pText);
 	
+	bool aSent[MAX_CLIENTS] = { false };
 	for(int i = Start; i < End; i++)
 	{
-		if(m_apPlayers[i])
+		if(!m_apPlayers[i] || aSent[i])
+			continue;
+		
+		int LanguageID = m_apPlayers[i]->GetLanguageID();
+		Buffer.clear();
+		Server()->Localization()->Format_VLP(Buffer, LanguageID, Number, pText, VarArgs);
+		
+		for(int j = i; j < End; j++)
 		{
-			Server()->Localization()->Format_VLP(Buffer, m_apPlayers[i]->GetLanguage(), Number, pText, VarArgs);
-			AddBroadcast(i, Buffer.buffer(), Priority, LifeSpan);
+			if(m_apPlayers[j] && !aSent[j] && m_apPlayers[j]->GetLanguageID() == LanguageID)
+			{
+				AddBroadcast(j, Buffer.buffer(), Priority, LifeSpan);
+				aSent[j] = true;
+			}
 		}
 	}
 	
@@ -1027,11 +1052,10 @@ void CGameContext::SendTuningParams(int ClientID)
 {
 	CheckPureTuning();
 
-	CMsgPacker Msg(NETMSGTYPE_SV_TUNEPARAMS);
-	int *pParams = (int *)&m_Tuning;
-	for(unsigned i = 0; i < sizeof(m_Tuning)/sizeof(int); i++)
-		Msg.AddInt(pParams[i]);
-	Server()->SendMsg(&Msg, MSGFLAG_VITAL, ClientID);
+	const CTuningCache::CEntry *pEntry = m_TuningCache.Intern(&m_Tuning);
+	m_TuningCache.Send(pEntry, ClientID);
+	if(ClientID >= 0 && m_apPlayers[ClientID])
+		m_apPlayers[ClientID]->m_SentTuningID = pEntry->m_ID;
 }
 
 void CGameContext::SendHitSound(int ClientID)
@@ -2076,6 +2100,7 @@ void CGameContext::OnMessage(int MsgID, CUnpacker *pUnpacker, int ClientID)
 			//~ pPlayer->m_TeeInfos.m_UseCustomColor = pMsg->m_UseCustomColor;
 			//~ pPlayer->m_TeeInfos.m_ColorBody = pMsg->m_ColorBody;
 			//~ pPlayer->m_TeeInfos.m_ColorFeet = pMsg->m_ColorFeet;
+			pPlayer->InvalidateSnapInfo();
 /* INFECTION MODIFICATION END *****************************************/
 
 			m_pController->OnPlayerInfoChange(pPlayer);
@@ -2127,6 +2152,7 @@ void CGameContext::OnMessage(int MsgID, CUnpacker *pUnpacker, int ClientID)
 			//~ pPlayer->m_TeeInfos.m_UseCustomColor = pMsg->m_UseCustomColor;
 			//~ pPlayer->m_TeeInfos.m_ColorBody = pMsg->m_ColorBody;
 			//~ pPlayer->m_TeeInfos.m_ColorFeet = pMsg->m_ColorFeet;
+			pPlayer->InvalidateSnapInfo();
 			m_pController->OnPlayerInfoChange(pPlayer);
 
 			if(!Server()->GetClientMemory(ClientID, CLIENTMEMORY_LANGUAGESELECTION))
@@ -2485,6 +2511,79 @@ bool CGameContext::ConTuneDump(IConsole::IResult *pResult, void *pUserData)
 	return true;
 }
 
+bool CGameContext::ConWorldQueryStats(IConsole::IResult *pResult, void *pUserData)
+{
+	CGameContext *pSelf = (CGameContext *)pUserData;
+	char aBuf[256];
+	for(int i = 0; i < CGameWorld::NUM_ENTTYPES; i++)
+	{
+		const CGameWorld::CQueryStats *pStats = pSelf->m_World.GetQueryStats(i);
+		if(pStats->m_NumQueries == 0)
+			continue;
+		str_format(aBuf, sizeof(aBuf), "type=%d entities=%d queries=%lld grid=%lld visited=%lld time=%.3fms",
+			i, pSelf->m_World.NumEntities(i), pStats->m_NumQueries, pStats->m_NumGridQueries, pStats->m_NumVisited,
+			pStats->m_Time*1000.0/(double)time_freq());
+		pSelf->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "world", aBuf);
+	}
+
+	if(pResult->NumArguments() && pResult->GetInteger(0))
+		pSelf->m_World.ResetQueryStats();
+
+	return true;
+}
+
+bool CGameContext::ConEventStats(IConsole::IResult *pResult, void *pUserData)
+{
+	CGameContext *pSelf = (CGameContext *)pUserData;
+	char aBuf[256];
+	const CEventHandler::CStats *pLast = pSelf->m_Events.GetLastTickStats();
+	str_format(aBuf, sizeof(aBuf), "last tick: created=%lld coalesced=%lld evicted=%lld dropped=%lld snap_dropped=%lld events=%d capacity=%d",
+		pLast->m_NumCreated, pLast->m_NumCoalesced, pLast->m_NumEvicted, pLast->m_NumDropped, pLast->m_NumSnapDropped, pLast->m_MaxEvents, pSelf->m_Events.Capacity());
+	pSelf->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "events", aBuf);
+	const CEventHandler::CStats *pTotal = pSelf->m_Events.GetTotalStats();
+	str_format(aBuf, sizeof(aBuf), "total: created=%lld coalesced=%lld evicted=%lld dropped=%lld snap_dropped=%lld peak=%d",
+		pTotal->m_NumCreated, pTotal->m_NumCoalesced, pTotal->m_NumEvicted, pTotal->m_NumDropped, pTotal->m_NumSnapDropped, pTotal->m_MaxEvents);
+	pSelf->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "events", aBuf);
+
+	if(pResult->NumArguments() && pResult->GetInteger(0))
+		pSelf->m_Events.ResetStats();
+
+	return true;
+}
+
+bool CGameContext::ConTuningStats(IConsole::IResult *pResult, void *pUserData)
+{
+	CGameContext *pSelf = (CGameContext *)pUserData;
+	char aBuf[256];
+	const CTuningCache::CStats *pStats = pSelf->m_TuningCache.GetStats();
+	str_format(aBuf, sizeof(aBuf), "sent last second=%d sent=%lld cached sets=%d packed=%lld evicted=%lld",
+		pSelf->m_TuningCache.NumSentLastSecond(), pStats->m_NumSent, pSelf->m_TuningCache.NumEntries(), pStats->m_NumPacked, pStats->m_NumEvicted);
+	pSelf->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "tuning", aBuf);
+
+	if(pResult->NumArguments() && pResult->GetInteger(0))
+		pSelf->m_TuningCache.ResetStats();
+
+	return true;
+}
+
+bool CGameContext::ConEntityPoolStats(IConsole::IResult *pResult, void *pUserData)
+{
+	CGameContext *pSelf = (CGameContext *)pUserData;
+	bool Reset = pResult->NumArguments() && pResult->GetInteger(0);
+	char aBuf[256];
+	for(CEntitySlab *pSlab = CEntitySlab::First(); pSlab; pSlab = pSlab->Next())
+	{
+		str_format(aBuf, sizeof(aBuf), "%s live=%d peak=%d capacity=%d",
+			pSlab->Name(), pSlab->NumLive(), pSlab->NumPeak(), pSlab->Capacity());
+		pSelf->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "entities", aBuf);
+
+		if(Reset)
+			pSlab->ResetPeak();
+	}
+
+	return true;
+}
+
 bool CGameContext::ConPause(IConsole::IResult *pResult, void *pUserData)
 {
 	CGameContext *pSelf = (CGameContext *)pUserData;
@@ -4378,7 +4477,7 @@ bool CGameContext::ConTeleport(IConsole::IResult *pResult, void *pUserData)
 void CGameContext::Teleport(CCharacter *pChr, vec2 Pos)
 {
 	pChr->SetPos(Pos);
-	pChr->m_Pos = Pos;
+	pChr->SetPosition(Pos);
 }
 
 bool CGameContext::ConWitch(IConsole::IResult *pResult, void *pUserData)
@@ -4446,6 +4545,10 @@ void CGameContext::OnConsoleInit()
 	Console()->Register("tune", "s<param> i<value>", CFGFLAG_SERVER, ConTuneParam, this, "Tune variable to value");
 	Console()->Register("tune_reset", "", CFGFLAG_SERVER, ConTuneReset, this, "Reset tuning");
 	Console()->Register("tune_dump", "", CFGFLAG_SERVER, ConTuneDump, this, "Dump tuning");
+	Console()->Register("world_query_stats", "?i<reset>", CFGFLAG_SERVER, ConWorldQueryStats, this, "Dump entity query counters per entity type");
+	Console()->Register("event_stats", "?i<reset>", CFGFLAG_SERVER, ConEventStats, this, "Dump created, coalesced and dropped event counters");
+	Console()->Register("tuning_stats", "?i<reset>", CFGFLAG_SERVER, ConTuningStats, this, "Dump the sent tuning messages and the cached tuning sets");
+	Console()->Register("entity_pool_stats", "?i<reset>", CFGFLAG_SERVER, ConEntityPoolStats, this, "Dump the live and peak entity counts of each entity type");
 
 	Console()->Register("pause", "", CFGFLAG_SERVER, ConPause, this, "Pause/unpause game");
 	Console()->Register("change_map", "?r", CFGFLAG_SERVER|CFGFLAG_STORE, ConChangeMap, this, "Change map");
@@ -4499,6 +4602,7 @@ void CGameContext::OnInit(/*class IKernel *pKernel*/)
 	m_pConsole = Kernel()->RequestInterface<IConsole>();
 	m_World.SetGameServer(this);
 	m_Events.SetGameServer(this);
+	m_TuningCache.SetGameServer(this);
 	
 	for(int i=0; i<MAX_CLIENTS; i++)
 	{
@@ -4710,9 +4814,14 @@ void CGameContext::FlagCollected()
 	m_HeroGiftCooldown = Server()->TickSpeed() * (15+(120*t));
 }
 
-void CGameContext::OnPreSnap() {}
+void CGameContext::OnPreSnap()
+{
+	m_World.PreSnap();
+}
+
 void CGameContext::OnPostSnap()
 {
+	m_World.PostSnap();
 	m_Events.Clear();
 }
 
@@ -15,6 +15,7 @@
 #include <teeuniverses/components/localization.h>
 
 #include "eventhandler.h"
+#include "tuningcache.h"
 #include "gamecontroller.h"
 #include "gameworld.h"
 #include "player.h"
@@ -92,6 +93,10 @@ class CGameContext : public IGameServer
 	static bool ConTuneParam(IConsole::IResult *pResult, void *pUserData);
 	static bool ConTuneReset(IConsole::IResult *pResult, void *pUserData);
 	static bool ConTuneDump(IConsole::IResult *pResult, void *pUserData);
+	static bool ConWorldQueryStats(IConsole::IResult *pResult, void *pUserData);
+	static bool ConEventStats(IConsole::IResult *pResult, void *pUserData);
+	static bool ConTuningStats(IConsole::IResult *pResult, void *pUserData);
+	static bool ConEntityPoolStats(IConsole::IResult *pResult, void *pUserData);
 	static bool ConPause(IConsole::IResult *pResult, void *pUserData);
 	static bool ConChangeMap(IConsole::IResult *pResult, void *pUserData);
 	static bool ConSkipMap(IConsole::IResult *pResult, void *pUserData);
@@ -135,6 +140,7 @@ public:
 	void Clear();
 
 	CEventHandler m_Events;
+	CTuningCache m_TuningCache;
 	CPlayer *m_apPlayers[MAX_CLIENTS];
 
 	IGameController *m_pController;
@@ -18,8 +18,32 @@ CGameWorld::CGameWorld()
 
 	m_Paused = false;
 	m_ResetRequested = false;
+	m_pNextTraverseEntity = 0;
 	for(int i = 0; i < NUM_ENTTYPES; i++)
+	{
 		m_apFirstEntityTypes[i] = 0;
+		m_aNumEntities[i] = 0;
+		m_aMaxProximityRadius[i] = 0.0f;
+	}
+	for(int i = 0; i < NUM_GRID_BUCKETS; i++)
+		m_apGridBuckets[i] = 0;
+	for(int c = 0; c < MAX_CLIENTS; c++)
+	{
+		for(int i = 0; i < NUM_ENTTYPES; i++)
+		{
+			m_aapFirstOwnedEntities[c][i] = 0;
+			m_aaNumOwnedEntities[c][i] = 0;
+		}
+	}
+	m_NextEntitySeq = 0;
+	ResetQueryStats();
+
+	for(int i = 0; i < NUM_SNAPVARIANTS; i++)
+	{
+		m_aNumSharedSnapEntities[i] = 0;
+		m_aSharedSnapValid[i] = false;
+	}
+	m_SharedSnapVariant = -1;
 }
 
 CGameWorld::~CGameWorld()
@@ -41,24 +65,243 @@ CEntity *CGameWorld::FindFirst(int Type)
 	return Type < 0 || Type >= NUM_ENTTYPES ? 0 : m_apFirstEntityTypes[Type];
 }
 
+CEntity *CGameWorld::FindFirstOwned(int Owner, int Type)
+{
+	if(Owner < 0 || Owner >= MAX_CLIENTS || Type < 0 || Type >= NUM_ENTTYPES)
+		return 0;
+	return m_aapFirstOwnedEntities[Owner][Type];
+}
+
+int CGameWorld::NumOwnedEntities(int Owner, int Type) const
+{
+	if(Owner < 0 || Owner >= MAX_CLIENTS || Type < 0 || Type >= NUM_ENTTYPES)
+		return 0;
+	return m_aaNumOwnedEntities[Owner][Type];
+}
+
+int CGameWorld::GridCoord(float Value)
+{
+	// keep NaN and far away positions inside the int range
+	if(!(Value > -1000000.0f))
+		Value = -1000000.0f;
+	else if(Value > 1000000.0f)
+		Value = 1000000.0f;
+	return (int)floorf(Value / GRID_CELL_SIZE);
+}
+
+int CGameWorld::GridBucket(int Type, int CellX, int CellY)
+{
+	unsigned Hash = (unsigned)CellX * 73856093u ^ (unsigned)CellY * 19349663u ^ (unsigned)Type * 83492791u;
+	return Hash & (NUM_GRID_BUCKETS - 1);
+}
+
+void CGameWorld::GridLink(CEntity *pEnt)
+{
+	pEnt->m_CellX = GridCoord(pEnt->m_Pos.x);
+	pEnt->m_CellY = GridCoord(pEnt->m_Pos.y);
+	pEnt->m_GridBucket = GridBucket(pEnt->m_ObjType, pEnt->m_CellX, pEnt->m_CellY);
+
+	CEntity **ppFirst = &m_apGridBuckets[pEnt->m_GridBucket];
+	if(*ppFirst)
+		(*ppFirst)->m_pPrevCellEntity = pEnt;
+	pEnt->m_pNextCellEntity = *ppFirst;
+	pEnt->m_pPrevCellEntity = 0x0;
+	*ppFirst = pEnt;
+
+	if(pEnt->m_ProximityRadius > m_aMaxProximityRadius[pEnt->m_ObjType])
+		m_aMaxProximityRadius[pEnt->m_ObjType] = pEnt->m_ProximityRadius;
+}
+
+void CGameWorld::GridUnlink(CEntity *pEnt)
+{
+	if(pEnt->m_GridBucket < 0)
+		return;
+
+	if(pEnt->m_pPrevCellEntity)
+		pEnt->m_pPrevCellEntity->m_pNextCellEntity = pEnt->m_pNextCellEntity;
+	else
+		m_apGridBuckets[pEnt->m_GridBucket] = pEnt->m_pNextCellEntity;
+	if(pEnt->m_pNextCellEntity)
+		pEnt->m_pNextCellEntity->m_pPrevCellEntity = pEnt->m_pPrevCellEntity;
+
+	pEnt->m_pNextCellEntity = 0;
+	pEnt->m_pPrevCellEntity = 0;
+	pEnt->m_GridBucket = -1;
+}
+
+void CGameWorld::OwnerLink(CEntity *pEnt)
+{
+	if(pEnt->m_IndexedOwner < 0)
+		return;
+
+	CEntity **ppFirst = &m_aapFirstOwnedEntities[pEnt->m_IndexedOwner][pEnt->m_ObjType];
+	if(*ppFirst)
+		(*ppFirst)->m_pPrevOwnerEntity = pEnt;
+	pEnt->m_pNextOwnerEntity = *ppFirst;
+	pEnt->m_pPrevOwnerEntity = 0;
+	*ppFirst = pEnt;
+	m_aaNumOwnedEntities[pEnt->m_IndexedOwner][pEnt->m_ObjType]++;
+}
+
+void CGameWorld::OwnerUnlink(CEntity *pEnt)
+{
+	if(pEnt->m_IndexedOwner < 0)
+		return;
+
+	if(pEnt->m_pPrevOwnerEntity)
+		pEnt->m_pPrevOwnerEntity->m_pNextOwnerEntity = pEnt->m_pNextOwnerEntity;
+	else
+		m_aapFirstOwnedEntities[pEnt->m_IndexedOwner][pEnt->m_ObjType] = pEnt->m_pNextOwnerEntity;
+	if(pEnt->m_pNextOwnerEntity)
+		pEnt->m_pNextOwnerEntity->m_pPrevOwnerEntity = pEnt->m_pPrevOwnerEntity;
+
+	pEnt->m_pNextOwnerEntity = 0;
+	pEnt->m_pPrevOwnerEntity = 0;
+	m_aaNumOwnedEntities[pEnt->m_IndexedOwner][pEnt->m_ObjType]--;
+}
+
+void CGameWorld::SetEntityOwner(CEntity *pEnt, int Owner)
+{
+	if(Owner < 0 || Owner >= MAX_CLIENTS)
+		Owner = -1;
+	if(Owner == pEnt->m_IndexedOwner)
+		return;
+
+	// only entities in the world are linked
+	bool InWorld = pEnt->m_GridBucket >= 0;
+	if(InWorld)
+		OwnerUnlink(pEnt);
+	pEnt->m_IndexedOwner = Owner;
+	if(InWorld)
+		OwnerLink(pEnt);
+}
+
+void CGameWorld::UpdateEntityCell(CEntity *pEnt)
+{
+	// not in the world
+	if(pEnt->m_GridBucket < 0)
+		return;
+
+	if(pEnt->m_ProximityRadius > m_aMaxProximityRadius[pEnt->m_ObjType])
+		m_aMaxProximityRadius[pEnt->m_ObjType] = pEnt->m_ProximityRadius;
+
+	if(GridCoord(pEnt->m_Pos.x) == pEnt->m_CellX && GridCoord(pEnt->m_Pos.y) == pEnt->m_CellY)
+		return;
+
+	GridUnlink(pEnt);
+	GridLink(pEnt);
+}
+
+bool CGameWorld::CompareWorldOrder(const CEntity *pA, const CEntity *pB)
+{
+	return pA->m_WorldSeq > pB->m_WorldSeq;
+}
+
+// Collects all entities of a type whose grid cell overlaps the given box,
+// in the same order as the type list. Returns -1 if a plain list walk is
+// cheaper or the candidates don't fit.
+int CGameWorld::CollectEntities(int Type, vec2 Min, vec2 Max, CEntity **ppEnts, int MaxEnts)
+{
+	if(m_aNumEntities[Type] == 0)
+		return 0;
+
+	// compare in float, huge radii would overflow the cell count
+	float NumCells = (floorf(Max.x / GRID_CELL_SIZE) - floorf(Min.x / GRID_CELL_SIZE) + 1.0f) *
+		(floorf(Max.y / GRID_CELL_SIZE) - floorf(Min.y / GRID_CELL_SIZE) + 1.0f);
+	if(!(NumCells <= (float)m_aNumEntities[Type]))
+		return -1;
+
+	int MinX = GridCoord(Min.x);
+	int MinY = GridCoord(Min.y);
+	int MaxX = GridCoord(Max.x);
+	int MaxY = GridCoord(Max.y);
+
+	int Num = 0;
+	for(int y = MinY; y <= MaxY; y++)
+		for(int x = MinX; x <= MaxX; x++)
+		{
+			for(CEntity *pEnt = m_apGridBuckets[GridBucket(Type, x, y)]; pEnt; pEnt = pEnt->m_pNextCellEntity)
+			{
+				if(pEnt->m_ObjType != Type || pEnt->m_CellX != x || pEnt->m_CellY != y)
+					continue;
+				if(Num == MaxEnts)
+					return -1;
+				ppEnts[Num++] = pEnt;
+			}
+		}
+
+	// restore the list order, the candidate count is small and mostly presorted
+	for(int i = 1; i < Num; i++)
+	{
+		CEntity *pEnt = ppEnts[i];
+		int j = i;
+		for(; j > 0 && CompareWorldOrder(pEnt, ppEnts[j-1]); j--)
+			ppEnts[j] = ppEnts[j-1];
+		ppEnts[j] = pEnt;
+	}
+	return Num;
+}
+
+void CGameWorld::RecordQuery(int Type, bool UsedGrid, int NumVisited, int64 StartTime)
+{
+	CQueryStats *pStats = &m_aQueryStats[Type];
+	pStats->m_NumQueries++;
+	if(UsedGrid)
+		pStats->m_NumGridQueries++;
+	pStats->m_NumVisited += NumVisited;
+	pStats->m_Time += time_get() - StartTime;
+}
+
+void CGameWorld::ResetQueryStats()
+{
+	mem_zero(m_aQueryStats, sizeof(m_aQueryStats));
+}
+
 int CGameWorld::FindEntities(vec2 Pos, float Radius, CEntity **ppEnts, int Max, int Type)
 {
 	if(Type < 0 || Type >= NUM_ENTTYPES)
 		return 0;
 
+	int64 StartTime = time_get();
+	CEntity *apCandidates[MAX_GRID_CANDIDATES];
+	float Reach = Radius + m_aMaxProximityRadius[Type];
+	int NumCandidates = CollectEntities(Type, Pos - vec2(Reach, Reach), Pos + vec2(Reach, Reach), apCandidates, MAX_GRID_CANDIDATES);
+
 	int Num = 0;
-	for(CEntity *pEnt = m_apFirstEntityTypes[Type];	pEnt; pEnt = pEnt->m_pNextTypeEntity)
+	int NumVisited = 0;
+	if(NumCandidates >= 0)
 	{
-		if(distance(pEnt->m_Pos, Pos) < Radius+pEnt->m_ProximityRadius)
+		for(int i = 0; i < NumCandidates; i++)
 		{
-			if(ppEnts)
-				ppEnts[Num] = pEnt;
-			Num++;
-			if(Num == Max)
-				break;
+			CEntity *pEnt = apCandidates[i];
+			NumVisited++;
+			if(distance(pEnt->m_Pos, Pos) < Radius+pEnt->m_ProximityRadius)
+			{
+				if(ppEnts)
+					ppEnts[Num] = pEnt;
+				Num++;
+				if(Num == Max)
+					break;
+			}
+		}
+	}
+	else
+	{
+		for(CEntity *pEnt = m_apFirstEntityTypes[Type];	pEnt; pEnt = pEnt->m_pNextTypeEntity)
+		{
+			NumVisited++;
+			if(distance(pEnt->m_Pos, Pos) < Radius+pEnt->m_ProximityRadius)
+			{
+				if(ppEnts)
+					ppEnts[Num] = pEnt;
+				Num++;
+				if(Num == Max)
+					break;
+			}
 		}
 	}
 
+	RecordQuery(Type, NumCandidates >= 0, NumVisited, StartTime);
 	return Num;
 }
 
@@ -75,6 +318,11 @@ void CGameWorld::InsertEntity(CEntity *pEnt)
 	pEnt->m_pNextTypeEntity = m_apFirstEntityTypes[pEnt->m_ObjType];
 	pEnt->m_pPrevTypeEntity = 0x0;
 	m_apFirstEntityTypes[pEnt->m_ObjType] = pEnt;
+
+	pEnt->m_WorldSeq = m_NextEntitySeq++;
+	m_aNumEntities[pEnt->m_ObjType]++;
+	GridLink(pEnt);
+	OwnerLink(pEnt);
 }
 
 void CGameWorld::DestroyEntity(CEntity *pEnt)
@@ -102,18 +350,133 @@ void CGameWorld::RemoveEntity(CEntity *pEnt)
 
 	pEnt->m_pNextTypeEntity = 0;
 	pEnt->m_pPrevTypeEntity = 0;
+
+	m_aNumEntities[pEnt->m_ObjType]--;
+	GridUnlink(pEnt);
+	OwnerUnlink(pEnt);
 }
 
 //
+void CGameWorld::PreSnap()
+{
+	PostSnap();
+	if(!g_Config.m_SvSharedSnap)
+		return;
+
+	bool aUsed[NUM_SNAPVARIANTS] = {false};
+	for(int i = 0; i < MAX_CLIENTS; i++)
+	{
+		if(Server()->ClientIngame(i) && GameServer()->m_apPlayers[i])
+			aUsed[Server()->GetClientAntiPing(i) ? SNAPVARIANT_ANTIPING : SNAPVARIANT_NORMAL] = true;
+	}
+
+	for(int v = 0; v < NUM_SNAPVARIANTS; v++)
+	{
+		if(aUsed[v])
+			m_aSharedSnapValid[v] = BuildSharedSnap(v);
+	}
+}
+
+bool CGameWorld::BuildSharedSnap(int Variant)
+{
+	CSnapshotBuilder *pBuilder = &m_aSharedSnapBuilders[Variant];
+	CSharedSnapEntity *pEntities = m_aaSharedSnapEntities[Variant];
+	int &NumEntities = m_aNumSharedSnapEntities[Variant];
+
+	pBuilder->Init();
+	NumEntities = 0;
+	m_SharedSnapVariant = Variant;
+	Server()->SnapSetBuilder(pBuilder);
+
+	bool Valid = true;
+	for(int i = 0; i < NUM_ENTTYPES && Valid; i++)
+		for(CEntity *pEnt = m_apFirstEntityTypes[i]; pEnt; )
+		{
+			m_pNextTraverseEntity = pEnt->m_pNextTypeEntity;
+			if(pEnt->IsSnapShared())
+			{
+				if(NumEntities == MAX_SHARED_SNAP_ENTITIES)
+				{
+					Valid = false;
+					break;
+				}
+
+				CSharedSnapEntity *pShared = &pEntities[NumEntities++];
+				pShared->m_FirstItem = pBuilder->NumItems();
+				pShared->m_Clipped = false;
+				pEnt->Snap(-1);
+				pShared->m_NumItems = pBuilder->NumItems() - pShared->m_FirstItem;
+			}
+			pEnt = m_pNextTraverseEntity;
+		}
+
+	Server()->SnapSetBuilder(0);
+	m_SharedSnapVariant = -1;
+
+	// fall back to snapping per client if the shared items don't fit
+	return Valid && !pBuilder->Overflowed();
+}
+
+void CGameWorld::OnSharedSnapClip(vec2 CheckPos)
+{
+	if(m_SharedSnapVariant < 0)
+		return;
+
+	CSharedSnapEntity *pShared = &m_aaSharedSnapEntities[m_SharedSnapVariant][m_aNumSharedSnapEntities[m_SharedSnapVariant]-1];
+	pShared->m_Clipped = true;
+	pShared->m_ClipPos = CheckPos;
+}
+
+void CGameWorld::PostSnap()
+{
+	for(int i = 0; i < NUM_SNAPVARIANTS; i++)
+		m_aSharedSnapValid[i] = false;
+}
+
+void CGameWorld::SnapShared(int SnappingClient, int Variant)
+{
+	CSnapshotBuilder *pBuilder = &m_aSharedSnapBuilders[Variant];
+	vec2 ViewPos = GameServer()->m_apPlayers[SnappingClient]->m_ViewPos;
+
+	for(int i = 0; i < m_aNumSharedSnapEntities[Variant]; i++)
+	{
+		const CSharedSnapEntity *pShared = &m_aaSharedSnapEntities[Variant][i];
+		if(pShared->m_Clipped && CEntity::NetworkClippedView(ViewPos, pShared->m_ClipPos))
+			continue;
+
+		for(int j = pShared->m_FirstItem; j < pShared->m_FirstItem + pShared->m_NumItems; j++)
+		{
+			CSnapshotItem *pItem = pBuilder->GetItem(j);
+			int Size = pBuilder->GetItemSize(j);
+			void *pData = Server()->SnapNewItem(pItem->Type(), pItem->ID(), Size);
+			if(!pData)
+				return;
+			mem_copy(pData, pItem->Data(), Size);
+		}
+	}
+}
+
 void CGameWorld::Snap(int SnappingClient)
 {
+	int Variant = -1;
+	if(SnappingClient >= 0)
+	{
+		Variant = Server()->GetClientAntiPing(SnappingClient) ? SNAPVARIANT_ANTIPING : SNAPVARIANT_NORMAL;
+		if(!m_aSharedSnapValid[Variant])
+			Variant = -1;
+	}
+
 	for(int i = 0; i < NUM_ENTTYPES; i++)
 		for(CEntity *pEnt = m_apFirstEntityTypes[i]; pEnt; )
 		{
 			m_pNextTraverseEntity = pEnt->m_pNextTypeEntity;
-			pEnt->Snap(SnappingClient);
+			if(Variant < 0 || !pEnt->IsSnapShared())
+				pEnt->Snap(SnappingClient);
 			pEnt = m_pNextTraverseEntity;
 		}
+
+	if(Variant >= 0)
+		SnapShared(SnappingClient, Variant);
 }
 
 void CGameWorld::Reset()
@@ -124,6 +487,7 @@ void CGameWorld::Reset()
 		{
 			m_pNextTraverseEntity = pEnt->m_pNextTypeEntity;
 			pEnt->Reset();
+			UpdateEntityCell(pEnt);
 			pEnt = m_pNextTraverseEntity;
 		}
 	RemoveEntities();
@@ -159,63 +523,185 @@ void CGameWorld::UpdatePlayerMaps()
 {
 	if (Server()->Tick() % g_Config.m_SvMapUpdateRate != 0) return;
 
-	std::pair<float,int> dist[MAX_CLIENTS];
-	for (int i = 0; i < MAX_CLIENTS; i++)
+	// every client shows itself and the nearest players in the other slots,
+	// the last slot is kept free for the player with empty name to say chat msgs
+	const int NumNearest = VANILLA_MAX_CLIENTS - 2;
+
+	// index the players that can be shown once for all clients
+	bool aShown[MAX_CLIENTS];
+	vec2 aPos[MAX_CLIENTS];
+	int aShownIDs[MAX_CLIENTS];
+	int NumShown = 0;
+	vec2 Min(0.0f, 0.0f), Max(0.0f, 0.0f);
+	for (int j = 0; j < MAX_CLIENTS; j++)
 	{
-		if (!Server()->ClientIngame(i)) continue;
-		int* map = Server()->GetIdMap(i);
+		aShown[j] = Server()->ClientIngame(j) && GameServer()->m_apPlayers[j] && GameServer()->m_apPlayers[j]->GetCharacter();
+		if (!aShown[j])
+			continue;
+		aPos[j] = GameServer()->m_apPlayers[j]->m_ViewPos;
+		if (NumShown == 0)
+			Min = Max = aPos[j];
+		Min.x = min(Min.x, aPos[j].x);
+		Min.y = min(Min.y, aPos[j].y);
+		Max.x = max(Max.x, aPos[j].x);
+		Max.y = max(Max.y, aPos[j].y);
+		aShownIDs[NumShown++] = j;
+	}
 
-		// compute distances
-		for (int j = 0; j < MAX_CLIENTS; j++)
+	// coarse grid over the players, about two players per cell
+	int GridSize = 1;
+	while ((GridSize + 1) * (GridSize + 1) * 2 <= NumShown)
+		GridSize++;
+	float CellW = max((Max.x - Min.x) / GridSize, 1.0f);
+	float CellH = max((Max.y - Min.y) / GridSize, 1.0f);
+	float MinCell = min(CellW, CellH);
+	int aCellStart[MAX_CLIENTS + 1];
+	int aCellPlayers[MAX_CLIENTS];
+	int aPlayerCell[MAX_CLIENTS];
+	if (NumShown > NumNearest + 1)
+	{
+		int NumCells = GridSize * GridSize;
+		for (int c = 0; c <= NumCells; c++)
+			aCellStart[c] = 0;
+		for (int n = 0; n < NumShown; n++)
 		{
-			dist[j].second = j;
-			dist[j].first = 1e10;
-			if (!Server()->ClientIngame(j))
-				continue;
-			CCharacter* ch = GameServer()->m_apPlayers[j]->GetCharacter();
-			if (!ch)
-				continue;
-			dist[j].first = distance(GameServer()->m_apPlayers[i]->m_ViewPos, GameServer()->m_apPlayers[j]->m_ViewPos);
+			int j = aShownIDs[n];
+			int cx = clamp((int)((aPos[j].x - Min.x) / CellW), 0, GridSize - 1);
+			int cy = clamp((int)((aPos[j].y - Min.y) / CellH), 0, GridSize - 1);
+			aPlayerCell[j] = cy * GridSize + cx;
+			aCellStart[aPlayerCell[j] + 1]++;
 		}
+		for (int c = 0; c < NumCells; c++)
+			aCellStart[c + 1] += aCellStart[c];
+		int aFill[MAX_CLIENTS];
+		for (int c = 0; c < NumCells; c++)
+			aFill[c] = aCellStart[c];
+		for (int n = 0; n < NumShown; n++)
+			aCellPlayers[aFill[aPlayerCell[aShownIDs[n]]]++] = aShownIDs[n];
+	}
 
-		// always send the player himself
-		dist[i].first = 0;
+	int aNearestStamp[MAX_CLIENTS];
+	for (int j = 0; j < MAX_CLIENTS; j++)
+		aNearestStamp[j] = -1;
 
-		// compute reverse map
-		int rMap[MAX_CLIENTS];
-		for (int j = 0; j < MAX_CLIENTS; j++)
+	for (int i = 0; i < MAX_CLIENTS; i++)
+	{
+		if (!Server()->ClientIngame(i) || !GameServer()->m_apPlayers[i]) continue;
+		int* map = Server()->GetIdMap(i);
+		int* rMap = Server()->GetReverseIdMap(i);
+		vec2 ViewPos = GameServer()->m_apPlayers[i]->m_ViewPos;
+
+		// collect the nearest players
+		std::pair<float,int> aCandidates[MAX_CLIENTS];
+		int NumCandidates = 0;
+		if (NumShown <= NumNearest + 1)
+		{
+			for (int n = 0; n < NumShown; n++)
+			{
+				int j = aShownIDs[n];
+				if (j == i) continue;
+				aCandidates[NumCandidates].first = distance(ViewPos, aPos[j]);
+				aCandidates[NumCandidates].second = j;
+				NumCandidates++;
+			}
+		}
+		else
 		{
-			rMap[j] = -1;
+			// visit rings of cells around the client until nothing outside can be closer
+			int cx = clamp((int)((ViewPos.x - Min.x) / CellW), 0, GridSize - 1);
+			int cy = clamp((int)((ViewPos.y - Min.y) / CellH), 0, GridSize - 1);
+			for (int r = 0; r < GridSize; r++)
+			{
+				for (int y = max(cy - r, 0); y <= min(cy + r, GridSize - 1); y++)
+				{
+					for (int x = max(cx - r, 0); x <= min(cx + r, GridSize - 1); x++)
+					{
+						if (absolute(x - cx) != r && absolute(y - cy) != r)
+							continue;
+						int Cell = y * GridSize + x;
+						for (int c = aCellStart[Cell]; c < aCellStart[Cell + 1]; c++)
+						{
+							int j = aCellPlayers[c];
+							if (j == i) continue;
+							aCandidates[NumCandidates].first = distance(ViewPos, aPos[j]);
+							aCandidates[NumCandidates].second = j;
+							NumCandidates++;
+						}
+					}
+				}
+
+				if (NumCandidates >= NumNearest)
+				{
+					std::nth_element(&aCandidates[0], &aCandidates[NumNearest - 1], &aCandidates[NumCandidates], distCompare);
+					if (aCandidates[NumNearest - 1].first <= r * MinCell)
+						break;
+				}
+			}
 		}
-		for (int j = 0; j < VANILLA_MAX_CLIENTS; j++)
+		if (NumCandidates > NumNearest)
 		{
-			if (map[j] == -1) continue;
-			if (dist[map[j]].first > 1e9) map[j] = -1;
-			else rMap[map[j]] = j;
+			std::nth_element(&aCandidates[0], &aCandidates[NumNearest - 1], &aCandidates[NumCandidates], distCompare);
+			NumCandidates = NumNearest;
 		}
+		std::sort(&aCandidates[0], &aCandidates[NumCandidates], distCompare);
 
-		std::nth_element(&dist[0], &dist[VANILLA_MAX_CLIENTS - 1], &dist[MAX_CLIENTS], distCompare);
+		aNearestStamp[i] = i;
+		for (int n = 0; n < NumCandidates; n++)
+			aNearestStamp[aCandidates[n].second] = i;
 
+		// drop players that can't be shown anymore
+		for (int s = 0; s < VANILLA_MAX_CLIENTS; s++)
+		{
+			if (map[s] != -1 && map[s] != i && !aShown[map[s]])
+			{
+				rMap[map[s]] = -1;
+				map[s] = -1;
+			}
+		}
+
+		// give free slots to the nearest players, closest first
+		float aDemand[VANILLA_MAX_CLIENTS];
+		int NumDemand = 0;
 		int mapc = 0;
-		int demand = 0;
-		for (int j = 0; j < VANILLA_MAX_CLIENTS - 1; j++)
+		for (int n = 0; n < NumCandidates; n++)
 		{
-			int k = dist[j].second;
-			if (rMap[k] != -1 || dist[j].first > 1e9) continue;
+			int k = aCandidates[n].second;
+			if (rMap[k] != -1) continue;
 			while (mapc < VANILLA_MAX_CLIENTS && map[mapc] != -1) mapc++;
 			if (mapc < VANILLA_MAX_CLIENTS - 1)
 				map[mapc] = k;
 			else
-				if (dist[j].first < 1300) // dont bother freeing up space for players which are too far to be displayed anyway
-					demand++;
+				if (aCandidates[n].first < 1300) // dont bother freeing up space for players which are too far to be displayed anyway
+					aDemand[NumDemand++] = aCandidates[n].first;
 		}
-		for (int j = MAX_CLIENTS - 1; j > VANILLA_MAX_CLIENTS - 2; j--)
+
+		// free the slots of the farthest mapped players for the next update,
+		// with hysteresis only if they are clearly farther than who is waiting
+		// (without it, as many as there are players waiting)
+		if (NumDemand > 0)
 		{
-			int k = dist[j].second;
-			if (rMap[k] != -1 && demand-- > 0)
-				map[rMap[k]] = -1;
+			std::pair<float,int> aMapped[VANILLA_MAX_CLIENTS];
+			int NumMapped = 0;
+			for (int s = 0; s < VANILLA_MAX_CLIENTS; s++)
+			{
+				int k = map[s];
+				if (k == -1 || aNearestStamp[k] == i) continue;
+				aMapped[NumMapped].first = distance(ViewPos, aPos[k]);
+				aMapped[NumMapped].second = s;
+				NumMapped++;
+			}
+			std::sort(&aMapped[0], &aMapped[NumMapped], distCompare);
+			for (int n = 0; n < NumDemand && n < NumMapped; n++)
+			{
+				const std::pair<float,int> &Farthest = aMapped[NumMapped - 1 - n];
+				if (g_Config.m_SvMapUpdateHysteresis > 0 && Farthest.first <= aDemand[n] + g_Config.m_SvMapUpdateHysteresis)
+					break;
+				map[Farthest.second] = -1;
+			}
 		}
 		map[VANILLA_MAX_CLIENTS - 1] = -1; // player with empty name to say chat msgs
+
+		Server()->UpdateReverseIdMap(i);
 	}
 }
 
@@ -234,6 +720,7 @@ void CGameWorld::Tick()
 			{
 				m_pNextTraverseEntity = pEnt->m_pNextTypeEntity;
 				pEnt->Tick();
+				UpdateEntityCell(pEnt);
 				pEnt = m_pNextTraverseEntity;
 			}
 
@@ -242,6 +729,7 @@ void CGameWorld::Tick()
 			{
 				m_pNextTraverseEntity = pEnt->m_pNextTypeEntity;
 				pEnt->TickDefered();
+				UpdateEntityCell(pEnt);
 				pEnt = m_pNextTraverseEntity;
 			}
 	}
@@ -253,6 +741,7 @@ void CGameWorld::Tick()
 			{
 				m_pNextTraverseEntity = pEnt->m_pNextTypeEntity;
 				pEnt->TickPaused();
+				UpdateEntityCell(pEnt);
 				pEnt = m_pNextTraverseEntity;
 			}
 	}
@@ -269,26 +758,41 @@ CCharacter *CGameWorld::IntersectCharacter(vec2 Pos0, vec2 Pos1, float Radius, v
 	float ClosestLen = distance(Pos0, Pos1) * 100.0f;
 	CCharacter *pClosest = 0;
 
-	CCharacter *p = (CCharacter *)FindFirst(ENTTYPE_CHARACTER);
-	for(; p; p = (CCharacter *)p->TypeNext())
- 	{
-		if(p == pNotThis || !p->m_Core.m_Infected)
-			continue;
+	int64 StartTime = time_get();
+	CEntity *apCandidates[MAX_GRID_CANDIDATES];
+	float Reach = Radius + m_aMaxProximityRadius[ENTTYPE_CHARACTER];
+	vec2 Min = vec2(min(Pos0.x, Pos1.x) - Reach, min(Pos0.y, Pos1.y) - Reach);
+	vec2 Max = vec2(max(Pos0.x, Pos1.x) + Reach, max(Pos0.y, Pos1.y) + Reach);
+	int NumCandidates = CollectEntities(ENTTYPE_CHARACTER, Min, Max, apCandidates, MAX_GRID_CANDIDATES);
 
-		vec2 IntersectPos = closest_point_on_line(Pos0, Pos1, p->m_Pos);
-		float Len = distance(p->m_Pos, IntersectPos);
-		if(Len < p->m_ProximityRadius+Radius)
+	int NumVisited = 0;
+	CCharacter *p = (CCharacter *)(NumCandidates >= 0 ? (NumCandidates > 0 ? apCandidates[0] : 0) : FindFirst(ENTTYPE_CHARACTER));
+	while(p)
+ 	{
+		NumVisited++;
+		if(p != pNotThis && p->m_Core.m_Infected)
 		{
-			Len = distance(Pos0, IntersectPos);
-			if(Len < ClosestLen)
+			vec2 IntersectPos = closest_point_on_line(Pos0, Pos1, p->m_Pos);
+			float Len = distance(p->m_Pos, IntersectPos);
+			if(Len < p->m_ProximityRadius+Radius)
 			{
-				NewPos = IntersectPos;
-				ClosestLen = Len;
-				pClosest = p;
+				Len = distance(Pos0, IntersectPos);
+				if(Len < ClosestLen)
+				{
+					NewPos = IntersectPos;
+					ClosestLen = Len;
+					pClosest = p;
+				}
 			}
 		}
+
+		if(NumCandidates >= 0)
+			p = (CCharacter *)(NumVisited < NumCandidates ? apCandidates[NumVisited] : 0);
+		else
+			p = (CCharacter *)p->TypeNext();
 	}
 
+	RecordQuery(ENTTYPE_CHARACTER, NumCandidates >= 0, NumVisited, StartTime);
 	return pClosest;
 }
 
@@ -299,25 +803,35 @@ CCharacter *CGameWorld::ClosestCharacter(vec2 Pos, float Radius, CEntity *pNotTh
 	float ClosestRange = Radius*2;
 	CCharacter *pClosest = 0;
 
-	CCharacter *p = (CCharacter *)GameServer()->m_World.FindFirst(ENTTYPE_CHARACTER);
-	for(; p; p = (CCharacter *)p->TypeNext())
+	int64 StartTime = time_get();
+	CEntity *apCandidates[MAX_GRID_CANDIDATES];
+	float Reach = Radius + m_aMaxProximityRadius[ENTTYPE_CHARACTER];
+	int NumCandidates = CollectEntities(ENTTYPE_CHARACTER, Pos - vec2(Reach, Reach), Pos + vec2(Reach, Reach), apCandidates, MAX_GRID_CANDIDATES);
+
+	int NumVisited = 0;
+	CCharacter *p = (CCharacter *)(NumCandidates >= 0 ? (NumCandidates > 0 ? apCandidates[0] : 0) : FindFirst(ENTTYPE_CHARACTER));
+	while(p)
  	{
-		if(p == pNotThis)
-			continue;
-			
-		if(p->GetPlayer())
-			continue;
-			
-		float Len = distance(Pos, p->m_Pos);
-		if(Len < p->m_ProximityRadius+Radius)
+		NumVisited++;
+		if(p != pNotThis && !p->GetPlayer())
 		{
-			if(Len < ClosestRange)
+			float Len = distance(Pos, p->m_Pos);
+			if(Len < p->m_ProximityRadius+Radius)
 			{
-				ClosestRange = Len;
-				pClosest = p;
+				if(Len < ClosestRange)
+				{
+					ClosestRange = Len;
+					pClosest = p;
+				}
 			}
 		}
+
+		if(NumCandidates >= 0)
+			p = (CCharacter *)(NumVisited < NumCandidates ? apCandidates[NumVisited] : 0);
+		else
+			p = (CCharacter *)p->TypeNext();
 	}
 
+	RecordQuery(ENTTYPE_CHARACTER, NumCandidates >= 0, NumVisited, StartTime);
 	return pClosest;
 }
@@ -3,6 +3,7 @@
 #ifndef GAME_SERVER_GAMEWORLD_H
 #define GAME_SERVER_GAMEWORLD_H
 
+#include <engine/shared/snapshot.h>
 #include <game/gamecore.h>
 
 class CEntity;
@@ -55,6 +56,30 @@ public:
 		NUM_ENTTYPES
 	};
 
+	enum
+	{
+		GRID_CELL_SIZE = 32,
+		NUM_GRID_BUCKETS = 8192,
+		MAX_GRID_CANDIDATES = 512,
+	};
+
+	enum
+	{
+		SNAPVARIANT_NORMAL = 0,
+		SNAPVARIANT_ANTIPING,
+		NUM_SNAPVARIANTS,
+
+		MAX_SHARED_SNAP_ENTITIES = 1024,
+	};
+
+	struct CQueryStats
+	{
+		int64 m_NumQueries;
+		int64 m_NumGridQueries;
+		int64 m_NumVisited;
+		int64 m_Time;
+	};
+
 private:
 	void Reset();
 	void RemoveEntities();
@@ -62,6 +87,44 @@ private:
 	CEntity *m_pNextTraverseEntity;
 	CEntity *m_apFirstEntityTypes[NUM_ENTTYPES];
 
+	// spatial hash grid, keyed by (type, cell)
+	CEntity *m_apGridBuckets[NUM_GRID_BUCKETS];
+	int m_aNumEntities[NUM_ENTTYPES];
+	float m_aMaxProximityRadius[NUM_ENTTYPES];
+	int64 m_NextEntitySeq;
+	CQueryStats m_aQueryStats[NUM_ENTTYPES];
+
+	// entities of each type by the client that owns them
+	CEntity *m_aapFirstOwnedEntities[MAX_CLIENTS][NUM_ENTTYPES];
+	int m_aaNumOwnedEntities[MAX_CLIENTS][NUM_ENTTYPES];
+
+	static bool CompareWorldOrder(const CEntity *pA, const CEntity *pB);
+	static int GridCoord(float Value);
+	static int GridBucket(int Type, int CellX, int CellY);
+	void GridLink(CEntity *pEnt);
+	void GridUnlink(CEntity *pEnt);
+	void OwnerLink(CEntity *pEnt);
+	void OwnerUnlink(CEntity *pEnt);
+	int CollectEntities(int Type, vec2 Min, vec2 Max, CEntity **ppEnts, int MaxEnts);
+	void RecordQuery(int Type, bool UsedGrid, int NumVisited, int64 StartTime);
+
+	// items of entities that look the same for every client, snapped once per snapshot
+	struct CSharedSnapEntity
+	{
+		int m_FirstItem;
+		int m_NumItems;
+		bool m_Clipped;
+		vec2 m_ClipPos;
+	};
+	CSnapshotBuilder m_aSharedSnapBuilders[NUM_SNAPVARIANTS];
+	CSharedSnapEntity m_aaSharedSnapEntities[NUM_SNAPVARIANTS][MAX_SHARED_SNAP_ENTITIES];
+	int m_aNumSharedSnapEntities[NUM_SNAPVARIANTS];
+	bool m_aSharedSnapValid[NUM_SNAPVARIANTS];
+	int m_SharedSnapVariant;
+
+	bool BuildSharedSnap(int Variant);
+	void SnapShared(int SnappingClient, int Variant);
+
 	class CGameContext *m_pGameServer;
 	class IServer *m_pServer;
 
@@ -82,6 +145,21 @@ public:
 
 	CEntity *FindFirst(int Type);
 
+	/*
+		Function: find_first_owned
+			Returns the first entity of a type that is owned by a
+			client. Use OwnerNext() on the entity to get the next one.
+
+		Arguments:
+			owner - Client ID of the owner.
+			type - Type of the entities to find.
+
+		Returns:
+			The first owned entity or NULL if the client owns none.
+	*/
+	CEntity *FindFirstOwned(int Owner, int Type);
+	int NumOwnedEntities(int Owner, int Type) const;
+
 	/*
 		Function: find_entities
 			Finds entities close to a position and returns them in a list.
@@ -156,6 +234,49 @@ public:
 	*/
 	void DestroyEntity(CEntity *pEntity);
 
+	/*
+		Function: update_entity_cell
+			Moves an entity to the grid cell of its current position.
+			Called automatically after each tick and by
+			CEntity::SetPosition().
+
+		Arguments:
+			entity - Entity that moved
+	*/
+	void UpdateEntityCell(CEntity *pEntity);
+
+	/*
+		Function: set_entity_owner
+			Sets the client that owns an entity, for FindFirstOwned().
+			Entities with an owner have to call this when they get one
+			and whenever it changes.
+
+		Arguments:
+			entity - Entity
+			owner - Client ID of the owner, -1 for none
+	*/
+	void SetEntityOwner(CEntity *pEntity, int Owner);
+
+	const CQueryStats *GetQueryStats(int Type) const { return &m_aQueryStats[Type]; }
+	void ResetQueryStats();
+	int NumEntities(int Type) const { return m_aNumEntities[Type]; }
+
+	/*
+		Function: pre_snap
+			Snaps all entities with shared snap items once, before
+			the snapshots of the clients are created.
+	*/
+	void PreSnap();
+
+	/*
+		Function: post_snap
+			Invalidates the shared snap items.
+	*/
+	void PostSnap();
+
+	void OnSharedSnapClip(vec2 CheckPos);
+	bool SharedSnapAntiPing() const { return m_SharedSnapVariant == SNAPVARIANT_ANTIPING; }
+
 	/*
 		Function: snap
 			Calls snap on all the entities in the world to create
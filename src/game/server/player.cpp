@@ -21,6 +21,7 @@ CPlayer::CPlayer(CGameContext *pGameServer, int ClientID, int Team)
 	m_pCharacter = 0;
 	m_ClientID = ClientID;
 	m_Team = GameServer()->m_pController->ClampTeam(Team);
+	Server()->ExpireServerInfo();
 	m_SpectatorID = SPEC_FREEVIEW;
 	m_LastActionTick = Server()->Tick();
 	m_LastActionMoveTick = Server()->Tick();
@@ -32,6 +33,7 @@ CPlayer::CPlayer(CGameContext *pGameServer, int ClientID, int Team)
 	m_ScoreMode = PLAYERSCOREMODE_SCORE;
 	m_WinAsHuman = 0;
 	m_class = PLAYERCLASS_NONE;
+	InvalidateSnapInfo();
 	m_InfectionTick = -1;
 	m_NumberKills = 0;
 	SetLanguage(Server()->GetClientLanguage(ClientID));
@@ -47,6 +49,7 @@ CPlayer::CPlayer(CGameContext *pGameServer, int ClientID, int Team)
 	idMap[0] = ClientID;
 
 	}
+	Server()->UpdateReverseIdMap(ClientID);
 	m_WasHumanThisRound = false;
 	
 	m_MapMenu = 0;
@@ -54,8 +57,8 @@ CPlayer::CPlayer(CGameContext *pGameServer, int ClientID, int Team)
 	m_MapMenuTick = -1;
 	m_HookProtectionAutomatic = true;
 	
-	m_PrevTuningParams = *pGameServer->Tuning();
-	m_NextTuningParams = m_PrevTuningParams;
+	m_SentTuningID = 0;
+	m_NextTuningParams = *pGameServer->Tuning();
 	m_IsInGame = false;
 	
 	for(unsigned int i=0; i<sizeof(m_LastHumanClasses)/sizeof(int); i++)
@@ -190,18 +193,13 @@ void CPlayer::PostTick()
 
 void CPlayer::HandleTuningParams()
 {
-	if(!(m_PrevTuningParams == m_NextTuningParams))
+	const CTuningCache::CEntry *pEntry = GameServer()->m_TuningCache.Intern(&m_NextTuningParams);
+	if(pEntry->m_ID != m_SentTuningID)
 	{
 		if(m_IsReady)
-		{
-			CMsgPacker Msg(NETMSGTYPE_SV_TUNEPARAMS);
-			int *pParams = (int *)&m_NextTuningParams;
-			for(unsigned i = 0; i < sizeof(m_NextTuningParams)/sizeof(int); i++)
-				Msg.AddInt(pParams[i]);
-			Server()->SendMsg(&Msg, MSGFLAG_VITAL, GetCID());
-		}
+			GameServer()->m_TuningCache.Send(pEntry, GetCID());
 		
-		m_PrevTuningParams = m_NextTuningParams;
+		m_SentTuningID = pEntry->m_ID;
 	}
 	
 	m_NextTuningParams = *GameServer()->Tuning();
@@ -242,8 +240,6 @@ void CPlayer::Snap(int SnappingClient)
 	if(!pClientInfo)
 		return;
 
-	StrToInts(&pClientInfo->m_Name0, 4, Server()->ClientName(m_ClientID));
-	
 	int SnapScoreMode = PLAYERSCOREMODE_SCORE;
 	if(SnappingClient != -1)
 		if(GameServer()->m_apPlayers[SnappingClient])
@@ -252,136 +248,25 @@ void CPlayer::Snap(int SnappingClient)
 		}
 	
 /* INFECTION MODIFICATION STRAT ***************************************/
-	int PlayerInfoScore = 0;
-	
-	if(GetTeam() == TEAM_SPECTATORS)
-	{
-		StrToInts(&pClientInfo->m_Clan0, 3, Server()->ClientClan(m_ClientID));
-	}
-	else
-	{
-		if(SnapScoreMode == PLAYERSCOREMODE_TIME)
-		{
-			float RoundDuration = static_cast<float>(m_HumanTime/((float)Server()->TickSpeed()))/60.0f;
-			int Minutes = static_cast<int>(RoundDuration);
-			int Seconds = static_cast<int>((RoundDuration - Minutes)*60.0f);
-			
-			char aBuf[512];
-			str_format(aBuf, sizeof(aBuf), "%i:%s%i min", Minutes,((Seconds < 10) ? "0" : ""), Seconds);
-			StrToInts(&pClientInfo->m_Clan0, 3, aBuf);
-			
-			PlayerInfoScore = m_HumanTime/Server()->TickSpeed();
-		}
-		else
-		{
-			char aClanName[12];
-			switch(GetClass())
-			{
-				case PLAYERCLASS_ENGINEER:
-					str_format(aClanName, sizeof(aClanName), "%sEngineer", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_SOLDIER:
-					str_format(aClanName, sizeof(aClanName), "%sSoldier", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_MERCENARY:
-					str_format(aClanName, sizeof(aClanName), "%sMercenary", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_SNIPER:
-					str_format(aClanName, sizeof(aClanName), "%sSniper", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_SCIENTIST:
-					str_format(aClanName, sizeof(aClanName), "%sScientist", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_CATAPULT:
-					str_format(aClanName, sizeof(aClanName), "%sCatapult", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_BIOLOGIST:
-					str_format(aClanName, sizeof(aClanName), "%sBiologist", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_SCIOGIST:
-					str_format(aClanName, sizeof(aClanName), "%sSciogist", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_POLICE:
-					str_format(aClanName, sizeof(aClanName), "%sPolice", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_LOOPER:
-					str_format(aClanName, sizeof(aClanName), "%sLooper", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_REVIVER:
-					str_format(aClanName, sizeof(aClanName), "%sReviver", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_MEDIC:
-					str_format(aClanName, sizeof(aClanName), "%sMedic", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_HERO:
-					str_format(aClanName, sizeof(aClanName), "%sHero", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_NINJA:
-					str_format(aClanName, sizeof(aClanName), "%sNinja", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_SMOKER:
-					str_format(aClanName, sizeof(aClanName), "%sSmoker", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_BOOMER:
-					str_format(aClanName, sizeof(aClanName), "%sBoomer", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_HUNTER:
-					str_format(aClanName, sizeof(aClanName), "%sHunter", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_BAT:
-					str_format(aClanName, sizeof(aClanName), "%sBat", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_GHOST:
-					str_format(aClanName, sizeof(aClanName), "%sGhost", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_SPIDER:
-					str_format(aClanName, sizeof(aClanName), "%sSpider", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_GHOUL:
-					str_format(aClanName, sizeof(aClanName), "%sGhoul", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_SLUG:
-					str_format(aClanName, sizeof(aClanName), "%sSlug", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_SLIME:
-					str_format(aClanName, sizeof(aClanName), "%sSlime", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_VOODOO:
-					str_format(aClanName, sizeof(aClanName), "%sVoodoo", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_UNDEAD:
-					str_format(aClanName, sizeof(aClanName), "%sUndead", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				case PLAYERCLASS_WITCH:
-					str_format(aClanName, sizeof(aClanName), "%sWitch", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-					break;
-				default:
-					str_format(aClanName, sizeof(aClanName), "%s?????", Server()->IsClientLogged(GetCID()) ? "@" : " ");
-			}
-			
-			StrToInts(&pClientInfo->m_Clan0, 3, aClanName);
-			
-			PlayerInfoScore = Server()->RoundStatistics()->PlayerScore(m_ClientID);
-		}
-	}
+	int Type = SnapScoreMode == PLAYERSCOREMODE_TIME ? SNAPINFO_TIME : SNAPINFO_CLASS;
+	if(m_aSnapInfo[Type].m_Tick != Server()->Tick())
+		UpdateSnapInfo(Type);
+	const CSnapInfo *pSnapInfo = &m_aSnapInfo[Type];
 	
-	pClientInfo->m_Country = Server()->ClientCountry(m_ClientID);
+	mem_copy(pClientInfo, &pSnapInfo->m_ClientInfo, sizeof(CNetObj_ClientInfo));
 
 	if(
-		GameServer()->m_apPlayers[SnappingClient] && IsHuman() &&
+		SnappingClient != -1 && GameServer()->m_apPlayers[SnappingClient] && IsHuman() &&
 		(
 			(Server()->GetClientCustomSkin(SnappingClient) == 1 && SnappingClient == GetCID()) ||
 			(Server()->GetClientCustomSkin(SnappingClient) == 2)
 		)
 	)
 	{
-		StrToInts(&pClientInfo->m_Skin0, 6, m_TeeInfos.m_CustomSkinName);
+		mem_copy(&pClientInfo->m_Skin0, pSnapInfo->m_aCustomSkin, sizeof(pSnapInfo->m_aCustomSkin));
 	}
-	else StrToInts(&pClientInfo->m_Skin0, 6, m_TeeInfos.m_SkinName);
 	
-	pClientInfo->m_UseCustomColor = m_TeeInfos.m_UseCustomColor;
-	pClientInfo->m_ColorBody = m_TeeInfos.m_ColorBody;
-	pClientInfo->m_ColorFeet = m_TeeInfos.m_ColorFeet;
+	int PlayerInfoScore = pSnapInfo->m_Score;
 /* INFECTION MODIFICATION END *****************************************/
 
 	CNetObj_PlayerInfo *pPlayerInfo = static_cast<CNetObj_PlayerInfo *>(Server()->SnapNewItem(NETOBJTYPE_PLAYERINFO, id, sizeof(CNetObj_PlayerInfo)));
@@ -411,11 +296,143 @@ void CPlayer::Snap(int SnappingClient)
 	}
 }
 
+void CPlayer::InvalidateSnapInfo()
+{
+	for(int i = 0; i < NUM_SNAPINFOS; i++)
+		m_aSnapInfo[i].m_Tick = -1;
+}
+
+void CPlayer::UpdateSnapInfo(int Type)
+{
+	CSnapInfo *pSnapInfo = &m_aSnapInfo[Type];
+	CNetObj_ClientInfo *pClientInfo = &pSnapInfo->m_ClientInfo;
+	pSnapInfo->m_Tick = Server()->Tick();
+
+	StrToInts(&pClientInfo->m_Name0, 4, Server()->ClientName(m_ClientID));
+	
+	pSnapInfo->m_Score = 0;
+	
+	if(GetTeam() == TEAM_SPECTATORS)
+	{
+		StrToInts(&pClientInfo->m_Clan0, 3, Server()->ClientClan(m_ClientID));
+	}
+	else if(Type == SNAPINFO_TIME)
+	{
+		float RoundDuration = static_cast<float>(m_HumanTime/((float)Server()->TickSpeed()))/60.0f;
+		int Minutes = static_cast<int>(RoundDuration);
+		int Seconds = static_cast<int>((RoundDuration - Minutes)*60.0f);
+		
+		char aBuf[512];
+		str_format(aBuf, sizeof(aBuf), "%i:%s%i min", Minutes,((Seconds < 10) ? "0" : ""), Seconds);
+		StrToInts(&pClientInfo->m_Clan0, 3, aBuf);
+		
+		pSnapInfo->m_Score = m_HumanTime/Server()->TickSpeed();
+	}
+	else
+	{
+		char aClanName[12];
+		switch(GetClass())
+		{
+			case PLAYERCLASS_ENGINEER:
+				str_format(aClanName, sizeof(aClanName), "%sEngineer", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_SOLDIER:
+				str_format(aClanName, sizeof(aClanName), "%sSoldier", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_MERCENARY:
+				str_format(aClanName, sizeof(aClanName), "%sMercenary", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_SNIPER:
+				str_format(aClanName, sizeof(aClanName), "%sSniper", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_SCIENTIST:
+				str_format(aClanName, sizeof(aClanName), "%sScientist", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_CATAPULT:
+				str_format(aClanName, sizeof(aClanName), "%sCatapult", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_BIOLOGIST:
+				str_format(aClanName, sizeof(aClanName), "%sBiologist", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_SCIOGIST:
+				str_format(aClanName, sizeof(aClanName), "%sSciogist", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_POLICE:
+				str_format(aClanName, sizeof(aClanName), "%sPolice", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_LOOPER:
+				str_format(aClanName, sizeof(aClanName), "%sLooper", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_REVIVER:
+				str_format(aClanName, sizeof(aClanName), "%sReviver", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_MEDIC:
+				str_format(aClanName, sizeof(aClanName), "%sMedic", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_HERO:
+				str_format(aClanName, sizeof(aClanName), "%sHero", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_NINJA:
+				str_format(aClanName, sizeof(aClanName), "%sNinja", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_SMOKER:
+				str_format(aClanName, sizeof(aClanName), "%sSmoker", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_BOOMER:
+				str_format(aClanName, sizeof(aClanName), "%sBoomer", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_HUNTER:
+				str_format(aClanName, sizeof(aClanName), "%sHunter", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_BAT:
+				str_format(aClanName, sizeof(aClanName), "%sBat", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_GHOST:
+				str_format(aClanName, sizeof(aClanName), "%sGhost", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_SPIDER:
+				str_format(aClanName, sizeof(aClanName), "%sSpider", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_GHOUL:
+				str_format(aClanName, sizeof(aClanName), "%sGhoul", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_SLUG:
+				str_format(aClanName, sizeof(aClanName), "%sSlug", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_SLIME:
+				str_format(aClanName, sizeof(aClanName), "%sSlime", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_VOODOO:
+				str_format(aClanName, sizeof(aClanName), "%sVoodoo", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_UNDEAD:
+				str_format(aClanName, sizeof(aClanName), "%sUndead", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			case PLAYERCLASS_WITCH:
+				str_format(aClanName, sizeof(aClanName), "%sWitch", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+				break;
+			default:
+				str_format(aClanName, sizeof(aClanName), "%s?????", Server()->IsClientLogged(GetCID()) ? "@" : " ");
+		}
+		
+		StrToInts(&pClientInfo->m_Clan0, 3, aClanName);
+		
+		pSnapInfo->m_Score = Server()->RoundStatistics()->PlayerScore(m_ClientID);
+	}
+	
+	pClientInfo->m_Country = Server()->ClientCountry(m_ClientID);
+
+	StrToInts(&pClientInfo->m_Skin0, 6, m_TeeInfos.m_SkinName);
+	StrToInts(pSnapInfo->m_aCustomSkin, 6, m_TeeInfos.m_CustomSkinName);
+	
+	pClientInfo->m_UseCustomColor = m_TeeInfos.m_UseCustomColor;
+	pClientInfo->m_ColorBody = m_TeeInfos.m_ColorBody;
+	pClientInfo->m_ColorFeet = m_TeeInfos.m_ColorFeet;
+}
+
 void CPlayer::FakeSnap(int SnappingClient)
 {
-	IServer::CClientInfo info;
-	Server()->GetClientInfo(SnappingClient, &info);
-	if (info.m_CustClt)
+	if (Server()->IsCustClt(SnappingClient))
 		return;
 
 	int id = VANILLA_MAX_CLIENTS - 1;
@@ -539,6 +556,8 @@ void CPlayer::Respawn()
 
 void CPlayer::SetTeam(int Team, bool DoChatMsg)
 {
+	InvalidateSnapInfo();
+
 	// clamp the team
 	Team = GameServer()->m_pController->ClampTeam(Team);
 	if(m_Team == Team)
@@ -561,6 +580,7 @@ void CPlayer::SetTeam(int Team, bool DoChatMsg)
 	KillCharacter();
 
 	m_Team = Team;
+	Server()->ExpireServerInfo();
 	m_LastActionTick = Server()->Tick();
 	m_LastActionMoveTick = Server()->Tick();
 	m_SpectatorID = SPEC_FREEVIEW;
@@ -621,6 +641,8 @@ int CPlayer::GetClass()
 
 void CPlayer::SetClassSkin(int newClass, int State)
 {
+	InvalidateSnapInfo();
+
 	switch(newClass)
 	{
 		case PLAYERCLASS_ENGINEER:
@@ -777,6 +799,8 @@ void CPlayer::SetClass(int newClass)
 	if(m_class == newClass)
 		return;
 	
+	InvalidateSnapInfo();
+	
 	if(newClass > START_HUMANCLASS && newClass < END_HUMANCLASS)
 	{
 		bool ClassFound = false;
@@ -912,6 +936,7 @@ const char* CPlayer::GetLanguage()
 void CPlayer::SetLanguage(const char* pLanguage)
 {
 	str_copy(m_aLanguage, pLanguage, sizeof(m_aLanguage));
+	m_LanguageID = Server()->Localization()->GetLanguageID(m_aLanguage);
 }
 void CPlayer::OpenMapMenu(int Menu)
 {
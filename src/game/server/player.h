@@ -29,6 +29,7 @@ public:
 	void PostTick();
 	void Snap(int SnappingClient);
 	void FakeSnap(int SnappingClient);
+	void InvalidateSnapInfo();
 
 	void OnDirectInput(CNetObj_PlayerInput *NewInput);
 	void OnPredictedInput(CNetObj_PlayerInput *NewInput);
@@ -120,6 +121,25 @@ private:
 	int m_ClientID;
 	int m_Team;
 
+	// the client info of this player is the same for every snapping client
+	// sharing a score mode, so it is only encoded once per tick and mode
+	enum
+	{
+		SNAPINFO_CLASS=0,
+		SNAPINFO_TIME,
+		NUM_SNAPINFOS,
+	};
+	struct CSnapInfo
+	{
+		int m_Tick;
+		int m_Score;
+		CNetObj_ClientInfo m_ClientInfo;
+		int m_aCustomSkin[6];
+	};
+	CSnapInfo m_aSnapInfo[NUM_SNAPINFOS];
+
+	void UpdateSnapInfo(int Type);
+
 /* INFECTION MODIFICATION START ***************************************/
 private:
 	int m_class;
@@ -127,6 +147,7 @@ private:
 	int m_ScoreMode;
 	int m_DefaultScoreMode;
 	char m_aLanguage[16];
+	int m_LanguageID;
 	
 	int m_MapMenu;
 	int m_MapMenuTick;
@@ -165,6 +186,7 @@ public:
 	bool IsKnownClass(int c);
 	
 	const char* GetLanguage();
+	int GetLanguageID() const { return m_LanguageID; }
 	void SetLanguage(const char* pLanguage);
 	
 	bool m_WasHumanThisRound;
@@ -174,7 +196,7 @@ public:
 	
 	int m_MapMenuItem;
 	
-	CTuningParams m_PrevTuningParams;
+	int m_SentTuningID; // tuning cache entry that was sent last, 0 for none
 	CTuningParams m_NextTuningParams;
 	
 	void HandleTuningParams();
@@ -0,0 +1,126 @@
+#include <engine/message.h>
+#include <game/generated/protocol.h>
+
+#include "tuningcache.h"
+#include "gamecontext.h"
+
+CTuningCache::CTuningCache()
+{
+	m_pGameServer = 0;
+	Clear();
+	ResetStats();
+}
+
+void CTuningCache::SetGameServer(CGameContext *pGameServer)
+{
+	m_pGameServer = pGameServer;
+}
+
+void CTuningCache::Clear()
+{
+	for(int i = 0; i < MAX_ENTRIES; i++)
+		m_aEntries[i].m_ID = 0;
+	m_NumEntries = 0;
+	m_NextID = 1;
+}
+
+void CTuningCache::ResetStats()
+{
+	mem_zero(&m_Stats, sizeof(m_Stats));
+	m_SecondStartTick = 0;
+	m_NumSentThisSecond = 0;
+	m_NumSentLastSecond = 0;
+}
+
+unsigned CTuningCache::HashParams(const CTuningParams *pParams)
+{
+	const int *pData = (const int *)pParams;
+	unsigned Hash = 2166136261u;
+	for(int i = 0; i < CTuningParams::Num(); i++)
+		Hash = (Hash ^ (unsigned)pData[i]) * 16777619u;
+	return Hash;
+}
+
+void CTuningCache::Pack(CEntry *pEntry)
+{
+	CPacker Packer;
+	Packer.Reset();
+	const int *pParams = (const int *)&pEntry->m_Params;
+	for(int i = 0; i < CTuningParams::Num(); i++)
+		Packer.AddInt(pParams[i]);
+
+	dbg_assert(!Packer.Error() && Packer.Size() <= (int)sizeof(pEntry->m_aMsgData), "tuning message too large");
+	mem_copy(pEntry->m_aMsgData, Packer.Data(), Packer.Size());
+	pEntry->m_MsgSize = Packer.Size();
+	m_Stats.m_NumPacked++;
+}
+
+const CTuningCache::CEntry *CTuningCache::Intern(const CTuningParams *pParams)
+{
+	int Tick = GameServer()->Server()->Tick();
+	unsigned Hash = HashParams(pParams);
+
+	for(int i = 0; i < m_NumEntries; i++)
+	{
+		if(m_aHashes[i] == Hash && mem_comp(&m_aEntries[i].m_Params, pParams, sizeof(CTuningParams)) == 0)
+		{
+			m_aEntries[i].m_LastUsedTick = Tick;
+			return &m_aEntries[i];
+		}
+	}
+
+	// a new set, take a free entry or the one that was unused for the longest time
+	int Index = m_NumEntries;
+	if(m_NumEntries < MAX_ENTRIES)
+		m_NumEntries++;
+	else
+	{
+		Index = 0;
+		for(int i = 1; i < MAX_ENTRIES; i++)
+		{
+			if(m_aEntries[i].m_LastUsedTick < m_aEntries[Index].m_LastUsedTick)
+				Index = i;
+		}
+		m_Stats.m_NumEvicted++;
+	}
+
+	// a new id, players that were sent the evicted set must not take it for this one
+	CEntry *pEntry = &m_aEntries[Index];
+	pEntry->m_ID = m_NextID++;
+	pEntry->m_LastUsedTick = Tick;
+	mem_copy(&pEntry->m_Params, pParams, sizeof(CTuningParams));
+	m_aHashes[Index] = Hash;
+	Pack(pEntry);
+
+	return pEntry;
+}
+
+void CTuningCache::Send(const CEntry *pEntry, int ClientID)
+{
+	CMsgPacker Msg(NETMSGTYPE_SV_TUNEPARAMS);
+	Msg.AddRaw(pEntry->m_aMsgData, pEntry->m_MsgSize);
+	GameServer()->Server()->SendMsg(&Msg, MSGFLAG_VITAL, ClientID);
+
+	UpdateSecond();
+	m_NumSentThisSecond++;
+	m_Stats.m_NumSent++;
+}
+
+void CTuningCache::UpdateSecond()
+{
+	int Tick = GameServer()->Server()->Tick();
+	int TickSpeed = GameServer()->Server()->TickSpeed();
+	if(Tick - m_SecondStartTick < TickSpeed)
+		return;
+
+	// nothing was sent in the last second if the previous one is long gone
+	m_NumSentLastSecond = Tick - m_SecondStartTick < 2*TickSpeed ? m_NumSentThisSecond : 0;
+	m_NumSentThisSecond = 0;
+	m_SecondStartTick = Tick - (Tick - m_SecondStartTick) % TickSpeed;
+}
+
+int CTuningCache::NumSentLastSecond()
+{
+	UpdateSecond();
+	return m_NumSentLastSecond;
+}
@@ -0,0 +1,77 @@
+#ifndef GAME_SERVER_TUNINGCACHE_H
+#define GAME_SERVER_TUNINGCACHE_H
+
+#include <base/system.h>
+#include <game/gamecore.h>
+
+/*
+	Class: Tuning Cache
+		Interns the distinct tuning parameter sets of the players
+		(class, frozen, slow motion, water...) together with their
+		packed NETMSGTYPE_SV_TUNEPARAMS message. A set keeps its ID
+		for as long as it stays in the cache, so players only have
+		to compare IDs to know if their tuning changed.
+*/
+class CTuningCache
+{
+public:
+	struct CEntry
+	{
+		int m_ID; // 0 for an unused entry
+		int m_LastUsedTick;
+		CTuningParams m_Params;
+		int m_MsgSize;
+		unsigned char m_aMsgData[256]; // packed parameters, without the message type
+	};
+
+	struct CStats
+	{
+		int64 m_NumSent;
+		int64 m_NumPacked;
+		int64 m_NumEvicted;
+	};
+
+private:
+	enum
+	{
+		MAX_ENTRIES = 64,
+	};
+
+	class CGameContext *m_pGameServer;
+
+	CEntry m_aEntries[MAX_ENTRIES];
+	unsigned m_aHashes[MAX_ENTRIES]; // kept apart from the entries for the lookup scan
+	int m_NumEntries;
+	int m_NextID;
+
+	int m_SecondStartTick;
+	int m_NumSentThisSecond;
+	int m_NumSentLastSecond;
+	CStats m_Stats;
+
+	static unsigned HashParams(const CTuningParams *pParams);
+	void Pack(CEntry *pEntry);
+	void UpdateSecond();
+
+public:
+	CGameContext *GameServer() const { return m_pGameServer; }
+	void SetGameServer(CGameContext *pGameServer);
+
+	CTuningCache();
+	void Clear();
+
+	/*
+		Function: intern
+			Returns the cache entry for a tuning parameter set,
+			packing its message if the set is not cached yet.
+	*/
+	const CEntry *Intern(const CTuningParams *pParams);
+	void Send(const CEntry *pEntry, int ClientID);
+
+	int NumEntries() const { return m_NumEntries; }
+	int NumSentLastSecond();
+	const CStats *GetStats() const { return &m_Stats; }
+	void ResetStats();
+};
+
+#endif
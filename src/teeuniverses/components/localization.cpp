@@ -17,6 +17,8 @@ CLocalization::CLanguage::CLanguage() :
 	m_pPercentFormater(NULL),
 	m_pTimeUnitFormater(NULL)
 {
+	m_pResolved = NULL;
+	m_NumResolved = 0;
 	m_aName[0] = 0;
 	m_aFilename[0] = 0;
 	m_aParentFilename[0] = 0;
@@ -29,6 +31,8 @@ CLocalization::CLanguage::CLanguage(const char* pName, const char* pFilename, co
 	m_pNumberFormater(NULL),
 	m_pPercentFormater(NULL)
 {
+	m_pResolved = NULL;
+	m_NumResolved = 0;
 	str_copy(m_aName, pName, sizeof(m_aName));
 	str_copy(m_aFilename, pFilename, sizeof(m_aFilename));
 	str_copy(m_aParentFilename, pParentFilename, sizeof(m_aParentFilename));
@@ -104,6 +108,14 @@ CLocalization::CLanguage::~CLanguage()
 		
 	if(m_pTimeUnitFormater)
 		delete m_pTimeUnitFormater;
+	
+	if(m_pResolved)
+	{
+		for(int i=0; i<RESOLVED_CACHE_SIZE; i++)
+			if(m_pResolved[i].m_pTextCopy)
+				delete[] m_pResolved[i].m_pTextCopy;
+		delete[] m_pResolved;
+	}
 }
 
 /* BEGIN EDIT *********************************************************/
@@ -267,6 +279,60 @@ const char* CLocalization::CLanguage::Localize_P(int Number, const char* pText)
 	return pEntry->m_apVersions[PluralCode];
 }
 
+unsigned CLocalization::CLanguage::ResolvedSlot(const char* pText)
+{
+	// keys are almost always string literals, their address is a good hash
+	uintptr_t Address = (uintptr_t)pText;
+	return (unsigned)((Address >> 3) * 2654435761u) & (RESOLVED_CACHE_SIZE-1);
+}
+
+bool CLocalization::CLanguage::FindResolved(const char* pText, const char** ppResult) const
+{
+	if(!m_pResolved)
+		return false;
+	
+	for(unsigned Slot = ResolvedSlot(pText); m_pResolved[Slot].m_pText; Slot = (Slot+1) & (RESOLVED_CACHE_SIZE-1))
+	{
+		// the address can be reused by a buffer with a different text
+		if(m_pResolved[Slot].m_pText == pText && str_comp(m_pResolved[Slot].m_pTextCopy, pText) == 0)
+		{
+			*ppResult = m_pResolved[Slot].m_pResult;
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+void CLocalization::CLanguage::AddResolved(const char* pText, const char* pResult)
+{
+	// keep the table at most half full, further lookups just stay uncached
+	if(m_NumResolved >= RESOLVED_CACHE_SIZE/2)
+		return;
+	
+	if(!m_pResolved)
+	{
+		m_pResolved = new CResolved[RESOLVED_CACHE_SIZE];
+		mem_zero(m_pResolved, sizeof(CResolved)*RESOLVED_CACHE_SIZE);
+	}
+	
+	unsigned Slot = ResolvedSlot(pText);
+	while(m_pResolved[Slot].m_pText && m_pResolved[Slot].m_pText != pText)
+		Slot = (Slot+1) & (RESOLVED_CACHE_SIZE-1);
+	
+	CResolved* pResolved = &m_pResolved[Slot];
+	if(pResolved->m_pTextCopy)
+		delete[] pResolved->m_pTextCopy;
+	else
+		m_NumResolved++;
+	
+	int Length = str_length(pText)+1;
+	pResolved->m_pText = pText;
+	pResolved->m_pTextCopy = new char[Length];
+	str_copy(pResolved->m_pTextCopy, pText, Length);
+	pResolved->m_pResult = pResult;
+}
+
 /* LOCALIZATION *******************************************************/
 
 /* BEGIN EDIT *********************************************************/
@@ -343,6 +409,8 @@ bool CLocalization::Init()
 		{
 			CLanguage*& pLanguage = m_pLanguages.increment();
 			pLanguage = new CLanguage((const char *)rStart[i]["name"], (const char *)rStart[i]["file"], (const char *)rStart[i]["parent"]);
+			if(!m_LanguageIDs.get(pLanguage->GetFilename()))
+				m_LanguageIDs.set(pLanguage->GetFilename(), m_pLanguages.size()-1);
 				
 			if((const char *)rStart[i]["direction"] && str_comp((const char *)rStart[i]["direction"], "rtl") == 0)
 				pLanguage->SetWritingDirection(DIRECTION_RTL);
@@ -404,21 +472,24 @@ bool CLocalization::PreUpdate()
 	return true;
 }
 
-const char* CLocalization::LocalizeWithDepth(const char* pLanguageCode, const char* pText, int Depth)
+int CLocalization::GetLanguageID(const char* pLanguageCode) const
 {
-	CLanguage* pLanguage = m_pMainLanguage;
-	if(pLanguageCode)
-	{
-		for(int i=0; i<m_pLanguages.size(); i++)
-		{
-			if(str_comp(m_pLanguages[i]->GetFilename(), pLanguageCode) == 0)
-			{
-				pLanguage = m_pLanguages[i];
-				break;
-			}
-		}
-	}
+	if(!pLanguageCode)
+		return -1;
 	
+	const int* pID = m_LanguageIDs.get(pLanguageCode);
+	return pID ? *pID : -1;
+}
+
+CLocalization::CLanguage* CLocalization::GetLanguage(int LanguageID)
+{
+	if(LanguageID >= 0 && LanguageID < m_pLanguages.size())
+		return m_pLanguages[LanguageID];
+	return m_pMainLanguage;
+}
+
+const char* CLocalization::LocalizeWithDepth(CLanguage* pLanguage, const char* pText, int Depth)
+{
 	if(!pLanguage)
 		return pText;
 	
@@ -429,31 +500,33 @@ const char* CLocalization::LocalizeWithDepth(const char* pLanguageCode, const ch
 	if(pResult)
 		return pResult;
 	else if(pLanguage->GetParentFilename()[0] && Depth < 4)
-		return LocalizeWithDepth(pLanguage->GetParentFilename(), pText, Depth+1);
+		return LocalizeWithDepth(GetLanguage(GetLanguageID(pLanguage->GetParentFilename())), pText, Depth+1);
 	else
 		return pText;
 }
 
 const char* CLocalization::Localize(const char* pLanguageCode, const char* pText)
 {
-	return LocalizeWithDepth(pLanguageCode, pText, 0);
+	return Localize(GetLanguageID(pLanguageCode), pText);
 }
 
-const char* CLocalization::LocalizeWithDepth_P(const char* pLanguageCode, int Number, const char* pText, int Depth)
+const char* CLocalization::Localize(int LanguageID, const char* pText)
 {
-	CLanguage* pLanguage = m_pMainLanguage;
-	if(pLanguageCode)
-	{
-		for(int i=0; i<m_pLanguages.size(); i++)
-		{
-			if(str_comp(m_pLanguages[i]->GetFilename(), pLanguageCode) == 0)
-			{
-				pLanguage = m_pLanguages[i];
-				break;
-			}
-		}
-	}
+	CLanguage* pLanguage = GetLanguage(LanguageID);
+	if(!pLanguage)
+		return pText;
+	
+	const char* pResult;
+	if(pLanguage->FindResolved(pText, &pResult))
+		return pResult ? pResult : pText;
 	
+	pResult = LocalizeWithDepth(pLanguage, pText, 0);
+	pLanguage->AddResolved(pText, pResult != pText ? pResult : NULL);
+	return pResult;
+}
+
+const char* CLocalization::LocalizeWithDepth_P(CLanguage* pLanguage, int Number, const char* pText, int Depth)
+{
 	if(!pLanguage)
 		return pText;
 	
@@ -464,14 +537,19 @@ const char* CLocalization::LocalizeWithDepth_P(const char* pLanguageCode, int Nu
 	if(pResult)
 		return pResult;
 	else if(pLanguage->GetParentFilename()[0] && Depth < 4)
-		return LocalizeWithDepth_P(pLanguage->GetParentFilename(), Number, pText, Depth+1);
+		return LocalizeWithDepth_P(GetLanguage(GetLanguageID(pLanguage->GetParentFilename())), Number, pText, Depth+1);
 	else
 		return pText;
 }
 
 const char* CLocalization::Localize_P(const char* pLanguageCode, int Number, const char* pText)
 {
-	return LocalizeWithDepth_P(pLanguageCode, Number, pText, 0);
+	return LocalizeWithDepth_P(GetLanguage(GetLanguageID(pLanguageCode)), Number, pText, 0);
+}
+
+const char* CLocalization::Localize_P(int LanguageID, int Number, const char* pText)
+{
+	return LocalizeWithDepth_P(GetLanguage(LanguageID), Number, pText, 0);
 }
 
 void CLocalization::AppendNumber(dynamic_string& Buffer, int& BufferIter, CLanguage* pLanguage, int Number)
@@ -557,18 +635,12 @@ void CLocalization::AppendDuration(dynamic_string& Buffer, int& BufferIter, CLan
 
 void CLocalization::Format_V(dynamic_string& Buffer, const char* pLanguageCode, const char* pText, va_list VarArgs)
 {
-	CLanguage* pLanguage = m_pMainLanguage;	
-	if(pLanguageCode)
-	{
-		for(int i=0; i<m_pLanguages.size(); i++)
-		{
-			if(str_comp(m_pLanguages[i]->GetFilename(), pLanguageCode) == 0)
-			{
-				pLanguage = m_pLanguages[i];
-				break;
-			}
-		}
-	}
+	Format_V(Buffer, GetLanguageID(pLanguageCode), pText, VarArgs);
+}
+
+void CLocalization::Format_V(dynamic_string& Buffer, int LanguageID, const char* pText, va_list VarArgs)
+{
+	CLanguage* pLanguage = GetLanguage(LanguageID);
 	if(!pLanguage)
 	{
 		Buffer.append(pText);
@@ -708,9 +780,14 @@ void CLocalization::Format(dynamic_string& Buffer, const char* pLanguageCode, co
 
 void CLocalization::Format_VL(dynamic_string& Buffer, const char* pLanguageCode, const char* pText, va_list VarArgs)
 {
-	const char* pLocalText = Localize(pLanguageCode, pText);
+	Format_VL(Buffer, GetLanguageID(pLanguageCode), pText, VarArgs);
+}
+
+void CLocalization::Format_VL(dynamic_string& Buffer, int LanguageID, const char* pText, va_list VarArgs)
+{
+	const char* pLocalText = Localize(LanguageID, pText);
 	
-	Format_V(Buffer, pLanguageCode, pLocalText, VarArgs);
+	Format_V(Buffer, LanguageID, pLocalText, VarArgs);
 }
 
 void CLocalization::Format_L(dynamic_string& Buffer, const char* pLanguageCode, const char* pText, ...)
@@ -725,9 +802,14 @@ void CLocalization::Format_L(dynamic_string& Buffer, const char* pLanguageCode,
 
 void CLocalization::Format_VLP(dynamic_string& Buffer, const char* pLanguageCode, int Number, const char* pText, va_list VarArgs)
 {
-	const char* pLocalText = Localize_P(pLanguageCode, Number, pText);
+	Format_VLP(Buffer, GetLanguageID(pLanguageCode), Number, pText, VarArgs);
+}
+
+void CLocalization::Format_VLP(dynamic_string& Buffer, int LanguageID, int Number, const char* pText, va_list VarArgs)
+{
+	const char* pLocalText = Localize_P(LanguageID, Number, pText);
 	
-	Format_V(Buffer, pLanguageCode, pLocalText, VarArgs);
+	Format_V(Buffer, LanguageID, pLocalText, VarArgs);
 }
 
 void CLocalization::Format_LP(dynamic_string& Buffer, const char* pLanguageCode, int Number, const char* pText, ...)
@@ -83,6 +83,22 @@ public:
 		int m_Direction;
 		
 		hashtable< CEntry, 128 > m_Translations;
+		
+		// final results of Localize(), parent languages included, by the address of the key
+		struct CResolved
+		{
+			const char* m_pText;
+			char* m_pTextCopy;
+			const char* m_pResult;
+		};
+		enum
+		{
+			RESOLVED_CACHE_SIZE = 2048,
+		};
+		CResolved* m_pResolved;
+		int m_NumResolved;
+		
+		static unsigned ResolvedSlot(const char* pText);
 	
 	public:
 		UPluralRules* m_pPluralRules;
@@ -104,6 +120,8 @@ public:
 		bool Load(CLocalization* pLocalization, class CStorage* pStorage);
 		const char* Localize(const char* pKey) const;
 		const char* Localize_P(int Number, const char* pText) const;
+		bool FindResolved(const char* pText, const char** ppResult) const;
+		void AddResolved(const char* pText, const char* pResult);
 	};
 	
 	enum
@@ -125,8 +143,11 @@ public:
 	fixed_string128 m_Cfg_MainLanguage;
 
 protected:
-	const char* LocalizeWithDepth(const char* pLanguageCode, const char* pText, int Depth);
-	const char* LocalizeWithDepth_P(const char* pLanguageCode, int Number, const char* pText, int Depth);
+	hashtable< int, 64 > m_LanguageIDs;
+	
+	CLanguage* GetLanguage(int LanguageID);
+	const char* LocalizeWithDepth(CLanguage* pLanguage, const char* pText, int Depth);
+	const char* LocalizeWithDepth_P(CLanguage* pLanguage, int Number, const char* pText, int Depth);
 	
 	void AppendNumber(dynamic_string& Buffer, int& BufferIter, CLanguage* pLanguage, int Number);
 	void AppendPercent(dynamic_string& Buffer, int& BufferIter, CLanguage* pLanguage, double Number);
@@ -149,19 +170,27 @@ public:
 	
 	inline bool GetWritingDirection() const { return (!m_pMainLanguage ? DIRECTION_LTR : m_pMainLanguage->GetWritingDirection()); }
 	
+	//interned language handle, -1 stands for the main language
+	int GetLanguageID(const char* pLanguageCode) const;
+	
 	//localize
 	const char* Localize(const char* pLanguageCode, const char* pText);
+	const char* Localize(int LanguageID, const char* pText);
 	//localize and find the appropriate plural form based on Number
 	const char* Localize_P(const char* pLanguageCode, int Number, const char* pText);
+	const char* Localize_P(int LanguageID, int Number, const char* pText);
 	
 	//format
 	void Format_V(dynamic_string& Buffer, const char* pLanguageCode, const char* pText, va_list VarArgs);
+	void Format_V(dynamic_string& Buffer, int LanguageID, const char* pText, va_list VarArgs);
 	void Format(dynamic_string& Buffer, const char* pLanguageCode, const char* pText, ...);
 	//localize, format
 	void Format_VL(dynamic_string& Buffer, const char* pLanguageCode, const char* pText, va_list VarArgs);
+	void Format_VL(dynamic_string& Buffer, int LanguageID, const char* pText, va_list VarArgs);
 	void Format_L(dynamic_string& Buffer, const char* pLanguageCode, const char* pText, ...);
 	//localize, find the appropriate plural form based on Number and format
 	void Format_VLP(dynamic_string& Buffer, const char* pLanguageCode, int Number, const char* pText, va_list VarArgs);
+	void Format_VLP(dynamic_string& Buffer, int LanguageID, int Number, const char* pText, va_list VarArgs);
 	void Format_LP(dynamic_string& Buffer, const char* pLanguageCode, int Number, const char* pText, ...);
 	
 	void ArabicShaping(dynamic_string& Buffer, int BufferStart = 0);
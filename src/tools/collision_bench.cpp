@@ -0,0 +1,233 @@
+#include <base/math.h>
+#include <base/system.h>
+#include <base/vmath.h>
+
+#include <engine/map.h>
+#include <engine/storage.h>
+
+#include <game/collision.h>
+#include <game/layers.h>
+
+#include <cmath>
+
+// Times CCollision::AreConnected against the grid sweep it replaced, on
+// random queries over real maps. Usage:
+//   collision_bench [queries per radius] [map files...]
+// Without map files, every map of the "maps" directory is used.
+
+static IStorage *s_pStorage = 0;
+static IEngineMap *s_pEngineMap = 0;
+static int s_NumQueries = 20000;
+static int s_NumMaps = 0;
+static int s_NumDiffs = 0;
+
+// the slug slime radius and two larger ones to see how the cost grows
+static const float s_aRadii[] = {84.0f, 200.0f, 400.0f};
+enum { NUM_RADII = sizeof(s_aRadii)/sizeof(s_aRadii[0]) };
+static int64 s_aOldTime[NUM_RADII];
+static int64 s_aNewTime[NUM_RADII];
+
+static unsigned s_Seed = 1;
+
+static unsigned RandomInt()
+{
+	// xorshift, the queries must not depend on the platform
+	s_Seed ^= s_Seed << 13;
+	s_Seed ^= s_Seed >> 17;
+	s_Seed ^= s_Seed << 5;
+	return s_Seed;
+}
+
+static float RandomFloat(float Min, float Max)
+{
+	return Min + (Max-Min) * (RandomInt()%1000001)/1000000.0f;
+}
+
+// the implementation before the flood fill
+static bool OldAreConnected(CCollision *pCollision, vec2 Pos1, vec2 Pos2, float Radius)
+{
+	if(distance(Pos1, Pos2) > Radius)
+		return false;
+
+	int TileRadius = std::ceil(Radius/32.0f);
+	int CenterX = TileRadius;
+	int CenterY = TileRadius;
+	int Width = 2*TileRadius+1;
+	int Height = 2*TileRadius+1;
+	char* pMap = new char[Width*Height];
+	for(int j=0; j<Height; j++)
+	{
+		for(int i=0; i<Width; i++)
+		{
+			if(pCollision->CheckPoint(Pos1.x + 32.0f*(i-CenterX), Pos1.y + 32.0f*(j-CenterY)))
+				pMap[j*Width+i] = 0x0; //This tile can be checked
+			else
+				pMap[j*Width+i] = 0x1;
+		}
+	}
+
+	pMap[CenterY*Width+CenterX] = 0x2; //This tile is checked
+
+	int Pos2X = clamp(CenterX + (int)round((Pos2.x - Pos1.x)/32.0f), 0, Width-1);
+	int Pos2Y = clamp(CenterY + (int)round((Pos2.y - Pos1.y)/32.0f), 0, Height-1);
+
+	bool Changes = true;
+	while(Changes)
+	{
+		Changes = false;
+		for(int j=0; j<Height; j++)
+		{
+			for(int i=0; i<Width; i++)
+			{
+				if(pMap[j*Width+i]&0x1 && !(pMap[j*Width+i]&0x2))
+				{
+					if(i>0 && (pMap[j*Width+(i-1)]&0x2))
+					{
+						pMap[j*Width+i] = 0x2;
+						Changes = true;
+					}
+					if(j>0 && (pMap[(j-1)*Width+i]&0x2))
+					{
+						pMap[j*Width+i] = 0x2;
+						Changes = true;
+					}
+					if(i<Width-1 && (pMap[j*Width+(i+1)]&0x2))
+					{
+						pMap[j*Width+i] = 0x2;
+						Changes = true;
+					}
+					if(j<Height-1 && (pMap[(j+1)*Width+i]&0x2))
+					{
+						pMap[j*Width+i] = 0x2;
+						Changes = true;
+					}
+				}
+			}
+		}
+
+		if(pMap[Pos2Y*Width+Pos2X]&0x2)
+		{
+			delete[] pMap;
+			return true;
+		}
+	}
+
+	delete[] pMap;
+	return false;
+}
+
+static void BenchMap(const char *pMapName)
+{
+	if(!s_pEngineMap->Load(s_pStorage, pMapName))
+	{
+		dbg_msg("collision_bench", "failed to load map '%s'", pMapName);
+		return;
+	}
+
+	CLayers Layers;
+	Layers.Init(s_pEngineMap);
+	CCollision Collision;
+	Collision.Init(&Layers);
+
+	float Width = Collision.GetWidth()*32.0f;
+	float Height = Collision.GetHeight()*32.0f;
+
+	vec2 *pPos1 = new vec2[s_NumQueries];
+	vec2 *pPos2 = new vec2[s_NumQueries];
+	bool *pResults = new bool[s_NumQueries];
+
+	for(int r = 0; r < NUM_RADII; r++)
+	{
+		float Radius = s_aRadii[r];
+
+		// queries start where a character can stand, like in the game
+		for(int i = 0; i < s_NumQueries; i++)
+		{
+			do
+				pPos1[i] = vec2(RandomFloat(0.0f, Width), RandomFloat(0.0f, Height));
+			while(Collision.CheckPoint(pPos1[i]));
+			pPos2[i] = pPos1[i] + vec2(RandomFloat(-Radius, Radius), RandomFloat(-Radius, Radius));
+		}
+
+		int64 Start = time_get();
+		for(int i = 0; i < s_NumQueries; i++)
+			pResults[i] = OldAreConnected(&Collision, pPos1[i], pPos2[i], Radius);
+		int64 OldTime = time_get() - Start;
+
+		int NumConnected = 0;
+		int NumDiffs = 0;
+		Start = time_get();
+		for(int i = 0; i < s_NumQueries; i++)
+		{
+			bool Connected = Collision.AreConnected(pPos1[i], pPos2[i], Radius);
+			if(Connected != pResults[i])
+				NumDiffs++;
+			if(Connected)
+				NumConnected++;
+		}
+		int64 NewTime = time_get() - Start;
+
+		s_aOldTime[r] += OldTime;
+		s_aNewTime[r] += NewTime;
+		s_NumDiffs += NumDiffs;
+
+		dbg_msg("collision_bench", "%s: radius %.0f, %d connected, %d differences, old %.3fus new %.3fus per query",
+			pMapName, Radius, NumConnected, NumDiffs,
+			OldTime*1000000.0/time_freq()/s_NumQueries, NewTime*1000000.0/time_freq()/s_NumQueries);
+	}
+
+	delete[] pPos1;
+	delete[] pPos2;
+	delete[] pResults;
+	s_pEngineMap->Unload();
+	s_NumMaps++;
+}
+
+static int MaplistCallback(const char *pName, int IsDir, int DirType, void *pUser)
+{
+	int l = str_length(pName);
+	if(l < 4 || IsDir || str_comp(pName+l-4, ".map") != 0)
+		return 0;
+
+	char aBuf[256];
+	str_format(aBuf, sizeof(aBuf), "maps/%s", pName);
+	BenchMap(aBuf);
+	return 0;
+}
+
+int main(int argc, const char **argv) // ignore_convention
+{
+	dbg_logger_stdout();
+
+	s_pStorage = CreateStorage("Teeworlds", IStorage::STORAGETYPE_BASIC, argc, argv); // ignore_convention
+	s_pEngineMap = CreateEngineMap();
+	if(!s_pStorage)
+		return -1;
+
+	if(argc > 1) // ignore_convention
+		s_NumQueries = max(str_toint(argv[1]), 1); // ignore_convention
+
+	if(argc > 2) // ignore_convention
+	{
+		for(int i = 2; i < argc; i++) // ignore_convention
+			BenchMap(argv[i]); // ignore_convention
+	}
+	else
+		s_pStorage->ListDirectory(IStorage::TYPE_ALL, "maps", MaplistCallback, 0);
+
+	if(!s_NumMaps)
+	{
+		dbg_msg("collision_bench", "no map loaded");
+		return -1;
+	}
+
+	for(int r = 0; r < NUM_RADII; r++)
+	{
+		int64 NumQueries = (int64)s_NumMaps*s_NumQueries;
+		dbg_msg("collision_bench", "radius %.0f over %d maps: old %.3fus new %.3fus per query",
+			s_aRadii[r], s_NumMaps,
+			s_aOldTime[r]*1000000.0/time_freq()/NumQueries, s_aNewTime[r]*1000000.0/time_freq()/NumQueries);
+	}
+	dbg_msg("collision_bench", "%d differences", s_NumDiffs);
+	return s_NumDiffs ? 1 : 0;
+}
@@ -0,0 +1,197 @@
+#include <base/math.h>
+#include <base/system.h>
+#include <base/vmath.h>
+
+#include <engine/map.h>
+#include <engine/storage.h>
+
+#include <game/collision.h>
+#include <game/layers.h>
+
+// Checks CCollision::IntersectLine against the pixel by pixel walk it
+// replaced, on random segments over real maps. Usage:
+//   collision_test [segments per map] [map files...]
+// Without map files, every map of the "maps" directory is tested.
+
+static IStorage *s_pStorage = 0;
+static IEngineMap *s_pEngineMap = 0;
+static int s_NumSegments = 20000;
+static int s_NumMaps = 0;
+static int s_NumFailedMaps = 0;
+
+static unsigned s_Seed = 1;
+
+static unsigned RandomInt()
+{
+	// xorshift, the results must not depend on the platform
+	s_Seed ^= s_Seed << 13;
+	s_Seed ^= s_Seed >> 17;
+	s_Seed ^= s_Seed << 5;
+	return s_Seed;
+}
+
+static float RandomFloat(float Min, float Max)
+{
+	return Min + (Max-Min) * (RandomInt()%1000001)/1000000.0f;
+}
+
+// the implementation before the tile skipping
+static int OldIntersectLine(CCollision *pCollision, vec2 Pos0, vec2 Pos1, vec2 *pOutCollision, vec2 *pOutBeforeCollision)
+{
+	float Distance = distance(Pos0, Pos1);
+	int End(Distance+1);
+	vec2 Last = Pos0;
+
+	for(int i = 0; i < End; i++)
+	{
+		float a = i/Distance;
+		vec2 Pos = mix(Pos0, Pos1, a);
+		if(pCollision->CheckPoint(Pos.x, Pos.y))
+		{
+			if(pOutCollision)
+				*pOutCollision = Pos;
+			if(pOutBeforeCollision)
+				*pOutBeforeCollision = Last;
+			return pCollision->GetCollisionAt(Pos.x, Pos.y);
+		}
+		Last = Pos;
+	}
+	if(pOutCollision)
+		*pOutCollision = Pos1;
+	if(pOutBeforeCollision)
+		*pOutBeforeCollision = Pos1;
+	return 0;
+}
+
+static float RandomCoord(float Size)
+{
+	// points slightly outside of the map test the clamping, points on tile
+	// borders test the skipping
+	float Coord = RandomFloat(-128.0f, Size+128.0f);
+	switch(RandomInt()%4)
+	{
+	case 0: return (int)(Coord/32.0f)*32.0f - 0.5f;
+	case 1: return (int)(Coord/32.0f)*32.0f + RandomFloat(-1.0f, 1.0f);
+	default: return Coord;
+	}
+}
+
+static vec2 RandomEnd(vec2 Start, float Width, float Height)
+{
+	switch(RandomInt()%4)
+	{
+	case 0: // anywhere on the map, long traces
+		return vec2(RandomCoord(Width), RandomCoord(Height));
+	case 1: // axis aligned
+		if(RandomInt()%2)
+			return vec2(Start.x + RandomFloat(-800.0f, 800.0f), Start.y);
+		return vec2(Start.x, Start.y + RandomFloat(-800.0f, 800.0f));
+	case 2: // very short, like a projectile step
+		return Start + vec2(RandomFloat(-4.0f, 4.0f), RandomFloat(-4.0f, 4.0f));
+	default: // laser and hook reach
+		return Start + vec2(RandomFloat(-800.0f, 800.0f), RandomFloat(-800.0f, 800.0f));
+	}
+}
+
+static bool TestMap(const char *pMapName)
+{
+	if(!s_pEngineMap->Load(s_pStorage, pMapName))
+	{
+		dbg_msg("collision_test", "failed to load map '%s'", pMapName);
+		s_NumFailedMaps++;
+		return false;
+	}
+
+	CLayers Layers;
+	Layers.Init(s_pEngineMap);
+	CCollision Collision;
+	Collision.Init(&Layers);
+
+	float Width = Collision.GetWidth()*32.0f;
+	float Height = Collision.GetHeight()*32.0f;
+	int NumHits = 0;
+	int NumDiffs = 0;
+	int64 OldTime = 0;
+	int64 NewTime = 0;
+
+	for(int i = 0; i < s_NumSegments; i++)
+	{
+		vec2 Pos0(RandomCoord(Width), RandomCoord(Height));
+		vec2 Pos1 = RandomEnd(Pos0, Width, Height);
+
+		vec2 OldCol, OldBefore, NewCol, NewBefore;
+		int64 Start = time_get();
+		int OldResult = OldIntersectLine(&Collision, Pos0, Pos1, &OldCol, &OldBefore);
+		int64 Mid = time_get();
+		int NewResult = Collision.IntersectLine(Pos0, Pos1, &NewCol, &NewBefore);
+		NewTime += time_get() - Mid;
+		OldTime += Mid - Start;
+
+		if(OldResult)
+			NumHits++;
+
+		// the positions must be bit identical, not only close
+		if(OldResult != NewResult || mem_comp(&OldCol, &NewCol, sizeof(vec2)) != 0 || mem_comp(&OldBefore, &NewBefore, sizeof(vec2)) != 0)
+		{
+			if(NumDiffs < 10)
+				dbg_msg("collision_test", "%s: (%.9g %.9g) -> (%.9g %.9g): old %d (%.9g %.9g) (%.9g %.9g), new %d (%.9g %.9g) (%.9g %.9g)",
+					pMapName, Pos0.x, Pos0.y, Pos1.x, Pos1.y,
+					OldResult, OldCol.x, OldCol.y, OldBefore.x, OldBefore.y,
+					NewResult, NewCol.x, NewCol.y, NewBefore.x, NewBefore.y);
+			NumDiffs++;
+		}
+	}
+
+	s_pEngineMap->Unload();
+
+	dbg_msg("collision_test", "%s: %d segments, %d hits, %d differences, old %.2fms new %.2fms",
+		pMapName, s_NumSegments, NumHits, NumDiffs,
+		OldTime*1000.0/time_freq(), NewTime*1000.0/time_freq());
+
+	s_NumMaps++;
+	if(NumDiffs)
+		s_NumFailedMaps++;
+	return NumDiffs == 0;
+}
+
+static int MaplistCallback(const char *pName, int IsDir, int DirType, void *pUser)
+{
+	int l = str_length(pName);
+	if(l < 4 || IsDir || str_comp(pName+l-4, ".map") != 0)
+		return 0;
+
+	char aBuf[256];
+	str_format(aBuf, sizeof(aBuf), "maps/%s", pName);
+	TestMap(aBuf);
+	return 0;
+}
+
+int main(int argc, const char **argv) // ignore_convention
+{
+	dbg_logger_stdout();
+
+	s_pStorage = CreateStorage("Teeworlds", IStorage::STORAGETYPE_BASIC, argc, argv); // ignore_convention
+	s_pEngineMap = CreateEngineMap();
+	if(!s_pStorage)
+		return -1;
+
+	if(argc > 1) // ignore_convention
+		s_NumSegments = max(str_toint(argv[1]), 1); // ignore_convention
+
+	if(argc > 2) // ignore_convention
+	{
+		for(int i = 2; i < argc; i++) // ignore_convention
+			TestMap(argv[i]); // ignore_convention
+	}
+	else
+		s_pStorage->ListDirectory(IStorage::TYPE_ALL, "maps", MaplistCallback, 0);
+
+	if(!s_NumMaps)
+	{
+		dbg_msg("collision_test", "no map tested");
+		return -1;
+	}
+
+	dbg_msg("collision_test", "%d maps, %d with differences", s_NumMaps, s_NumFailedMaps);
+	return s_NumFailedMaps ? 1 : 0;
+}
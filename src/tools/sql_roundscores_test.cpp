@@ -0,0 +1,205 @@
+#include <base/system.h>
+
+#ifdef CONF_SQL
+#include <engine/server/sql_roundscores.h>
+#include <engine/server/sql_server.h>
+
+// Writes rounds through CSqlRoundScores into a stand-in MySQL/MariaDB server
+// and checks the stored rows and the old/new score sums. Usage:
+//   sql_roundscores_test [host] [port] [user] [password] [database] [prefix]
+// The tables with the prefix are dropped before and after the test, never
+// point it at a live database.
+
+enum
+{
+	NUM_USERS=70, // more than MAX_CLIENTS, the queries have to be split
+	NUM_ROUNDS=SQL_SCORE_NUMROUND+8, // the old score has to drop rounds
+	MAX_HISTORY=NUM_ROUNDS,
+};
+
+static const char *s_pMapName = "infc_test'map\\\"";
+
+static int s_aUserIDs[NUM_USERS];
+static int s_aaHistory[NUM_USERS][MAX_HISTORY];
+static int s_aNumHistory[NUM_USERS];
+static int s_NumErrors = 0;
+
+static unsigned s_Seed = 1;
+
+static unsigned RandomInt()
+{
+	s_Seed ^= s_Seed << 13;
+	s_Seed ^= s_Seed >> 17;
+	s_Seed ^= s_Seed << 5;
+	return s_Seed;
+}
+
+// sum of the best SQL_SCORE_NUMROUND round scores, computed without the database
+static int BestScores(int User)
+{
+	int aScores[MAX_HISTORY];
+	int Num = s_aNumHistory[User];
+	mem_copy(aScores, s_aaHistory[User], sizeof(int)*Num);
+	for(int i = 1; i < Num; i++)
+	{
+		int Score = aScores[i];
+		int j = i;
+		for(; j > 0 && aScores[j-1] < Score; j--)
+			aScores[j] = aScores[j-1];
+		aScores[j] = Score;
+	}
+
+	int Sum = 0;
+	for(int i = 0; i < Num && i < SQL_SCORE_NUMROUND; i++)
+		Sum += aScores[i];
+	return Sum;
+}
+
+static void Check(bool Condition, const char *pWhat)
+{
+	if(Condition)
+		return;
+	if(s_NumErrors < 20)
+		dbg_msg("sql_roundscores_test", "failed: %s", pWhat);
+	s_NumErrors++;
+}
+
+static void DropTables(CSqlServer *pSqlServer)
+{
+	const char *apTables[] = {"infc_RoundScore", "infc_Rounds", "Users"};
+	for(unsigned i = 0; i < sizeof(apTables)/sizeof(apTables[0]); i++)
+	{
+		char aBuf[256];
+		str_format(aBuf, sizeof(aBuf), "DROP TABLE IF EXISTS %s_%s", pSqlServer->GetPrefix(), apTables[i]);
+		pSqlServer->executeSql(aBuf);
+	}
+}
+
+static void CreateUsers(CSqlServer *pSqlServer)
+{
+	for(int u = 0; u < NUM_USERS; u++)
+	{
+		char aBuf[512];
+		str_format(aBuf, sizeof(aBuf),
+			"INSERT INTO %s_Users (Username, Email, PasswordHash, Level, RegisterDate, RegisterIp) "
+			"VALUES ('test%d', '', '', '0', UTC_TIMESTAMP(), '127.0.0.1')"
+			, pSqlServer->GetPrefix(), u);
+		pSqlServer->executeSql(aBuf);
+
+		pSqlServer->executeSqlQuery("SELECT LAST_INSERT_ID() AS UserId");
+		pSqlServer->GetResults()->next();
+		s_aUserIDs[u] = (int)pSqlServer->GetResults()->getInt("UserId");
+	}
+}
+
+static void TestRound(CSqlServer *pSqlServer, int Round)
+{
+	char aBuf[512];
+	CSqlRoundScores RoundScores(s_pMapName, NUM_USERS, NUM_USERS, 3, 300);
+
+	int aRoundScores[NUM_USERS];
+	for(int u = 0; u < NUM_USERS; u++)
+	{
+		RoundScores.AddPlayer(s_aUserIDs[u]);
+
+		// a few players don't score, their rows are not written
+		aRoundScores[u] = RandomInt()%5 == 0 ? 0 : 1 + RandomInt()%1000;
+		RoundScores.AddScore(s_aUserIDs[u], SQL_SCORETYPE_ROUND_SCORE, aRoundScores[u]);
+		RoundScores.AddScore(s_aUserIDs[u], SQL_SCORETYPE_ENGINEER_SCORE, RandomInt()%3 ? 0 : 1 + RandomInt()%100);
+		RoundScores.AddScore(s_aUserIDs[u], SQL_SCORETYPE_SMOKER_SCORE, RandomInt()%3 ? 0 : 1 + RandomInt()%100);
+	}
+
+	int aOldScores[NUM_USERS];
+	for(int u = 0; u < NUM_USERS; u++)
+	{
+		aOldScores[u] = BestScores(u);
+		if(aRoundScores[u] > 0)
+			s_aaHistory[u][s_aNumHistory[u]++] = aRoundScores[u];
+	}
+
+	Check(RoundScores.Write(pSqlServer), "write");
+	Check(RoundScores.RoundID() >= 0, "round id");
+
+	for(int u = 0; u < NUM_USERS; u++)
+	{
+		const CSqlRoundScores::CPlayer *pPlayer = RoundScores.GetPlayer(u);
+		str_format(aBuf, sizeof(aBuf), "round %d user %d: old score %d, expected %d", Round, u, pPlayer->m_OldScore, aOldScores[u]);
+		Check(pPlayer->m_OldScore == aOldScores[u], aBuf);
+		str_format(aBuf, sizeof(aBuf), "round %d user %d: new score %d, expected %d", Round, u, pPlayer->m_NewScore, BestScores(u));
+		Check(pPlayer->m_NewScore == BestScores(u), aBuf);
+	}
+
+	// every positive score is one row of the round, under the unescaped map name
+	str_format(aBuf, sizeof(aBuf),
+		"SELECT COUNT(*) AS NumRows, MIN(MapName) AS MapName FROM %s_infc_RoundScore WHERE RoundId = '%d'"
+		, pSqlServer->GetPrefix(), RoundScores.RoundID());
+	pSqlServer->executeSqlQuery(aBuf);
+	pSqlServer->GetResults()->next();
+	int NumRows = (int)pSqlServer->GetResults()->getInt("NumRows");
+	str_format(aBuf, sizeof(aBuf), "round %d: %d rows, expected %d", Round, NumRows, RoundScores.NumScoreRows());
+	Check(NumRows == RoundScores.NumScoreRows(), aBuf);
+	Check(NumRows == 0 || str_comp(pSqlServer->GetResults()->getString("MapName").c_str(), s_pMapName) == 0, "map name escaping");
+}
+
+int main(int argc, const char **argv) // ignore_convention
+{
+	dbg_logger_stdout();
+
+	const char *pHost = argc > 1 ? argv[1] : "127.0.0.1"; // ignore_convention
+	int Port = argc > 2 ? str_toint(argv[2]) : 3306; // ignore_convention
+	const char *pUser = argc > 3 ? argv[3] : "root"; // ignore_convention
+	const char *pPass = argc > 4 ? argv[4] : ""; // ignore_convention
+	const char *pDatabase = argc > 5 ? argv[5] : "infclass_test"; // ignore_convention
+	const char *pPrefix = argc > 6 ? argv[6] : "infctest"; // ignore_convention
+
+	CSqlServer SqlServer(pDatabase, pPrefix, pUser, pPass, pHost, Port, false, true);
+	if(!SqlServer.Connect())
+	{
+		dbg_msg("sql_roundscores_test", "can't connect to %s:%d", pHost, Port);
+		return -1;
+	}
+
+	try
+	{
+		DropTables(&SqlServer);
+	}
+	catch(sql::SQLException &e)
+	{
+		dbg_msg("sql_roundscores_test", "can't drop the old tables (MySQL Error: %s)", e.what());
+		SqlServer.Disconnect();
+		return -1;
+	}
+	SqlServer.Disconnect();
+	SqlServer.CreateTables();
+
+	if(!SqlServer.Connect())
+		return -1;
+
+	try
+	{
+		CreateUsers(&SqlServer);
+		for(int r = 0; r < NUM_ROUNDS; r++)
+			TestRound(&SqlServer, r);
+		DropTables(&SqlServer);
+	}
+	catch(sql::SQLException &e)
+	{
+		dbg_msg("sql_roundscores_test", "MySQL Error: %s", e.what());
+		s_NumErrors++;
+	}
+	SqlServer.Disconnect();
+
+	dbg_msg("sql_roundscores_test", "%d rounds of %d players, %d errors", NUM_ROUNDS, NUM_USERS, s_NumErrors);
+	return s_NumErrors ? 1 : 0;
+}
+
+#else
+
+int main(int argc, const char **argv) // ignore_convention
+{
+	dbg_logger_stdout();
+	dbg_msg("sql_roundscores_test", "the sql code is only built with CONF_SQL, use the sql_debug or sql_release build");
+	return -1;
+}
+
+#endif
@@ -0,0 +1,400 @@
+#include <base/math.h>
+#include <base/system.h>
+#include <base/vmath.h>
+
+#include <engine/map.h>
+#include <engine/storage.h>
+#include <engine/shared/datafile.h>
+
+#include <game/animation.h>
+#include <game/collision.h>
+#include <game/gamecore.h>
+#include <game/layers.h>
+#include <game/mapitems.h>
+
+#include <math.h>
+
+// Checks CCollision::GetZoneValueAt against the walk over all zone layers
+// and quads it replaced, at random positions and times. Besides the maps, a
+// generated map with animated quads (rotating and translating, translating
+// from a late first point, without envelope) is tested. Usage:
+//   zone_test [samples per zone] [map files...]
+// Without map files, every map of the "maps" directory is tested.
+
+static IStorage *s_pStorage = 0;
+static IEngineMap *s_pEngineMap = 0;
+static int s_NumSamples = 20000;
+static int s_NumMaps = 0;
+static int s_NumFailedMaps = 0;
+
+static const char *s_apZoneNames[] = {"icDamage", "icTele", "icBonus"};
+enum { NUM_ZONES = sizeof(s_apZoneNames)/sizeof(s_apZoneNames[0]) };
+
+static const char *s_pGeneratedMap = "zone_test_tmp.map";
+
+static unsigned s_Seed = 1;
+
+static unsigned RandomInt()
+{
+	// xorshift, the results must not depend on the platform
+	s_Seed ^= s_Seed << 13;
+	s_Seed ^= s_Seed >> 17;
+	s_Seed ^= s_Seed << 5;
+	return s_Seed;
+}
+
+static float RandomFloat(float Min, float Max)
+{
+	return Min + (Max-Min) * (RandomInt()%1000001)/1000000.0f;
+}
+
+// the quad test before the zone cache
+static bool SameSide(const vec2& l0, const vec2& l1, const vec2& p0, const vec2& p1)
+{
+	vec2 l0l1 = l1-l0;
+	vec2 l0p0 = p0-l0;
+	vec2 l0p1 = p1-l0;
+
+	return sign(l0l1.x*l0p0.y - l0l1.y*l0p0.x) == sign(l0l1.x*l0p1.y - l0l1.y*l0p1.x);
+}
+
+static bool InsideTriangle(const vec2& t0, const vec2& t1, const vec2& t2, const vec2& p)
+{
+	vec2 e0 = t1 - t0;
+	vec2 e1 = t2 - t0;
+	vec2 e2 = p - t0;
+
+	float d00 = dot(e0, e0);
+	float d01 = dot(e0, e1);
+	float d11 = dot(e1, e1);
+	float d20 = dot(e2, e0);
+	float d21 = dot(e2, e1);
+	float denom = d00 * d11 - d01 * d01;
+
+	vec3 bary;
+	bary.x = (d11 * d20 - d01 * d21) / denom;
+	bary.y = (d00 * d21 - d01 * d20) / denom;
+	bary.z = 1.0f - bary.x - bary.y;
+
+	return (bary.x >= 0.0f && bary.y >= 0.0f && bary.x + bary.y < 1.0f);
+}
+
+static bool InsideQuad(const vec2& q0, const vec2& q1, const vec2& q2, const vec2& q3, const vec2& p)
+{
+	if(SameSide(q1, q2, p, q0))
+		return InsideTriangle(q0, q1, q2, p);
+	else
+		return InsideTriangle(q1, q2, q3, p);
+}
+
+static void Rotate(vec2 *pCenter, vec2 *pPoint, float Rotation)
+{
+	float x = pPoint->x - pCenter->x;
+	float y = pPoint->y - pCenter->y;
+	pPoint->x = (x * cosf(Rotation) - y * sinf(Rotation) + pCenter->x);
+	pPoint->y = (x * sinf(Rotation) + y * cosf(Rotation) + pCenter->y);
+}
+
+static void QuadCorners(CLayers *pLayers, float Time, const CQuad *pQuad, vec2 *pCorners)
+{
+	vec2 Position(0.0f, 0.0f);
+	float Angle = 0.0f;
+	if(pQuad->m_PosEnv >= 0)
+		GetAnimationTransform(Time, pQuad->m_PosEnv, pLayers, Position, Angle);
+
+	for(int p = 0; p < 4; p++)
+		pCorners[p] = Position + vec2(fx2f(pQuad->m_aPoints[p].x), fx2f(pQuad->m_aPoints[p].y));
+
+	if(Angle != 0)
+	{
+		vec2 Center(fx2f(pQuad->m_aPoints[4].x), fx2f(pQuad->m_aPoints[4].y));
+		for(int p = 0; p < 4; p++)
+			Rotate(&Center, &pCorners[p], Angle);
+	}
+}
+
+static int OldGetZoneValueAt(CLayers *pLayers, float Time, const char *pZoneName, float x, float y)
+{
+	if(!pLayers->ZoneGroup())
+		return 0;
+
+	int Index = 0;
+	char aLayerName[12];
+	for(int l = 0; l < pLayers->ZoneGroup()->m_NumLayers; l++)
+	{
+		CMapItemLayer *pLayer = pLayers->GetLayer(pLayers->ZoneGroup()->m_StartLayer+l);
+		if(pLayer->m_Type == LAYERTYPE_TILES)
+		{
+			CMapItemLayerTilemap *pTLayer = (CMapItemLayerTilemap *)pLayer;
+			IntsToStr(pTLayer->m_aName, sizeof(aLayerName)/sizeof(int), aLayerName);
+			if(str_comp(pZoneName, aLayerName) != 0)
+				continue;
+
+			CTile *pTiles = (CTile *) pLayers->Map()->GetData(pTLayer->m_Data);
+			int Nx = clamp(round_to_int(x)/32, 0, pTLayer->m_Width-1);
+			int Ny = clamp(round_to_int(y)/32, 0, pTLayer->m_Height-1);
+			int TileIndex = (pTiles[Ny*pTLayer->m_Width+Nx].m_Index > 128 ? 0 : pTiles[Ny*pTLayer->m_Width+Nx].m_Index);
+			if(TileIndex > 0)
+				Index = TileIndex;
+		}
+		else if(pLayer->m_Type == LAYERTYPE_QUADS)
+		{
+			CMapItemLayerQuads *pQLayer = (CMapItemLayerQuads *)pLayer;
+			IntsToStr(pQLayer->m_aName, sizeof(aLayerName)/sizeof(int), aLayerName);
+			if(str_comp(pZoneName, aLayerName) != 0)
+				continue;
+
+			const CQuad *pQuads = (const CQuad *) pLayers->Map()->GetDataSwapped(pQLayer->m_Data);
+			for(int q = 0; q < pQLayer->m_NumQuads; q++)
+			{
+				vec2 aCorners[4];
+				QuadCorners(pLayers, Time, &pQuads[q], aCorners);
+				if(InsideQuad(aCorners[0], aCorners[1], aCorners[2], aCorners[3], vec2(x, y)))
+					Index = pQuads[q].m_ColorEnvOffset;
+			}
+		}
+	}
+
+	return Index;
+}
+
+// half of the samples are taken around a random zone quad where it is at
+// that time, most zones are small compared to the map
+static vec2 RandomPos(CLayers *pLayers, float Time, float Width, float Height)
+{
+	if(RandomInt()%2 && pLayers->ZoneGroup())
+	{
+		int l = RandomInt()%pLayers->ZoneGroup()->m_NumLayers;
+		CMapItemLayer *pLayer = pLayers->GetLayer(pLayers->ZoneGroup()->m_StartLayer+l);
+		if(pLayer->m_Type == LAYERTYPE_QUADS && ((CMapItemLayerQuads *)pLayer)->m_NumQuads > 0)
+		{
+			CMapItemLayerQuads *pQLayer = (CMapItemLayerQuads *)pLayer;
+			const CQuad *pQuads = (const CQuad *) pLayers->Map()->GetDataSwapped(pQLayer->m_Data);
+			vec2 aCorners[4];
+			QuadCorners(pLayers, Time, &pQuads[RandomInt()%pQLayer->m_NumQuads], aCorners);
+			vec2 Min = aCorners[0];
+			vec2 Max = aCorners[0];
+			for(int p = 1; p < 4; p++)
+			{
+				Min = vec2(min(Min.x, aCorners[p].x), min(Min.y, aCorners[p].y));
+				Max = vec2(max(Max.x, aCorners[p].x), max(Max.y, aCorners[p].y));
+			}
+			return vec2(RandomFloat(Min.x-32.0f, Max.x+32.0f), RandomFloat(Min.y-32.0f, Max.y+32.0f));
+		}
+	}
+
+	return vec2(RandomFloat(-64.0f, Width+64.0f), RandomFloat(-64.0f, Height+64.0f));
+}
+
+static bool TestMap(const char *pMapName)
+{
+	if(!s_pEngineMap->Load(s_pStorage, pMapName))
+	{
+		dbg_msg("zone_test", "failed to load map '%s'", pMapName);
+		s_NumFailedMaps++;
+		return false;
+	}
+
+	CLayers Layers;
+	Layers.Init(s_pEngineMap);
+	CCollision Collision;
+	Collision.Init(&Layers);
+
+	float Width = Collision.GetWidth()*32.0f;
+	float Height = Collision.GetHeight()*32.0f;
+	int NumHits = 0;
+	int NumDiffs = 0;
+
+	for(int z = 0; z < NUM_ZONES; z++)
+	{
+		int Handle = Collision.GetZoneHandle(s_apZoneNames[z]);
+		for(int i = 0; i < s_NumSamples; i++)
+		{
+			// the game time goes through the envelopes many times
+			double Time = RandomFloat(0.0f, 120.0f);
+			vec2 Pos = RandomPos(&Layers, Time, Width, Height);
+
+			Collision.SetTime(Time);
+			int NewValue = Collision.GetZoneValueAt(Handle, Pos.x, Pos.y);
+			int OldValue = OldGetZoneValueAt(&Layers, Time, s_apZoneNames[z], Pos.x, Pos.y);
+
+			if(OldValue)
+				NumHits++;
+
+			if(OldValue != NewValue)
+			{
+				if(NumDiffs < 10)
+					dbg_msg("zone_test", "%s: %s at (%.9g %.9g) time %.9g: old %d, new %d",
+						pMapName, s_apZoneNames[z], Pos.x, Pos.y, Time, OldValue, NewValue);
+				NumDiffs++;
+			}
+		}
+	}
+
+	s_pEngineMap->Unload();
+
+	dbg_msg("zone_test", "%s: %d samples, %d in a zone, %d differences",
+		pMapName, s_NumSamples*NUM_ZONES, NumHits, NumDiffs);
+
+	s_NumMaps++;
+	if(NumDiffs)
+		s_NumFailedMaps++;
+	return NumDiffs == 0;
+}
+
+static void AddQuad(CQuad *pQuad, vec2 Center, float Size, int PosEnv, int Value)
+{
+	mem_zero(pQuad, sizeof(*pQuad));
+	vec2 aCorners[4] = {vec2(-1, -1), vec2(1, -1), vec2(-1, 1), vec2(1, 1)};
+	for(int p = 0; p < 4; p++)
+	{
+		pQuad->m_aPoints[p].x = f2fx(Center.x + aCorners[p].x*Size/2);
+		pQuad->m_aPoints[p].y = f2fx(Center.y + aCorners[p].y*Size/2);
+	}
+	pQuad->m_aPoints[4].x = f2fx(Center.x);
+	pQuad->m_aPoints[4].y = f2fx(Center.y);
+	pQuad->m_PosEnv = PosEnv;
+	pQuad->m_ColorEnv = -1;
+	pQuad->m_ColorEnvOffset = Value;
+}
+
+static void SetEnvPoint(CEnvPoint *pPoint, int Time, float x, float y, float Angle)
+{
+	mem_zero(pPoint, sizeof(*pPoint));
+	pPoint->m_Time = Time;
+	pPoint->m_Curvetype = CURVETYPE_LINEAR;
+	pPoint->m_aValues[0] = f2fx(x);
+	pPoint->m_aValues[1] = f2fx(y);
+	pPoint->m_aValues[2] = f2fx(Angle); // degrees
+}
+
+// a 50x50 tiles map with one "icDamage" quad layer in the zone group
+static bool WriteGeneratedMap()
+{
+	enum { SIZE=50 };
+
+	CDataFileWriter Writer;
+	if(!Writer.Open(s_pStorage, s_pGeneratedMap))
+		return false;
+
+	CMapItemVersion Version;
+	Version.m_Version = 1;
+	Writer.AddItem(MAPITEMTYPE_VERSION, 0, sizeof(Version), &Version);
+
+	CTile *pTiles = new CTile[SIZE*SIZE];
+	mem_zero(pTiles, sizeof(CTile)*SIZE*SIZE);
+
+	CQuad aQuads[3];
+	AddQuad(&aQuads[0], vec2(800, 800), 64, 0, 1); // rotates and translates
+	AddQuad(&aQuads[1], vec2(400, 1200), 48, 1, 2); // translates, no offset before its first point
+	AddQuad(&aQuads[2], vec2(1200, 400), 80, 7, 3); // the envelope doesn't exist
+
+	CMapItemLayerTilemap GameLayer;
+	mem_zero(&GameLayer, sizeof(GameLayer));
+	GameLayer.m_Layer.m_Type = LAYERTYPE_TILES;
+	GameLayer.m_Version = 3;
+	GameLayer.m_Width = SIZE;
+	GameLayer.m_Height = SIZE;
+	GameLayer.m_Flags = TILESLAYERFLAG_PHYSICS;
+	GameLayer.m_ColorEnv = -1;
+	GameLayer.m_Image = -1;
+	GameLayer.m_Data = Writer.AddData(sizeof(CTile)*SIZE*SIZE, pTiles);
+	StrToInts(GameLayer.m_aName, sizeof(GameLayer.m_aName)/sizeof(int), "Game");
+	Writer.AddItem(MAPITEMTYPE_LAYER, 0, sizeof(GameLayer), &GameLayer);
+
+	CMapItemLayerQuads ZoneLayer;
+	mem_zero(&ZoneLayer, sizeof(ZoneLayer));
+	ZoneLayer.m_Layer.m_Type = LAYERTYPE_QUADS;
+	ZoneLayer.m_Version = 2;
+	ZoneLayer.m_NumQuads = 3;
+	ZoneLayer.m_Data = Writer.AddDataSwapped(sizeof(aQuads), aQuads);
+	ZoneLayer.m_Image = -1;
+	StrToInts(ZoneLayer.m_aName, sizeof(ZoneLayer.m_aName)/sizeof(int), "icDamage");
+	Writer.AddItem(MAPITEMTYPE_LAYER, 1, sizeof(ZoneLayer), &ZoneLayer);
+
+	const char *apGroupNames[] = {"Game", "#Zones"};
+	for(int g = 0; g < 2; g++)
+	{
+		CMapItemGroup Group;
+		mem_zero(&Group, sizeof(Group));
+		Group.m_Version = CMapItemGroup::CURRENT_VERSION;
+		Group.m_ParallaxX = 100;
+		Group.m_ParallaxY = 100;
+		Group.m_StartLayer = g;
+		Group.m_NumLayers = 1;
+		StrToInts(Group.m_aName, sizeof(Group.m_aName)/sizeof(int), apGroupNames[g]);
+		Writer.AddItem(MAPITEMTYPE_GROUP, g, sizeof(Group), &Group);
+	}
+
+	// the translation is rotated around the untranslated center as well
+	CEnvPoint aPoints[6];
+	SetEnvPoint(&aPoints[0], 0, 0, 0, 0);
+	SetEnvPoint(&aPoints[1], 1000, 320, -256, 90);
+	SetEnvPoint(&aPoints[2], 2000, -288, 192, 200);
+	SetEnvPoint(&aPoints[3], 3000, 0, 0, 360);
+	SetEnvPoint(&aPoints[4], 500, 224, 160, 0);
+	SetEnvPoint(&aPoints[5], 1500, 416, 96, 0);
+	Writer.AddItem(MAPITEMTYPE_ENVPOINTS, 0, sizeof(aPoints), aPoints);
+
+	for(int e = 0; e < 2; e++)
+	{
+		CMapItemEnvelope Envelope;
+		mem_zero(&Envelope, sizeof(Envelope));
+		Envelope.m_Version = CMapItemEnvelope::CURRENT_VERSION;
+		Envelope.m_Channels = 3;
+		Envelope.m_StartPoint = e == 0 ? 0 : 4;
+		Envelope.m_NumPoints = e == 0 ? 4 : 2;
+		Writer.AddItem(MAPITEMTYPE_ENVELOPE, e, sizeof(Envelope), &Envelope);
+	}
+
+	Writer.Finish();
+	delete[] pTiles;
+	return true;
+}
+
+static int MaplistCallback(const char *pName, int IsDir, int DirType, void *pUser)
+{
+	int l = str_length(pName);
+	if(l < 4 || IsDir || str_comp(pName+l-4, ".map") != 0)
+		return 0;
+
+	char aBuf[256];
+	str_format(aBuf, sizeof(aBuf), "maps/%s", pName);
+	TestMap(aBuf);
+	return 0;
+}
+
+int main(int argc, const char **argv) // ignore_convention
+{
+	dbg_logger_stdout();
+
+	s_pStorage = CreateStorage("Teeworlds", IStorage::STORAGETYPE_BASIC, argc, argv); // ignore_convention
+	s_pEngineMap = CreateEngineMap();
+	if(!s_pStorage)
+		return -1;
+
+	if(argc > 1) // ignore_convention
+		s_NumSamples = max(str_toint(argv[1]), 1); // ignore_convention
+
+	if(WriteGeneratedMap())
+	{
+		TestMap(s_pGeneratedMap);
+		s_pStorage->RemoveFile(s_pGeneratedMap, IStorage::TYPE_SAVE);
+	}
+	else
+	{
+		dbg_msg("zone_test", "failed to write '%s'", s_pGeneratedMap);
+		s_NumFailedMaps++;
+	}
+
+	if(argc > 2) // ignore_convention
+	{
+		for(int i = 2; i < argc; i++) // ignore_convention
+			TestMap(argv[i]); // ignore_convention
+	}
+	else
+		s_pStorage->ListDirectory(IStorage::TYPE_ALL, "maps", MaplistCallback, 0);
+
+	dbg_msg("zone_test", "%d maps, %d with differences", s_NumMaps, s_NumFailedMaps);
+	return s_NumFailedMaps ? 1 : 0;
+}